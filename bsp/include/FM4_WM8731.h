@@ -27,6 +27,7 @@
 #define WM8731_SAMPLING_RATE  ((uint8_t)0x08) /**< Registro frecuencia de muestreo */
 #define WM8731_CONTROL        ((uint8_t)0x09) /**< Registro control */
 #define WM8731_RESET          ((uint8_t)0x0F) /**< Registro reset */
+#define WM8731_NUM_REGS       10u             /**< Registros con copia en sombra (R0-R9) */
 
 /** @name Selección de entrada analógica */
 #define WM8731_MIC_IN         ((uint8_t)0x14) /**< Entrada de micrófono */
@@ -85,10 +86,131 @@ typedef union WM8731_data
  *           WM8731_LINE_IN_GAIN_9_DB, WM8731_LINE_IN_GAIN_12_DB,
  *           WM8731_LINE_IN_ATTEN_3_DB, WM8731_LINE_IN_ATTEN_6_DB, WM8731_LINE_IN_ATTEN_9_DB.
  *
- * @note Esta función inicia el bus I2C, el codec y el bus I2S.
+ * @note Esta función inicia el bus I2C, el codec y el bus I2S. Espera a que
+ *       terminen las escrituras al codec.
  */
 void FM4_WM8731_init(uint8_t fs, uint8_t select_input, uint8_t hp_out_gain, uint8_t line_in_gain);
 
+/**
+ * @brief Inicializa el codec WM8731 sin esperar a las escrituras I2C.
+ *
+ * Igual que FM4_WM8731_init(), pero devuelve el control en cuanto el reset y
+ * la configuración están encolados en el bus I2C (~1 ms a 400 kbit/s). El
+ * resto de la inicialización puede hacerse mientras tanto; el fin se
+ * comprueba con FM4_WM8731_busy() y el resultado con FM4_WM8731_sync().
+ *
+ * @param fs Frecuencia de muestreo (ver FM4_WM8731_init()).
+ * @param select_input Selección de entrada analógica.
+ * @param hp_out_gain Ganancia de salida de auriculares.
+ * @param line_in_gain Ganancia de entrada de línea.
+ *
+ * @note El registro CONTROL (activación) se escribe el último. El codec es
+ *       maestro del bus I2S, así que no hay muestras hasta que se activa.
+ */
+void FM4_WM8731_init_async(uint8_t fs, uint8_t select_input, uint8_t hp_out_gain, uint8_t line_in_gain);
+
+/**
+ * @brief Inicializa el codec WM8731 reutilizando su configuración (arranque
+ *        en caliente).
+ *
+ * El codec no se resetea con el MCU. Si la firma guardada en RAM no
+ * inicializada por el último FM4_WM8731_sync() correcto coincide con la
+ * configuración pedida, solo configura I2C (para cambios posteriores) e
+ * I2S, sin escribir en el codec. Si no, hace lo mismo que
+ * FM4_WM8731_init_async().
+ *
+ * @param fs Frecuencia de muestreo (ver FM4_WM8731_init()).
+ * @param select_input Selección de entrada analógica.
+ * @param hp_out_gain Ganancia de salida de auriculares.
+ * @param line_in_gain Ganancia de entrada de línea.
+ * @return 1 si se ha reutilizado la configuración, 0 si se ha programado
+ *         el codec (terminar con FM4_WM8731_sync()).
+ *
+ * @note Usar solo tras un reset que no afecte al codec (watchdog o reset
+ *       software, ver HAL_FM4_reset.h). Tras un encendido la firma es basura
+ *       y el CRC la descarta, pero no se debe depender de ello.
+ */
+uint8_t FM4_WM8731_init_warm(uint8_t fs, uint8_t select_input, uint8_t hp_out_gain, uint8_t line_in_gain);
+
+/**
+ * @brief Modifica un campo de un registro en la copia en sombra.
+ *
+ * Los registros del WM8731 solo se pueden escribir por I2C. El driver
+ * mantiene una copia en sombra (valores de 9 bits, inicializada con los
+ * valores de reset) y marca como pendiente el registro solo si el valor
+ * cambia. Los cambios se envían con FM4_WM8731_flush().
+ *
+ * @param reg   Registro (WM8731_LINE_IN_LEFT ... WM8731_CONTROL).
+ * @param mask  Bits del campo (9 bits).
+ * @param value Nuevo valor del campo (ya desplazado).
+ * @return 0 si tiene éxito, -1 si el registro no es válido.
+ */
+int8_t FM4_WM8731_set_field(uint8_t reg, uint16_t mask, uint16_t value);
+
+/**
+ * @brief Modifica un registro completo en la copia en sombra.
+ *
+ * @param reg   Registro (WM8731_LINE_IN_LEFT ... WM8731_CONTROL).
+ * @param value Nuevo valor (9 bits).
+ * @return 0 si tiene éxito, -1 si el registro no es válido.
+ */
+int8_t FM4_WM8731_set_reg(uint8_t reg, uint16_t value);
+
+/**
+ * @brief Devuelve el valor de un registro según la copia en sombra.
+ *
+ * @param reg Registro (WM8731_LINE_IN_LEFT ... WM8731_CONTROL).
+ * @return Valor de 9 bits (0 si el registro no es válido).
+ */
+uint16_t FM4_WM8731_get_reg(uint8_t reg);
+
+/**
+ * @brief Envía al codec los registros modificados.
+ *
+ * Encola en el bus I2C, en una sola ráfaga y en orden de registro, una
+ * transacción por cada registro pendiente. No espera a que terminen.
+ * Si una escritura falla el registro vuelve a quedar pendiente.
+ *
+ * @return Número de registros encolados.
+ */
+uint8_t FM4_WM8731_flush(void);
+
+/**
+ * @brief Indica si quedan escrituras al codec en curso.
+ * @return 1 si hay escrituras en curso, 0 en caso contrario.
+ */
+uint8_t FM4_WM8731_busy(void);
+
+/**
+ * @brief Envía los registros modificados y espera a que terminen.
+ * @return 0 si todas las escrituras se han completado, -1 si alguna ha fallado.
+ *
+ * @note Si todas se han completado, guarda la firma de arranque en caliente
+ *       (ver FM4_WM8731_init_warm()).
+ */
+int8_t FM4_WM8731_sync(void);
+
+/**
+ * @brief Cambia la ganancia de salida de auriculares (ambos canales).
+ * @param hp_out_gain WM8731_HP_OUT_GAIN_x_DB o WM8731_HP_OUT_ATTEN_x_DB.
+ * @note No bloqueante; sin efecto si la ganancia no cambia.
+ */
+void FM4_WM8731_set_hp_out_gain(uint8_t hp_out_gain);
+
+/**
+ * @brief Cambia la ganancia de entrada de línea (ambos canales).
+ * @param line_in_gain WM8731_LINE_IN_GAIN_x_DB o WM8731_LINE_IN_ATTEN_x_DB.
+ * @note No bloqueante; sin efecto si la ganancia no cambia.
+ */
+void FM4_WM8731_set_line_in_gain(uint8_t line_in_gain);
+
+/**
+ * @brief Selecciona la entrada analógica.
+ * @param select_input WM8731_LINE_IN, WM8731_MIC_IN o WM8731_MIC_IN_BOOST.
+ * @note No bloqueante; sin efecto si la entrada no cambia.
+ */
+void FM4_WM8731_select_input(uint8_t select_input);
+
 /**
  * @brief Escribe datos en el codec WM8731.
  *
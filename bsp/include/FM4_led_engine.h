@@ -0,0 +1,79 @@
+/**
+ * @file FM4_led_engine.h
+ * @brief Motor de LEDs por interrupción (placa FM4-pioneer)
+ *
+ * @details Controla el brillo de los leds RGB y Ethernet desde la ISR del
+ * Dual Timer, sin intervención del bucle principal.
+ *
+ * Modulación BAM (Binary Angle Modulation): cada trama se divide en 8
+ * ranuras de duración LED_ENGINE_UNIT_US * 2^k, k = 0..7. En la ranura k
+ * cada led está encendido si el bit k de su brillo (0-255) vale 1, por lo
+ * que el tiempo encendido es proporcional al brillo. Son 8 interrupciones
+ * por trama (LED_ENGINE_FRAME_US), frente a una escritura de GPIO por
+ * pasada del bucle de la PWM software de breath_led().
+ *
+ * El efecto de cada led se describe con un led_pattern_t (fijo, respiración
+ * o parpadeo) que el motor evalúa al comienzo de cada trama sobre la base
+ * de tiempos de SysTick, así que el brillo no depende de la carga del bucle.
+ *
+ * @author Universidad de Zaragoza
+ * @date 2026/03/17
+ */
+
+#ifndef FM4_LED_ENGINE_H_
+#define FM4_LED_ENGINE_H_
+
+#include <stdint.h>
+#include "FM4_leds_sw.h"
+
+/** Duración de la ranura más corta en microsegundos */
+#define LED_ENGINE_UNIT_US  8u
+
+/** Duración de una trama: 255 ranuras mínimas (~2 ms, ~490 Hz) */
+#define LED_ENGINE_FRAME_US (255u * LED_ENGINE_UNIT_US)
+
+/**
+ * @brief Tipos de efecto
+ */
+typedef enum {
+    LED_PAT_CONST,   /**< Brillo fijo */
+    LED_PAT_BREATH,  /**< Rampa triangular 0 -> level -> 0 en period_ms */
+    LED_PAT_BLINK,   /**< level durante on_ms de cada period_ms, apagado el resto */
+} led_mode_t;
+
+/**
+ * @brief Descriptor de efecto (normalmente const)
+ */
+typedef struct {
+    led_mode_t mode;     /**< Tipo de efecto */
+    uint8_t level;       /**< Brillo máximo (0-255) */
+    uint16_t period_ms;  /**< Periodo (BREATH, BLINK) */
+    uint16_t on_ms;      /**< Tiempo encendido (BLINK) */
+} led_pattern_t;
+
+/**
+ * @brief Arranca el motor con todos los leds apagados
+ *
+ * @pre LedsSwInit() y SysTick_InitIRQ()
+ */
+void led_engine_init(void);
+
+/**
+ * @brief Asigna un efecto a un led
+ *
+ * @param led     LED_AZUL, LED_VERDE, LED_ROJO o LED_ETH
+ * @param pattern Descriptor (debe permanecer válido); NULL -> apagado
+ *
+ * @note Se aplica al comienzo de la siguiente trama.
+ */
+void led_engine_set(const Leds_t led, const led_pattern_t *pattern);
+
+/**
+ * @brief Asigna un efecto al led RGB con un color
+ *
+ * @param color   Color (los leds que no forman parte del color se apagan)
+ * @param pattern Descriptor aplicado a los leds del color; NULL -> apagado
+ */
+void led_engine_rgb(const rgb_color_t color, const led_pattern_t *pattern);
+
+#endif /* FM4_LED_ENGINE_H_ */
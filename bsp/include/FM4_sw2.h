@@ -0,0 +1,92 @@
+/**
+ * @file FM4_sw2.h
+ * @brief Pulsador SW2 por interrupción externa (placa FM4-pioneer)
+ *
+ * @details SW2 (P20, activo a nivel bajo) se atiende con la interrupción
+ * externa INT05_0 en lugar de leerse en cada ciclo del bucle:
+ * - La ISR (EXINT5_IRQHandler) marca cada flanco con la base de tiempos del
+ *   Dual Timer, invierte la sensibilidad del flanco (el FM4 no detecta ambos
+ *   flancos a la vez) y rearma una alarma de SW2_DEBOUNCE_US.
+ * - Cuando la alarma vence sin más flancos el rebote ha terminado: el
+ *   manejador diferido lee el nivel estable y lo entrega al clasificador con
+ *   la marca de tiempo del primer flanco de la ráfaga.
+ * - El clasificador (sw2_classify) publica en una cola los eventos de
+ *   pulsación corta o larga con su duración.
+ *
+ * Sin pulsaciones no se ejecuta ningún código y la resolución temporal es la
+ * de la base de tiempos, no la del tick del bucle.
+ *
+ * @author Universidad de Zaragoza
+ * @date 2026/03/18
+ */
+
+#ifndef FM4_SW2_H_
+#define FM4_SW2_H_
+
+#include <stdint.h>
+
+/** Tiempo sin flancos para dar por terminado el rebote (us) */
+#define SW2_DEBOUNCE_US 20000u
+
+/** Duración mínima de una pulsación larga (ms) */
+#define SW2_LONG_MS     200u
+
+/** Capacidad de la cola de eventos (potencia de 2) */
+#define SW2_QUEUE_SIZE  8u
+
+/**
+ * @brief Tipos de evento
+ */
+typedef enum {
+    SW2_NONE = 0,    /**< Sin evento (mismos valores que pulsaciones()) */
+    SW2_SHORT = 1,   /**< Pulsación corta (< SW2_LONG_MS) */
+    SW2_LONG = 2,    /**< Pulsación larga (>= SW2_LONG_MS) */
+} sw2_event_type_t;
+
+/**
+ * @brief Evento de pulsación
+ */
+typedef struct {
+    sw2_event_type_t type;   /**< Corta o larga */
+    uint32_t press_us;       /**< Duración de la pulsación (us) */
+} sw2_event_t;
+
+/**
+ * @brief Estado del clasificador
+ */
+typedef struct {
+    uint32_t ticks_us;       /**< Ticks de la base de tiempos por us */
+    uint8_t pressed;         /**< Último nivel estable (1 pulsado) */
+    uint32_t t_press;        /**< Marca del flanco de pulsación (ticks) */
+} sw2_fsm_t;
+
+/**
+ * @brief Configura INT05_0 (P20) y arranca la captura
+ *
+ * @pre LedsSwInit() (P20 como entrada) y DTIM_Init()
+ */
+void Sw2IrqInit(void);
+
+/**
+ * @brief Extrae el evento más antiguo de la cola
+ *
+ * @param[out] ev Evento
+ * @return 1 si había evento, 0 si la cola está vacía
+ */
+uint8_t Sw2GetEvent(sw2_event_t * const ev);
+
+/**
+ * @brief Clasificador de pulsaciones (sin acceso al hardware)
+ *
+ * @param fsm     Estado (ticks_us fijado por el usuario, resto a 0)
+ * @param t       Marca del primer flanco de la ráfaga (ticks, mod 2^32)
+ * @param pressed Nivel estable tras el rebote (1 pulsado)
+ * @param ev      Evento generado (solo si devuelve distinto de SW2_NONE)
+ *
+ * @return Tipo de evento: SW2_NONE al pulsar o si el nivel no cambia,
+ *         SW2_SHORT o SW2_LONG al soltar
+ */
+sw2_event_type_t sw2_classify(sw2_fsm_t * const fsm, uint32_t t, uint8_t pressed,
+                              sw2_event_t * const ev);
+
+#endif /* FM4_SW2_H_ */
@@ -5,57 +5,134 @@
  *
  * Este módulo proporciona funciones para inicializar y controlar el códec
  * de audio WM8731 mediante I2C (configuración) e I2S (datos de audio).
+ *
+ * Firma de arranque en caliente: cuando FM4_WM8731_sync() termina sin
+ * errores, la copia en sombra coincide con el códec y se guarda, con un
+ * CRC-32, en RAM no inicializada (.bss.noinit). Cualquier escritura
+ * posterior al códec (flush o reset) la invalida hasta el siguiente sync. El códec no se resetea
+ * con el MCU, así que tras un reset por watchdog FM4_WM8731_init_warm()
+ * puede omitir la configuración por I2C si la firma coincide con la
+ * configuración pedida.
  */
 
 #include <stdint.h>
 #include "mcu.h"
 #include "FM4_WM8731.h"
+#include "HAL_FM4_crc.h"
 #include "HAL_FM4_i2c.h"
 #include "HAL_FM4_i2s.h"
 
+/** Marca de firma válida ("WM87") */
+#define WM8731_SIG_MAGIC  0x3738574Du
+
+/**
+ * @brief Valores de reset de los registros R0-R9 (9 bits).
+ */
+static const uint16_t wm8731_reset_value[WM8731_NUM_REGS] = {
+    0x097, 0x097, 0x079, 0x079, 0x00A, 0x008, 0x09F, 0x00A, 0x000, 0x000
+};
+
+static uint16_t wm8731_shadow[WM8731_NUM_REGS];          /**< Copia en sombra */
+static volatile uint16_t wm8731_dirty;                   /**< Registros pendientes (bit n -> Rn) */
+static volatile int8_t wm8731_error;                     /**< Fallo en alguna escritura */
+static i2c_xfer_t wm8731_xfer[WM8731_NUM_REGS];          /**< Una transacción por registro */
+static uint8_t wm8731_buf[WM8731_NUM_REGS][2];           /**< Datos de cada transacción */
+static i2c_xfer_t wm8731_reset_xfer;                     /**< Escritura del registro de reset */
+static const uint8_t wm8731_reset_buf[2] = { WM8731_RESET << 1, 0x00 };
+
 /**
- * @brief Retardo por software.
- * @param nCount Número de iteraciones del bucle de retardo.
+ * @brief Firma de la configuración del códec (sobrevive al reset del MCU)
  */
-static void DonaldDelay(volatile uint32_t nCount)
+static struct {
+    uint32_t magic;                          /**< WM8731_SIG_MAGIC si es válida */
+    uint16_t regs[WM8731_NUM_REGS];          /**< Registros R0-R9 escritos en el códec */
+    uint32_t crc;                            /**< CRC-32 de regs */
+} wm8731_sig __attribute__((section(".bss.noinit")));
+
+/**
+ * @brief Fin de la escritura de un registro (contexto de interrupción).
+ */
+static void Codec_WriteDone(i2c_xfer_t *x, void *arg)
 {
-    for (; nCount > 0; nCount--)
-        ;
+    if (x->status != I2C_OK)
+    {
+        if ((uint32_t)arg < WM8731_NUM_REGS)
+        {
+            wm8731_dirty |= (uint16_t)(1u << (uint32_t)arg);   // reintento en el siguiente flush
+        }
+        wm8731_error = -1;
+    }
 }
 
 /**
- * @brief Escribe un valor en un registro del códec WM8731.
- * @param RegisterAddr Dirección del registro (0-15).
- * @param RegisterValue Valor a escribir en el registro.
+ * @brief Reset del codec.
+ *
+ * La escritura del registro de reset se encola sin esperar; la cola de I2C
+ * es FIFO, así que precede a cualquier flush posterior.
  */
-static void Codec_WriteRegister(uint8_t RegisterAddr, uint8_t RegisterValue)
+static void Codec_Reset(void)
 {
-    I2C_write(WM8731_I2C_ADDRESS, ((RegisterAddr << 1) & 0xFF), ((RegisterValue)&0xFF));
+    wm8731_sig.magic = 0;                                    // el códec pierde la configuración
+    wm8731_reset_xfer.address = WM8731_I2C_ADDRESS;
+    wm8731_reset_xfer.tx = wm8731_reset_buf;
+    wm8731_reset_xfer.len = 2u;
+    wm8731_reset_xfer.callback = Codec_WriteDone;
+    wm8731_reset_xfer.arg = (void *)(uint32_t)WM8731_RESET;
+    I2C_submit(&wm8731_reset_xfer);                          // reset codec
 }
 
 /**
- * @brief Inicializa el códec WM8731 y el periférico I2S.
- * @param fs Frecuencia de muestreo (según registros del WM8731).
- * @param select_input Selección de entrada (LINE_IN o MIC).
- * @param hp_out_gain Ganancia de salida de auriculares.
- * @param line_in_gain Ganancia de entrada de línea.
+ * @brief Configuración inicial en la copia en sombra (sin I2C).
+ *
+ * Parte de los valores de reset y marca como pendientes los registros que
+ * cambian.
  */
-void FM4_WM8731_init(uint8_t fs, uint8_t select_input, uint8_t hp_out_gain, uint8_t line_in_gain)
+static void Codec_Configure(uint8_t fs, uint8_t select_input, uint8_t hp_out_gain, uint8_t line_in_gain)
 {
-    I2C_init();                                              // initialise I2C peripheral
-    DonaldDelay(1000);                                       // before writing to codec registers
-    Codec_WriteRegister(WM8731_RESET, 0x00);                 // reset codec
-    Codec_WriteRegister(WM8731_LINE_IN_LEFT, line_in_gain);  // set left line in gain
-    Codec_WriteRegister(WM8731_LINE_IN_RIGHT, line_in_gain); // set right line in gain
-    Codec_WriteRegister(WM8731_HP_OUT_LEFT, hp_out_gain);    // set left headphone out gain
-    Codec_WriteRegister(WM8731_HP_OUT_RIGHT, hp_out_gain);   // set right headphone out gain
-    Codec_WriteRegister(WM8731_ANALOG_PATH, select_input);   // select line in or microphone input
-    Codec_WriteRegister(WM8731_DIGITAL_PATH, 0x00);          // can select de-emphasis, HPF and mute here
-    Codec_WriteRegister(WM8731_POWER_DOWN, 0x00);            // disable power down on all parts of codec
-    Codec_WriteRegister(WM8731_INTERFACE, 0x53);             // select digital audio interface (I2S) format
-    Codec_WriteRegister(WM8731_SAMPLING_RATE, fs);           // sample rate control
-    Codec_WriteRegister(WM8731_CONTROL, 0x01);               // activate codec
+    for (uint8_t i = 0; i < WM8731_NUM_REGS; i++)
+    {
+        wm8731_shadow[i] = wm8731_reset_value[i];
+    }
+    wm8731_dirty = 0;
+    wm8731_error = 0;
+    FM4_WM8731_set_reg(WM8731_LINE_IN_LEFT, line_in_gain);   // set left line in gain
+    FM4_WM8731_set_reg(WM8731_LINE_IN_RIGHT, line_in_gain);  // set right line in gain
+    FM4_WM8731_set_reg(WM8731_HP_OUT_LEFT, hp_out_gain);     // set left headphone out gain
+    FM4_WM8731_set_reg(WM8731_HP_OUT_RIGHT, hp_out_gain);    // set right headphone out gain
+    FM4_WM8731_set_reg(WM8731_ANALOG_PATH, select_input);    // select line in or microphone input
+    FM4_WM8731_set_reg(WM8731_DIGITAL_PATH, 0x00);           // can select de-emphasis, HPF and mute here
+    FM4_WM8731_set_reg(WM8731_POWER_DOWN, 0x00);             // disable power down on all parts of codec
+    FM4_WM8731_set_reg(WM8731_INTERFACE, 0x53);              // select digital audio interface (I2S) format
+    FM4_WM8731_set_reg(WM8731_SAMPLING_RATE, fs);            // sample rate control
+    FM4_WM8731_set_reg(WM8731_CONTROL, 0x01);                // activate codec once configured
+}
 
+/**
+ * @brief Indica si la firma es válida y coincide con la copia en sombra.
+ */
+static uint8_t Codec_Retained(void)
+{
+    if ((wm8731_sig.magic != WM8731_SIG_MAGIC) ||
+        (wm8731_sig.crc != CRC32_Calc((const uint8_t *)wm8731_sig.regs, sizeof(wm8731_sig.regs))))
+    {
+        return 0;
+    }
+    for (uint8_t i = 0; i < WM8731_NUM_REGS; i++)
+    {
+        if (wm8731_sig.regs[i] != wm8731_shadow[i])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Configura I2S para la frecuencia de muestreo y habilita TX/RX.
+ * @param fs Frecuencia de muestreo (según registros del WM8731).
+ */
+static void I2S_Config(uint8_t fs)
+{
     I2S_init(fs);
     FM4_I2S0->OPRREG_f.RXENB = 1;
     FM4_I2S0->CNTREG_f.RXDIS = 0;
@@ -65,6 +142,173 @@ void FM4_WM8731_init(uint8_t fs, uint8_t select_input, uint8_t hp_out_gain, uint
     FM4_I2S0->INTCNT_f.TFTH = 0x0F & (0x00);
 }
 
+/**
+ * @brief Inicializa el códec WM8731 y el periférico I2S sin esperar al I2C.
+ * @param fs Frecuencia de muestreo (según registros del WM8731).
+ * @param select_input Selección de entrada (LINE_IN o MIC).
+ * @param hp_out_gain Ganancia de salida de auriculares.
+ * @param line_in_gain Ganancia de entrada de línea.
+ */
+void FM4_WM8731_init_async(uint8_t fs, uint8_t select_input, uint8_t hp_out_gain, uint8_t line_in_gain)
+{
+    I2C_init();                                              // initialise I2C peripheral
+    Codec_Configure(fs, select_input, hp_out_gain, line_in_gain);
+    Codec_Reset();                                           // reset codec (queued before the burst)
+    FM4_WM8731_flush();                                      // one burst in register order: CONTROL last
+
+    I2S_Config(fs);
+}
+
+/**
+ * @brief Inicializa el códec WM8731 reutilizando su configuración si se ha
+ *        conservado (arranque en caliente).
+ * @param fs Frecuencia de muestreo (según registros del WM8731).
+ * @param select_input Selección de entrada (LINE_IN o MIC).
+ * @param hp_out_gain Ganancia de salida de auriculares.
+ * @param line_in_gain Ganancia de entrada de línea.
+ * @return 1 si se ha omitido la configuración por I2C, 0 si se ha hecho
+ *         FM4_WM8731_init_async().
+ */
+uint8_t FM4_WM8731_init_warm(uint8_t fs, uint8_t select_input, uint8_t hp_out_gain, uint8_t line_in_gain)
+{
+    I2C_init();                                              // initialise I2C peripheral
+    Codec_Configure(fs, select_input, hp_out_gain, line_in_gain);
+    if (!Codec_Retained())
+    {
+        Codec_Reset();
+        FM4_WM8731_flush();
+        I2S_Config(fs);
+        return 0;
+    }
+    wm8731_dirty = 0;                                        // the codec already holds the shadow
+    I2S_Config(fs);
+    return 1;
+}
+
+/**
+ * @brief Inicializa el códec WM8731 y el periférico I2S.
+ * @param fs Frecuencia de muestreo (según registros del WM8731).
+ * @param select_input Selección de entrada (LINE_IN o MIC).
+ * @param hp_out_gain Ganancia de salida de auriculares.
+ * @param line_in_gain Ganancia de entrada de línea.
+ */
+void FM4_WM8731_init(uint8_t fs, uint8_t select_input, uint8_t hp_out_gain, uint8_t line_in_gain)
+{
+    FM4_WM8731_init_async(fs, select_input, hp_out_gain, line_in_gain);
+    FM4_WM8731_sync();                                       // wait for the burst to complete
+}
+
+int8_t FM4_WM8731_set_field(uint8_t reg, uint16_t mask, uint16_t value)
+{
+    if (reg >= WM8731_NUM_REGS)
+    {
+        return -1;
+    }
+
+    uint16_t v = (uint16_t)((wm8731_shadow[reg] & ~mask) | (value & mask)) & 0x1FFu;
+    if (v != wm8731_shadow[reg])
+    {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        wm8731_shadow[reg] = v;
+        wm8731_dirty |= (uint16_t)(1u << reg);
+        __set_PRIMASK(primask);
+    }
+    return 0;
+}
+
+int8_t FM4_WM8731_set_reg(uint8_t reg, uint16_t value)
+{
+    return FM4_WM8731_set_field(reg, 0x1FFu, value);
+}
+
+uint16_t FM4_WM8731_get_reg(uint8_t reg)
+{
+    return (reg < WM8731_NUM_REGS) ? wm8731_shadow[reg] : 0u;
+}
+
+uint8_t FM4_WM8731_flush(void)
+{
+    uint8_t n = 0;
+
+    for (uint8_t reg = 0; reg < WM8731_NUM_REGS; reg++)
+    {
+        if ((wm8731_dirty & (1u << reg)) && (wm8731_xfer[reg].status != I2C_PENDING))
+        {
+            uint32_t primask = __get_PRIMASK();
+            __disable_irq();
+            uint16_t v = wm8731_shadow[reg];
+            wm8731_dirty &= (uint16_t)~(1u << reg);
+            __set_PRIMASK(primask);
+            wm8731_sig.magic = 0;                            // codec changes: signature invalid until sync
+
+            wm8731_buf[reg][0] = (uint8_t)((reg << 1) | ((v >> 8) & 0x01));
+            wm8731_buf[reg][1] = (uint8_t)(v & 0xFF);
+            wm8731_xfer[reg].address = WM8731_I2C_ADDRESS;
+            wm8731_xfer[reg].tx = wm8731_buf[reg];
+            wm8731_xfer[reg].len = 2u;
+            wm8731_xfer[reg].callback = Codec_WriteDone;
+            wm8731_xfer[reg].arg = (void *)(uint32_t)reg;
+            I2C_submit(&wm8731_xfer[reg]);
+            n++;
+        }
+    }
+    return n;
+}
+
+uint8_t FM4_WM8731_busy(void)
+{
+    if (wm8731_reset_xfer.status == I2C_PENDING)
+    {
+        return 1;
+    }
+    for (uint8_t reg = 0; reg < WM8731_NUM_REGS; reg++)
+    {
+        if (wm8731_xfer[reg].status == I2C_PENDING)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int8_t FM4_WM8731_sync(void)
+{
+    wm8731_error = 0;
+    FM4_WM8731_flush();
+    while (FM4_WM8731_busy()) {}                             // wait for the burst to complete
+    if ((wm8731_error == 0) && (wm8731_dirty == 0u))
+    {
+        for (uint8_t i = 0; i < WM8731_NUM_REGS; i++)
+        {
+            wm8731_sig.regs[i] = wm8731_shadow[i];
+        }
+        wm8731_sig.crc = CRC32_Calc((const uint8_t *)wm8731_sig.regs, sizeof(wm8731_sig.regs));
+        wm8731_sig.magic = WM8731_SIG_MAGIC;                 // codec matches the shadow
+    }
+    return wm8731_error;
+}
+
+void FM4_WM8731_set_hp_out_gain(uint8_t hp_out_gain)
+{
+    FM4_WM8731_set_field(WM8731_HP_OUT_LEFT, 0x07F, hp_out_gain);
+    FM4_WM8731_set_field(WM8731_HP_OUT_RIGHT, 0x07F, hp_out_gain);
+    FM4_WM8731_flush();
+}
+
+void FM4_WM8731_set_line_in_gain(uint8_t line_in_gain)
+{
+    FM4_WM8731_set_field(WM8731_LINE_IN_LEFT, 0x01F, line_in_gain);
+    FM4_WM8731_set_field(WM8731_LINE_IN_RIGHT, 0x01F, line_in_gain);
+    FM4_WM8731_flush();
+}
+
+void FM4_WM8731_select_input(uint8_t select_input)
+{
+    FM4_WM8731_set_reg(WM8731_ANALOG_PATH, select_input);
+    FM4_WM8731_flush();
+}
+
 /**
  * @brief Escribe una muestra estéreo al códec WM8731 vía I2S.
  * @param datoL Muestra del canal izquierdo (16 bits con signo).
@@ -0,0 +1,132 @@
+/**
+ * @file FM4_led_engine.c
+ * @brief Motor de LEDs por interrupción (placa FM4-pioneer)
+ *
+ * Una alarma del Dual Timer recorre las 8 ranuras BAM de cada trama. En la
+ * primera ranura se evalúan los efectos y se calcula el brillo de cada led;
+ * en cada ranura se escribe un bit por led (escritura bit-band).
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+#include "FM4_led_engine.h"
+#include "FM4_leds_sw.h"
+#include "HAL_FM4_dtimer.h"
+#include "HAL_FM4_gpio.h"
+#include "HAL_SysTick.h"
+
+#define LED_ENGINE_N 4u
+
+/** Pines de los leds (índice del motor -> canal) */
+static const GpioChannel_t led_pin[LED_ENGINE_N] = { P18, PB2, P1A, P6E };
+
+static const led_pattern_t * volatile led_pattern[LED_ENGINE_N]; /**< Efecto de cada led */
+static uint8_t led_level[LED_ENGINE_N];                         /**< Brillo de la trama actual */
+static uint8_t led_slot;                                        /**< Ranura BAM actual (0-7) */
+static dtim_alarm_t led_alarm;
+
+/**
+ * @brief Índice del motor de un led
+ */
+static uint8_t led_index(const Leds_t led)
+{
+    switch (led)
+    {
+        case LED_AZUL:  return 0;
+        case LED_VERDE: return 1;
+        case LED_ROJO:  return 2;
+        default:        return 3;   // LED_ETH
+    }
+}
+
+/**
+ * @brief Brillo de un efecto en el instante t_ms
+ */
+static uint8_t led_eval(const led_pattern_t *p, uint32_t t_ms)
+{
+    uint32_t phase;
+    uint32_t half;
+
+    if (p == 0)
+    {
+        return 0;
+    }
+
+    switch (p->mode)
+    {
+        case LED_PAT_BREATH:
+            if (p->period_ms < 2u)
+            {
+                return p->level;
+            }
+            half = p->period_ms / 2u;
+            phase = t_ms % (2u * half);
+            if (phase >= half)
+            {
+                phase = 2u * half - phase;
+            }
+            return (uint8_t)((p->level * phase) / half);
+
+        case LED_PAT_BLINK:
+            if (p->period_ms == 0u)
+            {
+                return p->level;
+            }
+            return ((t_ms % p->period_ms) < p->on_ms) ? p->level : 0u;
+
+        default:
+            return p->level;
+    }
+}
+
+/**
+ * @brief Ranura BAM (ISR del Dual Timer)
+ */
+static void led_engine_slot(dtim_alarm_t *a, void *arg)
+{
+    (void)arg;
+    uint8_t slot = led_slot;
+
+    if (slot == 0u)
+    {
+        uint32_t t_ms = (uint32_t)SysTick_GetTick();
+        for (uint8_t i = 0; i < LED_ENGINE_N; i++)
+        {
+            led_level[i] = led_eval(led_pattern[i], t_ms);
+        }
+    }
+
+    for (uint8_t i = 0; i < LED_ENGINE_N; i++)
+    {
+        GPIO_FastWrite(led_pin[i], (led_level[i] & (1u << slot)) ? LED_ON : LED_OFF);
+    }
+
+    DTIM_AlarmRestart(a, LED_ENGINE_UNIT_US << slot);   // sin deriva
+    led_slot = (uint8_t)((slot + 1u) & 7u);
+}
+
+void led_engine_init(void)
+{
+    for (uint8_t i = 0; i < LED_ENGINE_N; i++)
+    {
+        led_pattern[i] = 0;
+        led_level[i] = 0;
+        GPIO_FastWrite(led_pin[i], LED_OFF);
+    }
+    led_slot = 0;
+
+    DTIM_Init();
+    DTIM_AlarmStart(&led_alarm, LED_ENGINE_UNIT_US, led_engine_slot, 0);
+}
+
+void led_engine_set(const Leds_t led, const led_pattern_t *pattern)
+{
+    led_pattern[led_index(led)] = pattern;
+}
+
+void led_engine_rgb(const rgb_color_t color, const led_pattern_t *pattern)
+{
+    led_pattern[0] = (color & BLUE)  ? pattern : 0;
+    led_pattern[1] = (color & GREEN) ? pattern : 0;
+    led_pattern[2] = (color & RED)   ? pattern : 0;
+}
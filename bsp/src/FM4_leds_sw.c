@@ -12,6 +12,12 @@
 #include "HAL_FM4_gpio.h"
 #include "FM4_leds_sw.h"
 
+/**
+ * Grupo de pines del led RGB: bit 0 P18 (azul), bit 1 PB2 (verde),
+ * bit 2 P1A (rojo). Mismo orden de bits que rgb_color_t.
+ */
+static const GpioChannel_t rgb_channels[3] = { P18, PB2, P1A };
+static GpioGroup_t rgb_group;
 
 /*------------------------------------------------- LedSwsInit -----
  *
@@ -58,6 +64,11 @@
     bFM4_GPIO_DDR2_P0 = 0;   // Entrada
     bFM4_GPIO_PDOR6_PE =  !bFM4_GPIO_PDIR2_P0 ;
 
+    // 3 pines en 2 puertos: siempre cabe; si no, LedRGB() no escribiría nada
+    int8_t group_ok = GPIO_GroupInit(&rgb_group, rgb_channels, 3);
+    assert(group_ok == 0);
+    (void)group_ok;
+
      // Leds apagados
     GPIO_ChannelWrite(P18,LED_OFF);  // Azul
     GPIO_ChannelWrite(PB2,LED_OFF);  // Verde
@@ -76,19 +87,13 @@
  *                     de los leds:
  *                           bit->     2     1    0
  *                           led->    ROJO VERDE AZUL
+ * note    Una escritura por puerto (P1: azul y rojo, PB: verde), así los
+ *         leds de un mismo puerto cambian a la vez
  */
 void LedRGB(const rgb_color_t leds3)
-{   GpioPinState_t led;
-
-    // Led Azul P18
-    led=(leds3&(1<<0))?LED_ON:LED_OFF;
-    GPIO_ChannelWrite(P18,led);  // Azul
-    // Led Verde PB2
-    led=(leds3&(1<<1))?LED_ON:LED_OFF;
-    GPIO_ChannelWrite(PB2,led);  // Verde
-    // Led Rojo P1A
-    led=(leds3&(1<<2))?LED_ON:LED_OFF;
-    GPIO_ChannelWrite(P1A,led);  // Rojo
+{
+    // Leds activos a nivel bajo (LED_ON = GPIO_LOW)
+    GPIO_GroupWrite(&rgb_group, (uint16_t)(~leds3 & 0x7));
 }
 
 /*------------------------------------------------- LedONOFF -----
@@ -107,16 +112,16 @@ void LedONOFF(const Leds_t led, const GpioPinState_t encendido)
 {
     switch (led){
     // Led Azul P18
-        case LED_AZUL : GPIO_ChannelWrite(P18,encendido);  // Azul;
+        case LED_AZUL : GPIO_FastWrite(P18,encendido);  // Azul;
         break;
     // Led Verde PB2
-        case LED_VERDE : GPIO_ChannelWrite(PB2,encendido);  // Verde;
+        case LED_VERDE : GPIO_FastWrite(PB2,encendido);  // Verde;
         break;
     // Led Rojo P1A
-        case LED_ROJO : GPIO_ChannelWrite(P1A,encendido);  // Rojo;
+        case LED_ROJO : GPIO_FastWrite(P1A,encendido);  // Rojo;
         break;
     // Led Ethernet P6E
-        case LED_ETH : GPIO_ChannelWrite(P6E,encendido);  // Eth;
+        case LED_ETH : GPIO_FastWrite(P6E,encendido);  // Eth;
         break;
         default: assert(0);
     }
@@ -133,16 +138,16 @@ void LedON(const Leds_t led)
 {
     switch (led){
     // Led Azul P18
-        case LED_AZUL : GPIO_ChannelWrite(P18, LED_ON);  // Azul;
+        case LED_AZUL : GPIO_FastWrite(P18, LED_ON);  // Azul;
         break;
     // Led Verde PB2
-        case LED_VERDE : GPIO_ChannelWrite(PB2, LED_ON);  // Verde;
+        case LED_VERDE : GPIO_FastWrite(PB2, LED_ON);  // Verde;
         break;
     // Led Rojo P1A
-        case LED_ROJO : GPIO_ChannelWrite(P1A, LED_ON);  // Rojo;
+        case LED_ROJO : GPIO_FastWrite(P1A, LED_ON);  // Rojo;
         break;
     // Led Ethernet P6E
-        case LED_ETH : GPIO_ChannelWrite(P6E, LED_ON);  // Eth;
+        case LED_ETH : GPIO_FastWrite(P6E, LED_ON);  // Eth;
         break;
         default: assert(0);
     }
@@ -159,16 +164,16 @@ void LedOFF(const Leds_t led)
 {
     switch (led){
     // Led Azul P18
-        case LED_AZUL : GPIO_ChannelWrite(P18, LED_OFF);  // Azul;
+        case LED_AZUL : GPIO_FastWrite(P18, LED_OFF);  // Azul;
         break;
     // Led Verde PB2
-        case LED_VERDE : GPIO_ChannelWrite(PB2, LED_OFF);  // Verde;
+        case LED_VERDE : GPIO_FastWrite(PB2, LED_OFF);  // Verde;
         break;
     // Led Rojo P1A
-        case LED_ROJO : GPIO_ChannelWrite(P1A, LED_OFF);  // Rojo;
+        case LED_ROJO : GPIO_FastWrite(P1A, LED_OFF);  // Rojo;
         break;
     // Led Ethernet P6E
-        case LED_ETH : GPIO_ChannelWrite(P6E, LED_OFF);  // Eth;
+        case LED_ETH : GPIO_FastWrite(P6E, LED_OFF);  // Eth;
         break;
         default: assert(0);
     }
@@ -179,16 +184,16 @@ void LedToggle(const Leds_t led)
 {
     switch (led){
     // Led Azul P18
-        case LED_AZUL : GPIO_ChannelToggle(P18);  // Azul;
+        case LED_AZUL : GPIO_FastToggle(P18);  // Azul;
         break;
     // Led Verde PB2
-        case LED_VERDE : GPIO_ChannelToggle(PB2);  // Verde;
+        case LED_VERDE : GPIO_FastToggle(PB2);  // Verde;
         break;
     // Led Rojo P1A
-        case LED_ROJO : GPIO_ChannelToggle(P1A);  // Rojo;
+        case LED_ROJO : GPIO_FastToggle(P1A);  // Rojo;
         break;
     // Led Ethernet P6E
-        case LED_ETH : GPIO_ChannelToggle(P6E);  // Eth;
+        case LED_ETH : GPIO_FastToggle(P6E);  // Eth;
         break;
         default: assert(0);
     }
@@ -0,0 +1,150 @@
+/**
+ * @file FM4_sw2.c
+ * @brief Pulsador SW2 por interrupción externa (placa FM4-pioneer)
+ *
+ * P20 -> INT05_0 (EXINT canal 5). ELVR admite un solo tipo de flanco por
+ * canal: se espera el de bajada (pulsar) o el de subida (soltar) según el
+ * último nivel estable.
+ *
+ * Selección del pin: EPFR06.EINT05S (bits 11:10, dos bits por canal) = 00
+ * -> INT05_0. Que INT05_0 sea P20 en el S6E2CC no está comprobado contra la
+ * hoja de datos (no hay copia en el repositorio); test/host/test_sw2.c
+ * comprueba los bits que escribe el driver y el tratamiento de los flancos,
+ * no la asignación del silicio. Si SW2 no genera interrupciones en la placa,
+ * revisar primero EINT05S.
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+#include "FM4_sw2.h"
+#include "FM4_leds_sw.h"
+#include "HAL_FM4_dtimer.h"
+
+#define SW2_EXINT_CH   5u                        // INT05_0
+#define SW2_ELVR_SHIFT (2u * SW2_EXINT_CH)       // LB5:LA5
+#define SW2_ELVR_RISE  2u                        // 10: flanco de subida
+#define SW2_ELVR_FALL  3u                        // 11: flanco de bajada
+
+static sw2_fsm_t sw2_fsm;
+static dtim_alarm_t sw2_alarm;                   // Fin del rebote
+static uint8_t sw2_in_burst;                     // Ráfaga de flancos en curso
+static uint32_t sw2_burst_t;                     // Marca del primer flanco de la ráfaga
+
+static sw2_event_t sw2_queue[SW2_QUEUE_SIZE];
+static volatile uint8_t sw2_head;                // Escribe la ISR
+static volatile uint8_t sw2_tail;                // Lee Sw2GetEvent()
+
+/**
+ * @brief Programa el flanco que se espera a partir del nivel actual
+ */
+static void sw2_arm_edge(uint8_t pressed)
+{
+    uint32_t sense = pressed ? SW2_ELVR_RISE : SW2_ELVR_FALL;
+    FM4_EXTI->ELVR = (FM4_EXTI->ELVR & ~(3u << SW2_ELVR_SHIFT)) | (sense << SW2_ELVR_SHIFT);
+    FM4_EXTI->EICL = ~(1u << SW2_EXINT_CH);      // borra la petición (escribir 0)
+}
+
+/**
+ * @brief Fin del rebote (ISR del Dual Timer, manejador diferido)
+ */
+static void sw2_settled(dtim_alarm_t *a, void *arg)
+{
+    (void)a;
+    (void)arg;
+    sw2_event_t ev;
+    uint8_t pressed = Sw2Read();
+
+    sw2_arm_edge(pressed);
+    sw2_in_burst = 0;
+
+    if (sw2_classify(&sw2_fsm, sw2_burst_t, pressed, &ev) != SW2_NONE)
+    {
+        uint8_t next = (uint8_t)((sw2_head + 1u) & (SW2_QUEUE_SIZE - 1u));
+        if (next != sw2_tail)                    // cola llena -> se descarta
+        {
+            sw2_queue[sw2_head] = ev;
+            sw2_head = next;
+        }
+    }
+
+    if (Sw2Read() != pressed)                    // flanco mientras se rearmaba
+    {
+        sw2_in_burst = 1;
+        sw2_burst_t = DTIM_GetTicks();
+        DTIM_AlarmStart(&sw2_alarm, SW2_DEBOUNCE_US, sw2_settled, 0);
+    }
+}
+
+/**
+ * @brief ISR de INT05: marca el flanco y pospone la decisión
+ */
+void EXINT5_IRQHandler(void)
+{
+    uint32_t t = DTIM_GetTicks();
+
+    FM4_EXTI->EICL = ~(1u << SW2_EXINT_CH);      // borra la petición
+    FM4_EXTI->ELVR ^= (1u << SW2_ELVR_SHIFT);    // siguiente flanco: el contrario
+
+    if (!sw2_in_burst)
+    {
+        sw2_in_burst = 1;
+        sw2_burst_t = t;
+    }
+    DTIM_AlarmStart(&sw2_alarm, SW2_DEBOUNCE_US, sw2_settled, 0);   // rearma
+}
+
+void Sw2IrqInit(void)
+{
+    uint8_t pressed = Sw2Read();
+
+    sw2_fsm.ticks_us = DTIM_TICKS_US;
+    sw2_fsm.pressed = pressed;
+    sw2_fsm.t_press = DTIM_GetTicks();
+    sw2_in_burst = 0;
+    sw2_head = 0;
+    sw2_tail = 0;
+
+    FM4_EXTI->ENIR &= ~(1u << SW2_EXINT_CH);
+    FM4_GPIO->EPFR06 &= ~(3u << SW2_ELVR_SHIFT); // EINT05S = 00 -> INT05_0 (P20)
+    sw2_arm_edge(pressed);
+    FM4_EXTI->ENIR |= (1u << SW2_EXINT_CH);
+
+    // Misma prioridad que el Dual Timer: ISR y manejador diferido no se
+    // interrumpen entre sí
+    NVIC_SetPriority(EXINT5_IRQn, (1u << __NVIC_PRIO_BITS) - 3u);
+    NVIC_ClearPendingIRQ(EXINT5_IRQn);
+    NVIC_EnableIRQ(EXINT5_IRQn);
+}
+
+uint8_t Sw2GetEvent(sw2_event_t * const ev)
+{
+    uint8_t tail = sw2_tail;
+
+    if (tail == sw2_head)
+    {
+        return 0;
+    }
+    *ev = sw2_queue[tail];
+    sw2_tail = (uint8_t)((tail + 1u) & (SW2_QUEUE_SIZE - 1u));
+    return 1;
+}
+
+sw2_event_type_t sw2_classify(sw2_fsm_t * const fsm, uint32_t t, uint8_t pressed,
+                              sw2_event_t * const ev)
+{
+    if (pressed == fsm->pressed)
+    {
+        return SW2_NONE;                         // rebote sin cambio neto
+    }
+
+    fsm->pressed = pressed;
+    if (pressed)
+    {
+        fsm->t_press = t;
+        return SW2_NONE;
+    }
+
+    ev->press_us = (t - fsm->t_press) / fsm->ticks_us;
+    ev->type = (ev->press_us >= SW2_LONG_MS * 1000u) ? SW2_LONG : SW2_SHORT;
+    return ev->type;
+}
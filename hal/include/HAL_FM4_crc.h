@@ -0,0 +1,64 @@
+/**
+ * @file HAL_FM4_crc.h
+ * @date :2026/01/12 10:15:02
+ * @brief Interfaz HAL para la unidad de cálculo CRC del FM4
+ *
+ * Este fichero declara las funciones para calcular CRC-16 y CRC-32 sobre
+ * buffers de bytes utilizando la unidad CRC hardware del microcontrolador
+ * S6E2CC. El periférico comparte la línea de interrupción con I2S
+ * (PRGCRC_I2S_IRQn), pero el cálculo es síncrono: cada escritura en CRCIN
+ * actualiza CRCR en el mismo acceso al bus, por lo que no se utiliza la
+ * interrupción y la ISR de audio no se ve afectada.
+ *
+ * @section Funciones disponibles
+ * - CRC16_Calc(data, len)
+ *   - CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, sin reflexión, sin XOR final).
+ * - CRC32_Calc(data, len)
+ *   - CRC-32 IEEE 802.3 (poly 0x04C11DB7 reflejado, init 0xFFFFFFFF, XOR final).
+ *
+ * @note Si se define HAL_CRC_SOFTWARE a 1, o se compila para una plataforma
+ *       que no es ARM (compilación en el host), se utiliza una implementación
+ *       software con resultados idénticos bit a bit.
+ *
+ * @warning La unidad CRC es un recurso único: no llamar a estas funciones
+ *          simultáneamente desde el bucle principal y desde una ISR.
+ */
+
+#ifndef _HAL_FM4_CRC_H_
+#define _HAL_FM4_CRC_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Selección de implementación
+ * @note 1 -> cálculo software, 0 -> unidad CRC hardware
+ */
+#ifndef HAL_CRC_SOFTWARE
+#if defined(__arm__)
+#define HAL_CRC_SOFTWARE 0
+#else
+#define HAL_CRC_SOFTWARE 1
+#endif
+#endif
+
+/**
+ * @brief Calcula CRC-16/CCITT-FALSE de un buffer
+ *
+ * @param [in] data Puntero al primer byte del buffer
+ * @param [in] len  Número de bytes
+ *
+ * @return CRC de 16 bits ("123456789" -> 0x29B1)
+ */
+uint16_t CRC16_Calc(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Calcula CRC-32 (IEEE 802.3) de un buffer
+ *
+ * @param [in] data Puntero al primer byte del buffer
+ * @param [in] len  Número de bytes
+ *
+ * @return CRC de 32 bits ("123456789" -> 0xCBF43926)
+ */
+uint32_t CRC32_Calc(const uint8_t *data, uint32_t len);
+
+#endif  /* _HAL_FM4_CRC_H_ */
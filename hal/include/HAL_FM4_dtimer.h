@@ -1,12 +1,23 @@
 /**
  * @file HAL_FM4_dtimer.h
- * @brief Interfaz para funciones de retardo utilizando el timer del FM4
+ * @brief Interfaz de retardos y alarmas utilizando el Dual Timer del FM4
  * @details Este archivo proporciona funciones para generar retardos precisos
- * utilizando los temporizadores del microcontrolador Cypress FM4
+ * y alarmas asíncronas utilizando los temporizadores del microcontrolador
+ * Cypress FM4:
+ * - DTIM1: base de tiempos libre de 32 bits (PCLK, sin interrupción).
+ *   delay_us() y delay_ms() esperan sobre ella sin reprogramar el timer, por
+ *   lo que se pueden anidar (p.ej. desde una ISR que interrumpe un retardo).
+ * - DTIM2: alarma de un disparo con interrupción (DT1_2_IRAHandler). Varias
+ *   alarmas pendientes se multiplexan sobre ella mediante una cola ordenada
+ *   por vencimiento; DTIM2 siempre se programa con la más próxima.
+ *
+ * Las alarmas ejecutan su callback en contexto de interrupción. Un driver
+ * que necesita esperar puede programar una alarma y devolver el control al
+ * bucle principal en lugar de bloquear la CPU.
  *
  * @author Universidad de Zaragoza
  * @date Created on: 2025/07/14
- * @date Last modified: 2025/07/14 10:48:29
+ * @date Last modified: 2026/03/09 12:20:33
  */
 
 #ifndef _HAL_FM4_DTIMER_H_
@@ -16,45 +27,121 @@
 #include "mcu.h"
 
 /**
- * @brief Timer utilizado para la función de retardo
- * @note Este valor define qué temporizador se utilizará para implementar los
- *        retardos. Valores posibles: 0->DTIM1, 1->DTIM2.
+ * @brief Timers utilizados por el driver
+ * @note Valores posibles: 0->DTIM1, 1->DTIM2.
+ */
+#define DTIM_TIMEBASE 0 // Base de tiempos libre
+#define DTIM_ALARM    1 // Alarma de un disparo
+
+/**
+ * @brief Ticks de la base de tiempos por microsegundo (PCLK = HCLK / 2)
+ */
+#define DTIM_TICKS_US (SystemCoreClock / 2000000u)
+
+/**
+ * @brief Máximo retardo de una alarma en microsegundos
+ * @note Medio periodo de la base de tiempos de 32 bits (~21 s a 100 MHz).
+ *       Para plazos mayores utilizar los temporizadores software (timer_wheel).
+ */
+#define DTIM_ALARM_MAX_US (0x7FFFFFFFu / DTIM_TICKS_US)
+
+struct dtim_alarm;
+
+/** Función de callback de una alarma (contexto de interrupción) */
+typedef void (*dtim_cb_t)(struct dtim_alarm *a, void *arg);
+
+/**
+ * @brief Alarma (la reserva el usuario; no modificar mientras está pendiente)
+ */
+typedef struct dtim_alarm {
+    struct dtim_alarm *next;   /**< Siguiente en la cola */
+    uint32_t deadline;         /**< Vencimiento en ticks de la base de tiempos */
+    dtim_cb_t callback;        /**< Función a ejecutar al vencer */
+    void *arg;                 /**< Argumento de la función */
+    uint8_t pending;           /**< 1 mientras está en la cola */
+} dtim_alarm_t;
+
+/**
+ * @brief Inicializa la base de tiempos (DTIM1) y la alarma (DTIM2)
+ *
+ * @note Sin efecto si la base de tiempos ya está en marcha, por lo que los
+ *       drivers que usan alarmas pueden llamarla en su inicialización.
+ *       delay_us() y delay_ms() la llaman si la base de tiempos no está en
+ *       marcha.
+ */
+void DTIM_Init(void);
+
+/**
+ * @brief Lee la base de tiempos
+ *
+ * @return Ticks (DTIM_TICKS_US por microsegundo), creciente, módulo 2^32
+ */
+uint32_t DTIM_GetTicks(void);
+
+/**
+ * @brief Programa una alarma
+ *
+ * @param[in] a        Alarma (si ya estaba pendiente se reprograma)
+ * @param[in] us       Tiempo hasta el vencimiento en microsegundos
+ * @param[in] callback Función a ejecutar al vencer
+ * @param[in] arg      Argumento de la función
+ *
+ * @return  0 Alarma programada
+ * @return -1 us mayor que DTIM_ALARM_MAX_US
+ *
+ * @note Puede llamarse desde ISR, incluida la propia callback de una alarma.
+ */
+int8_t DTIM_AlarmStart(dtim_alarm_t * const a, uint32_t us, dtim_cb_t callback, void *arg);
+
+/**
+ * @brief Programa una alarma relativa al vencimiento anterior (sin deriva)
+ *
+ * @param[in] a  Alarma ya vencida al menos una vez
+ * @param[in] us Tiempo desde el vencimiento anterior en microsegundos
+ *
+ * @return  0 Alarma programada
+ * @return -1 us mayor que DTIM_ALARM_MAX_US
+ */
+int8_t DTIM_AlarmRestart(dtim_alarm_t * const a, uint32_t us);
+
+/**
+ * @brief Cancela una alarma (sin efecto si no está pendiente)
+ *
+ * @param[in] a Alarma
  */
-#define DTIM_delay 0 // Define the timer to be used for delay
+void DTIM_AlarmCancel(dtim_alarm_t * const a);
 
 /**
  * @brief Genera un retardo en microsegundos
  *
- * @details Esta función bloquea la ejecución durante el número especificado
- * de microsegundos utilizando un timer de hardware para mayor precisión
+ * @details Espera activa sobre la base de tiempos DTIM1. No reprograma el
+ * timer, por lo que varios retardos pueden solaparse o anidarse.
  *
  * @param[in] us Tiempo de retardo en microsegundos
  *
- * @pre El sistema debe estar inicializado correctamente
  * @pre El reloj del sistema debe estar configurado
  *
  * @return void
  *
- * @note La precisión puede variar según la frecuencia del reloj del sistema
- * @warning Esta función es bloqueante y no debe usarse en contextos críticos de tiempo
+ * @warning Esta función es bloqueante; para esperas largas utilizar
+ *          DTIM_AlarmStart()
  */
 void delay_us (uint32_t us);
 
 /**
  * @brief Genera un retardo en milisegundos
  *
- * @details Esta función bloquea la ejecución durante el número especificado
- * de milisegundos utilizando un timer de hardware para mayor precisión
+ * @details Espera activa sobre la base de tiempos DTIM1, milisegundo a
+ * milisegundo (sin límite de duración).
  *
  * @param[in] ms Tiempo de retardo en milisegundos
  *
- * @pre El sistema debe estar inicializado correctamente
  * @pre El reloj del sistema debe estar configurado
  *
  * @return void
  *
- * @note La precisión puede variar según la frecuencia del reloj del sistema
- * @warning Esta función es bloqueante y no debe usarse en contextos críticos de tiempo
+ * @warning Esta función es bloqueante; para esperas largas utilizar
+ *          DTIM_AlarmStart()
  */
 void delay_ms (uint32_t ms);
 
@@ -9,6 +9,9 @@
  *      - GPIO_ChannelToggle
  *      - GPIO_ChannelMode
  *      - GPIO_ChannelDigAna
+ *      - GPIO_FastRead, GPIO_FastWrite, GPIO_FastToggle (inline, bit-band)
+ *      - GPIO_PortRead, GPIO_PortWriteMasked (varios pines de un puerto)
+ *      - GPIO_GroupInit, GPIO_GroupWrite, GPIO_GroupRead (grupos de pines)
  *
  * @author Universidad de Zaragoza
  * @date 2025/07/09
@@ -49,6 +52,9 @@
 #ifndef INCLUDES_HAL_FM4_GPIO_H_
 #define INCLUDES_HAL_FM4_GPIO_H_
 
+#include <stdint.h>
+#include "mcu.h"
+
 /**
  * @defgroup gpio_types Tipos de datos GPIO
  * @{
@@ -256,6 +262,30 @@ typedef enum GpioResistor_enu
   GPIO_MAX_RESISTOR     /**< Valor máximo para los estados de resistencia */
 } GpioResistor_t;
 
+/**
+ * @brief Máximo número de pines y de puertos distintos en un grupo
+ */
+#define GPIO_GROUP_MAX_PINS  16u
+#define GPIO_GROUP_MAX_PORTS 4u
+
+/**
+ * @brief Grupo de pines tratado como un único valor de hasta 16 bits
+ *
+ * @details El bit i del valor corresponde al canal i del grupo. Los pines
+ * pueden estar en puertos distintos; GPIO_GroupInit() precalcula el par
+ * (puerto, máscara) de cada puerto y el bit de cada pin, de modo que
+ * escribir el grupo cuesta un acceso a PDORx por puerto.
+ */
+typedef struct GpioGroup_str
+{
+  uint8_t n;                               /**< Número de pines */
+  uint8_t nports;                          /**< Número de puertos distintos */
+  uint8_t port[GPIO_GROUP_MAX_PORTS];      /**< Puertos */
+  uint16_t mask[GPIO_GROUP_MAX_PORTS];     /**< Máscara de cada puerto */
+  uint8_t pin_port[GPIO_GROUP_MAX_PINS];   /**< Índice en port[] de cada pin */
+  uint8_t pin_bit[GPIO_GROUP_MAX_PINS];    /**< Bit en el puerto de cada pin */
+} GpioGroup_t;
+
 /** @} */
 
 /**
@@ -318,6 +348,137 @@ void GPIO_ChannelWrite(const GpioChannel_t channel, const GpioPinState_t pin);
  */
 void GPIO_ChannelToggle(const GpioChannel_t channel);
 
+/**
+ * @brief Lee todos los pines de un puerto
+ *
+ * @param[in] port Número de puerto (0x0-0xF)
+ *
+ * @return uint16_t Contenido de PDIRx (bit n -> canal n)
+ */
+uint16_t GPIO_PortRead(const uint8_t port);
+
+/**
+ * @brief Escribe varios pines de un puerto a la vez
+ *
+ * @details Los bits de PDORx indicados en mask toman el valor de los bits
+ * correspondientes de value; el resto no cambia. La lectura-modificación-
+ * escritura se hace con las interrupciones deshabilitadas, de modo que una
+ * ISR que escribe otros pines del puerto no puede perder su cambio y todos
+ * los pines de mask cambian en el mismo ciclo de bus.
+ *
+ * @param[in] port Número de puerto (0x0-0xF)
+ * @param[in] mask Pines a escribir (bit n -> canal n)
+ * @param[in] value Valores de los pines
+ *
+ * @pre Los pines deben estar configurados como salida
+ *
+ * @return void
+ */
+void GPIO_PortWriteMasked(const uint8_t port, const uint16_t mask, const uint16_t value);
+
+/**
+ * @brief Precalcula un grupo de pines
+ *
+ * @param[out] group Grupo
+ * @param[in] channels Canales; channels[i] corresponde al bit i del valor
+ * @param[in] n Número de canales (máximo GPIO_GROUP_MAX_PINS)
+ *
+ * @return  0 Grupo listo
+ * @return -1 Demasiados pines o más de GPIO_GROUP_MAX_PORTS puertos
+ */
+int8_t GPIO_GroupInit(GpioGroup_t * const group, const GpioChannel_t * const channels, const uint8_t n);
+
+/**
+ * @brief Escribe un valor en un grupo de pines (un acceso por puerto)
+ *
+ * @param[in] group Grupo precalculado con GPIO_GroupInit()
+ * @param[in] value Bit i -> canal i del grupo
+ *
+ * @pre Los pines deben estar configurados como salida
+ *
+ * @return void
+ */
+void GPIO_GroupWrite(const GpioGroup_t * const group, const uint16_t value);
+
+/**
+ * @brief Lee un grupo de pines (un acceso por puerto)
+ *
+ * @param[in] group Grupo precalculado con GPIO_GroupInit()
+ *
+ * @return uint16_t Bit i -> estado del canal i del grupo
+ */
+uint16_t GPIO_GroupRead(const GpioGroup_t * const group);
+
+/** @} */
+
+/**
+ * @defgroup gpio_fast Acceso rápido por bit-band
+ *
+ * Cada bit de PDORx/PDIRx tiene una palabra alias en la región bit-band de
+ * periféricos del Cortex-M4. Escribir 0/1 en la palabra alias modifica solo
+ * ese bit en una única transferencia del bus, sin lectura-modificación-
+ * escritura en el código, por lo que una ISR que escribe otro pin del mismo
+ * puerto no puede perder su cambio.
+ *
+ * Con el canal constante el compilador resuelve la dirección alias en tiempo
+ * de compilación y cada llamada queda en un único STR (LDR en la lectura).
+ *
+ * @note El FM4 no tiene registros de set/clear de GPIO; el bit-band cumple
+ *       esa función.
+ * @{
+ */
+
+/** Palabra alias bit-band de un bit de un registro de periférico */
+#define GPIO_BITBAND(reg, bit) \
+  (*(volatile uint32_t *)(0x42000000u + (((uint32_t)(reg) - 0x40000000u) << 5) + ((uint32_t)(bit) << 2)))
+
+/** Alias del bit de salida (PDORx) de un canal */
+#define GPIO_PDOR_BB(channel) \
+  GPIO_BITBAND(&FM4_GPIO->PDOR0 + ((uint32_t)(channel) >> 4), (uint32_t)(channel) & 0xFu)
+
+/** Alias del bit de entrada (PDIRx) de un canal */
+#define GPIO_PDIR_BB(channel) \
+  GPIO_BITBAND(&FM4_GPIO->PDIR0 + ((uint32_t)(channel) >> 4), (uint32_t)(channel) & 0xFu)
+
+/**
+ * @brief Lee el estado de un pin GPIO (bit-band)
+ *
+ * @param[in] channel Canal GPIO a leer (preferiblemente constante)
+ *
+ * @return GpioPinState_t Estado lógico del canal
+ */
+static inline GpioPinState_t GPIO_FastRead(const GpioChannel_t channel)
+{
+  return (GpioPinState_t)GPIO_PDIR_BB(channel);
+}
+
+/**
+ * @brief Escribe un valor en un pin GPIO con un único acceso atómico
+ *
+ * @param[in] channel Canal GPIO a escribir (preferiblemente constante)
+ * @param[in] pin Valor lógico a escribir (GPIO_LOW o GPIO_HIGH)
+ *
+ * @pre El canal debe estar configurado como salida
+ */
+static inline void GPIO_FastWrite(const GpioChannel_t channel, const GpioPinState_t pin)
+{
+  GPIO_PDOR_BB(channel) = (uint32_t)pin;
+}
+
+/**
+ * @brief Invierte el estado de un pin GPIO (bit-band)
+ *
+ * @param[in] channel Canal GPIO a modificar (preferiblemente constante)
+ *
+ * @pre El canal debe estar configurado como salida
+ * @note Lee y escribe la palabra alias: atómico respecto a otros pines del
+ *       puerto, no respecto a una ISR que escriba el mismo pin.
+ */
+static inline void GPIO_FastToggle(const GpioChannel_t channel)
+{
+  GPIO_PDOR_BB(channel) ^= 1u;
+}
+
 /** @} */
 
 #endif /* INCLUDES_HAL_FM4_GPIO_H_*/
@@ -18,14 +18,21 @@
  *   - Arranca el HWWDT (empieza la cuenta atrás).
  * - HWWDT_GetIntStatus(void)
  *   - Devuelve el estado de la interrupción del HWWDT (1 = interrupción generada).
+ * - HWWDT_IsRunning(void)
+ *   - Indica si el HWWDT está en marcha con reset (SystemInit() lo para).
  * - HWWDT_ReadWdgValue(void)
  *   - Lee y devuelve el valor actual del contador del HWWDT.
  * - HWWDT_Feed(uint8_t u8ClearPattern1, uint8_t u8ClearPattern2)
  *   - Realiza la secuencia segura de "alimentado" (unlock -> feed -> lock).
+ * - HWWDT_GetMinRemaining(void) / HWWDT_ClearMinRemaining(void)
+ *   - Telemetría de holgura: mínimo del contador muestreado en cada feed.
+ *     Indica lo cerca del vencimiento que llega el bucle principal con carga.
  *
  * @note El HWWDT utiliza como reloj el dominio CLKLC (~100 kHz) representado
  *       por el símbolo __CLKLC en el sistema. Los parámetros de tiempo deben
- *       tener en cuenta esa frecuencia.
+ *       tener en cuenta esa frecuencia: HWWDT_MS_TO_TICKS() convierte un
+ *       periodo nominal y HWWDT_US_TO_LOAD() deriva el periodo de un
+ *       intervalo entre feeds medido, con margen y tolerancia de CLKLC.
  *
  */
 
@@ -33,6 +40,7 @@
 #define _HAL_FM4_HWWD_H_
 
 #include <stdint.h>
+#include "system_s6e2cc.h"
 
 
 /**
@@ -42,6 +50,44 @@
 #define HWWDT_REG_UNLOCK_key1  (0x1ACCE551u)
 #define HWWDT_REG_UNLOCK_key2  (0xE5331AAEu)
 
+/**
+* @brief Tolerancia del oscilador CR de baja velocidad (CLKLC), en %
+*
+* @note Con CLKLC un 50 % rápido el HWWDT vence antes de lo nominal; con
+*       CLKLC lento, hasta el doble de tarde (recuperación más lenta).
+*/
+#define HWWDT_CLKLC_TOL_PCT    (50u)
+
+/**
+* @brief Periodo en ms -> wdogload (ciclos nominales de CLKLC)
+*
+* @param ms Periodo, constante en tiempo de compilación
+*
+* @note Comprueba en compilación que el resultado cabe en WDG_LDR
+*       (1 .. UINT32_MAX): fuera de rango, el array de tamaño negativo da
+*       error de compilación.
+*/
+#define HWWDT_MS_TO_TICKS(ms) \
+    ((uint32_t)((((uint64_t)(ms) * __CLKLC) / 1000u) + \
+     0u * sizeof(char[((((uint64_t)(ms) * __CLKLC) / 1000u >= 1u) && \
+                       (((uint64_t)(ms) * __CLKLC) / 1000u <= 0xFFFFFFFFu)) ? 1 : -1])))
+
+/**
+* @brief wdogload mínimo que no vence antes de un intervalo entre feeds
+*
+* @details Escala el intervalo por el margen y por la tolerancia de CLKLC
+*          (peor caso: CLKLC rápido) y redondea hacia arriba:
+*          ticks = interval_us * (1 + margin) * (1 + tol) * __CLKLC / 1e6
+*
+* @param interval_us Peor intervalo entre feeds medido (us)
+* @param margin_pct  Margen sobre el intervalo (%)
+*
+* @note Válido también en tiempo de ejecución (sin comprobación de rango)
+*/
+#define HWWDT_US_TO_LOAD(interval_us, margin_pct) \
+    ((uint32_t)(((uint64_t)(interval_us) * (100u + (margin_pct)) * \
+                 (100u + HWWDT_CLKLC_TOL_PCT) * __CLKLC + 9999999999u) / 10000000000u))
+
 /**
 * @brief Inicializa Hardware Watchdog
 *
@@ -73,6 +119,16 @@ void HWWDT_Start(void);
 */
 uint8_t HWWDT_GetIntStatus(void);
 
+/**
+* @brief Indica si el HWWDT llegará a resetear el MCU
+*
+* @return   1 -> Contador en marcha con reset (WDG_CTL.INTEN y RESEN)
+*           0 -> Parado o sin reset: un bucle de espera no acaba nunca
+*
+* @note SystemInit() para el HWWDT; hasta HWWDT_Start() devuelve 0.
+*/
+uint8_t HWWDT_IsRunning(void);
+
 /**
 * @brief Lee el valor del contador del HWWDT
 *
@@ -95,6 +151,24 @@ uint32_t HWWDT_ReadWdgValue(void);
 */
 void HWWDT_Feed(uint8_t u8ClearPattern1, uint8_t u8ClearPattern2);
 
+/**
+* @brief Mínimo del contador del HWWDT observado al alimentarlo
+*
+* @details HWWDT_Feed() muestrea el contador antes de recargarlo y guarda el
+*          mínimo. wdogload - mínimo es el peor intervalo entre feeds en
+*          ciclos de CLKLC; un mínimo próximo a 0 indica que el sistema ha
+*          estado a punto de provocar la NMI.
+*
+* @retval uint32_t: mínimo del contador (wdogload tras HWWDT_Init(),
+*                   UINT32_MAX tras HWWDT_ClearMinRemaining() sin feeds)
+*/
+uint32_t HWWDT_GetMinRemaining(void);
+
+/**
+* @brief Reinicia la telemetría de holgura
+*/
+void HWWDT_ClearMinRemaining(void);
+
 
 
 
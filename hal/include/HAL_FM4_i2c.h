@@ -5,10 +5,16 @@
  * @details
  * Prototipos para:
  *  - Inicialización del periférico I2C en modo maestro.
- *  - Escritura de un byte en un registro de un dispositivo esclavo.
+ *  - Transacciones de escritura asíncronas con cola, callback de fin,
+ *    timeout y notificación de errores (I2C_submit()).
+ *  - Escritura bloqueante de un byte en un registro de un dispositivo
+ *    esclavo (I2C_write()), construida sobre la cola.
  *
  * Notas:
- *  - API bloqueante, sin gestión de NACK ni temporizadores (timeout).
+ *  - Máquina de estados en la ISR de estado de MFS2 (MFS2_TX_IRQHandler).
+ *  - Timeout de cada transacción mediante una alarma del Dual Timer
+ *    (HAL_FM4_dtimer).
+ *  - Solo escrituras: el códec WM8731 no admite lectura de registros.
  *  - Velocidad objetivo: 400 kbit/s (según configuración en la implementación).
  */
 
@@ -21,13 +27,65 @@
 extern "C" {
 #endif
 
+/** @name Estado de una transacción */
+#define I2C_OK            ( 0) /**< Completada */
+#define I2C_PENDING       ( 1) /**< En cola o en curso */
+#define I2C_ERR_NACK      (-1) /**< El esclavo no ha reconocido un byte */
+#define I2C_ERR_TIMEOUT   (-2) /**< No ha terminado en el tiempo previsto */
+#define I2C_ERR_BUS       (-3) /**< Error de bus o pérdida de arbitraje */
+
+/** Tiempo máximo de una transacción: fijo + por byte (us, 400 kbit/s) */
+#define I2C_TIMEOUT_BASE_US 200u
+#define I2C_TIMEOUT_BYTE_US 50u
+
+struct i2c_xfer;
+
+/** Función de fin de transacción (contexto de interrupción) */
+typedef void (*i2c_cb_t)(struct i2c_xfer *x, void *arg);
+
+/**
+ * @brief Transacción de escritura (la reserva el usuario)
+ *
+ *  [START] [ADDR | W] [tx[0]] ... [tx[len - 1]] [STOP]
+ *
+ * @note No modificar mientras status == I2C_PENDING.
+ */
+typedef struct i2c_xfer {
+    struct i2c_xfer *next;       /**< Siguiente en la cola */
+    uint8_t address;             /**< Dirección de 7 bits del esclavo */
+    const uint8_t *tx;           /**< Datos a escribir */
+    uint8_t len;                 /**< Número de bytes */
+    volatile int8_t status;      /**< I2C_PENDING, I2C_OK o error */
+    i2c_cb_t callback;           /**< Función de fin (NULL -> ninguna) */
+    void *arg;                   /**< Argumento de la función */
+} i2c_xfer_t;
+
 /**
  * @brief Inicializa el periférico I2C (MFS2) y configura los pines SDA/SCL.
  * @pre Debe llamarse una vez antes de cualquier transferencia I2C.
- * @post Bus I2C listo para operar en modo maestro.
+ * @post Bus I2C listo para operar en modo maestro, cola vacía.
  */
 void I2C_init(void);
 
+/**
+ * @brief Encola una transacción de escritura.
+ *
+ * Las transacciones se ejecutan en orden de llegada. Al terminar se
+ * actualiza x->status y se llama a x->callback.
+ *
+ * @param x Transacción con address, tx, len, callback y arg rellenos.
+ * @return 0 si se ha encolado, -1 si la transacción ya está pendiente.
+ *
+ * @note Puede llamarse desde ISR.
+ */
+int8_t I2C_submit(i2c_xfer_t * const x);
+
+/**
+ * @brief Indica si hay transacciones en cola o en curso.
+ * @return 1 ocupado, 0 libre.
+ */
+uint8_t I2C_busy(void);
+
 /**
  * @brief Escribe un byte en un registro de un dispositivo I2C.
  *
@@ -37,11 +95,13 @@ void I2C_init(void);
  * @param device_address Dirección de 7 bits del esclavo (sin el bit R/W).
  * @param register_address Dirección del registro interno del dispositivo.
  * @param cmd Byte de datos a escribir.
+ * @return I2C_OK o código de error (I2C_ERR_NACK, I2C_ERR_TIMEOUT, I2C_ERR_BUS).
  *
  * @pre Haber llamado previamente a I2C_init().
- * @note Función bloqueante sin comprobación de NACK ni timeout.
+ * @note Función bloqueante (espera el fin de la transacción encolada). No
+ *       llamar con interrupciones deshabilitadas ni desde ISR.
  */
-void I2C_write(uint8_t device_address, uint8_t register_address, uint8_t cmd);
+int8_t I2C_write(uint8_t device_address, uint8_t register_address, uint8_t cmd);
 
 #ifdef __cplusplus
 }
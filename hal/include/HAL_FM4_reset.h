@@ -0,0 +1,62 @@
+/**
+ * @file HAL_FM4_reset.h
+ * @date :2026/03/25 10:18:44
+ * @brief Interfaz HAL para la causa del último reset del MCU FM4
+ *
+ * El registro RST_STR del bloque de reloj y reset (CRG) indica qué fuentes
+ * han provocado el reset. La lectura lo borra, así que el driver lo lee una
+ * sola vez (en la primera llamada) y guarda el valor. Los bits se toman de
+ * los campos de la cabecera del dispositivo (FM4_CRG->RST_STR_f), no de
+ * posiciones escritas a mano.
+ *
+ * @section Funciones disponibles
+ * - RST_GetFlags(void)
+ *   - Devuelve el valor de RST_STR leído al arrancar (bits RST_FLAG_x).
+ * - RST_GetCause(void)
+ *   - Clasifica los bits en power-on, watchdog, software o externo.
+ *
+ * @note Un encendido activa también INITX: la clasificación da prioridad a
+ *       PONR, después a los watchdogs, al reset software y al pin externo.
+ */
+
+#ifndef _HAL_FM4_RESET_H_
+#define _HAL_FM4_RESET_H_
+
+#include <stdint.h>
+
+/** @name Bits de RST_GetFlags(), en las posiciones de RST_STR (bit 2 reservado) */
+#define RST_FLAG_PONR  (1u << 0)  /**< Power-on */
+#define RST_FLAG_INITX (1u << 1)  /**< Pin INITX (reset externo) */
+#define RST_FLAG_LVDH  (1u << 3)  /**< Detector de baja tensión */
+#define RST_FLAG_SWDR  (1u << 4)  /**< Software Watchdog */
+#define RST_FLAG_HWDR  (1u << 5)  /**< Hardware Watchdog */
+#define RST_FLAG_CSVR  (1u << 6)  /**< Supervisor de reloj */
+#define RST_FLAG_FCSR  (1u << 7)  /**< Detector de frecuencia anómala */
+#define RST_FLAG_SRST  (1u << 8)  /**< Reset software (SYSRESETREQ) */
+
+/**
+ * @brief Causa del último reset
+ */
+typedef enum {
+    RST_POWER_ON = 0,   /**< Encendido o baja tensión */
+    RST_WATCHDOG,       /**< Hardware o Software Watchdog */
+    RST_SOFTWARE,       /**< NVIC_SystemReset() */
+    RST_EXTERNAL,       /**< Pin INITX (pulsador de reset, depurador) */
+    RST_OTHER,          /**< Supervisores de reloj */
+} rst_cause_t;
+
+/**
+* @brief Devuelve el registro RST_STR leído al arrancar
+*
+* @retval uint16_t: bits RST_FLAG_x
+*/
+uint16_t RST_GetFlags(void);
+
+/**
+* @brief Devuelve la causa del último reset
+*
+* @retval rst_cause_t: categoría de la causa
+*/
+rst_cause_t RST_GetCause(void);
+
+#endif  /* _HAL_FM4_RESET_H_ */
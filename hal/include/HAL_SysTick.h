@@ -33,5 +33,61 @@ uint32_t SysTick_Init(uint32_t ticks);
  */
 uint32_t SysTick_ChkOvf(void);
 
+/**
+ * @brief   Configura System Tick en modo interrupción
+ * @details Como SysTick_Init(), pero además habilita la interrupción de SysTick
+ *          para mantener un contador de ticks de 64 bits (SysTick_IncTick()).
+ *          No se pierden ticks aunque el bucle principal tarde más de un
+ *          periodo, y varios consumidores pueden medir tiempos a la vez.
+ * @param [in]  ticks  Número de ciclos de reloj entre dos ticks.
+ * @return  0  Ejecución exitosa.
+ * @return  1  Fallo en la ejecución.
+ * @note    SysTick->CTRL se configura con:
+ *                  CLKSOURCE = 1 (HCLK)
+ *                  TICKINT = 1
+ *                  ENABLE = 1
+ * @note    SysTick_ChkOvf() no debe usarse en este modo.
+ */
+uint32_t SysTick_InitIRQ(uint32_t ticks);
+
+/**
+ * @brief   Incrementa el contador de ticks
+ * @note    Llamar desde SysTick_Handler.
+ */
+void SysTick_IncTick(void);
+
+/**
+ * @brief   Devuelve el número de ticks desde SysTick_InitIRQ()
+ * @return  Ticks (64 bits, sin desbordamiento en la práctica).
+ */
+uint64_t SysTick_GetTick(void);
+
+/**
+ * @brief   Devuelve el tiempo desde SysTick_InitIRQ() en ciclos de reloj
+ * @details Combina el contador de ticks con SysTick->VAL. Es coherente aunque
+ *          se llame con interrupciones deshabilitadas y el tick esté pendiente.
+ * @return  Ciclos de HCLK (64 bits).
+ */
+uint64_t SysTick_GetCycles(void);
+
+/**
+ * @brief   Devuelve el tiempo desde SysTick_InitIRQ() en microsegundos
+ * @return  Microsegundos (64 bits).
+ */
+uint64_t SysTick_GetUs(void);
+
+/**
+ * @brief   Comprueba si ha transcurrido un intervalo de ticks
+ * @details Cada consumidor guarda su propia referencia, de modo que varios
+ *          pueden usar la base de tiempos sin interferirse. Si ha vencido,
+ *          la referencia avanza un intervalo (sin deriva); si el llamante se
+ *          ha retrasado varios intervalos, sucesivas llamadas los recuperan.
+ * @param [in,out] last   Referencia del consumidor (inicializar con SysTick_GetTick()).
+ * @param [in]     ticks  Intervalo en ticks.
+ * @return  0  No ha vencido.
+ * @return  1  Ha vencido.
+ */
+uint32_t SysTick_Elapsed(uint64_t * const last, uint32_t ticks);
+
 
 #endif  /* _HAL_SYSTICK_H_ */
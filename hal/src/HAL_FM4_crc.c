@@ -0,0 +1,130 @@
+/**
+ * @file HAL_FM4_crc.c
+ * @brief Capa HAL para la unidad CRC del MCU FM4.
+ * @date :2026/01/12 10:15:02
+ *
+ * Funciones disponibles:
+ *  - CRC16_Calc(data, len): CRC-16/CCITT-FALSE de un buffer.
+ *  - CRC32_Calc(data, len): CRC-32 IEEE 802.3 de un buffer.
+ *
+ * Implementación hardware:
+ *  - Los bytes iniciales hasta alinear a 32 bits y los finales se escriben
+ *    de uno en uno; el resto se escribe por palabras con orden little-endian
+ *    (CRCCR.LTLEND = 1), de modo que el orden de proceso coincide con el
+ *    orden de los bytes en memoria.
+ *
+ * Implementación software (HAL_CRC_SOFTWARE = 1):
+ *  - Tablas de 16 entradas (procesado por nibbles), mismos resultados que
+ *    la unidad hardware.
+ */
+
+#include <stdint.h>
+#include "HAL_FM4_crc.h"
+
+#if (HAL_CRC_SOFTWARE == 0)
+
+#include "s6e2cc.h"
+
+/** @name Bits del registro CRCCR */
+#define CRCCR_INIT    (1u << 0)  /**< Carga CRCINIT en CRCR */
+#define CRCCR_CRC32   (1u << 1)  /**< 1: CRC32, 0: CCITT CRC16 */
+#define CRCCR_LTLEND  (1u << 2)  /**< Orden de bytes de entrada little-endian */
+#define CRCCR_LSBFST  (1u << 3)  /**< Orden de bits de entrada LSB primero */
+#define CRCCR_CRCLTE  (1u << 4)  /**< Orden de bytes del resultado little-endian */
+#define CRCCR_CRCLSF  (1u << 5)  /**< Orden de bits del resultado LSB primero */
+#define CRCCR_FXOR    (1u << 6)  /**< XOR final del resultado */
+
+/**
+ * @brief Procesa un buffer en la unidad CRC ya inicializada
+ *
+ * @param [in] data Puntero al primer byte del buffer
+ * @param [in] len  Número de bytes
+ */
+static void CRC_Feed(const uint8_t *data, uint32_t len)
+{
+    volatile uint8_t *in8 = (volatile uint8_t *)&FM4_CRC->CRCIN;
+
+    // Bytes iniciales hasta alinear a palabra
+    while ((len > 0u) && (((uint32_t)data & 3u) != 0u))
+    {
+        *in8 = *data++;
+        len--;
+    }
+
+    // Bloque alineado, una escritura por palabra
+    const uint32_t *data32 = (const uint32_t *)(const void *)data;
+    for (; len >= 4u; len -= 4u)
+    {
+        FM4_CRC->CRCIN = *data32++;
+    }
+
+    // Bytes finales
+    data = (const uint8_t *)data32;
+    while (len-- > 0u)
+    {
+        *in8 = *data++;
+    }
+}
+
+uint16_t CRC16_Calc(const uint8_t *data, uint32_t len)
+{
+    FM4_CRC->CRCINIT = 0xFFFFu;
+    FM4_CRC->CRCCR = CRCCR_LTLEND | CRCCR_INIT;
+    CRC_Feed(data, len);
+    return (uint16_t)FM4_CRC->CRCR;
+}
+
+uint32_t CRC32_Calc(const uint8_t *data, uint32_t len)
+{
+    FM4_CRC->CRCINIT = 0xFFFFFFFFu;
+    FM4_CRC->CRCCR = CRCCR_FXOR | CRCCR_CRCLSF | CRCCR_CRCLTE |
+                     CRCCR_LSBFST | CRCCR_LTLEND | CRCCR_CRC32 | CRCCR_INIT;
+    CRC_Feed(data, len);
+    return FM4_CRC->CRCR;
+}
+
+#else /* HAL_CRC_SOFTWARE */
+
+/**
+ * @brief Tabla CRC-16 CCITT (poly 0x1021) por nibbles, MSB primero
+ */
+static const uint16_t crc16_tbl[16] = {
+    0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+    0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu
+};
+
+/**
+ * @brief Tabla CRC-32 (poly 0xEDB88320 reflejado) por nibbles, LSB primero
+ */
+static const uint32_t crc32_tbl[16] = {
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+    0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+    0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
+uint16_t CRC16_Calc(const uint8_t *data, uint32_t len)
+{
+    uint16_t crc = 0xFFFFu;
+    while (len-- > 0u)
+    {
+        crc ^= (uint16_t)(*data++) << 8;
+        crc = (uint16_t)(crc << 4) ^ crc16_tbl[crc >> 12];
+        crc = (uint16_t)(crc << 4) ^ crc16_tbl[crc >> 12];
+    }
+    return crc;
+}
+
+uint32_t CRC32_Calc(const uint8_t *data, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    while (len-- > 0u)
+    {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ crc32_tbl[crc & 0xFu];
+        crc = (crc >> 4) ^ crc32_tbl[crc & 0xFu];
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+#endif /* HAL_CRC_SOFTWARE */
@@ -2,44 +2,216 @@
 #include "stdint.h"
 #include "HAL_FM4_dtimer.h"
 
-void delay_us (uint32_t us)
+// TIMERXCONTROL
+#define DTIM_CTRL_EN       (1u << 7)   // Habilitación
+#define DTIM_CTRL_PERIODIC (1u << 6)   // Modo periódico
+#define DTIM_CTRL_INTEN    (1u << 5)   // Habilitación de interrupción
+#define DTIM_CTRL_32BIT    (1u << 1)   // Contador de 32 bits
+#define DTIM_CTRL_ONESHOT  (1u << 0)   // Un disparo
+#define DTIM_CTRL_RESET    0x20u       // Valor de reset
+
+static dtim_alarm_t *alarm_queue = 0;  // Alarmas pendientes, por vencimiento
+
+/**
+ * @brief Programa DTIM2 con la primera alarma de la cola
+ * @note Llamar con interrupciones deshabilitadas
+ */
+static void alarm_program(void)
 {
-    // Number of ticks per microsecond
-    uint32_t ticks = (SystemCoreClock / 2000000) * us;
-    FM4_DTIM[DTIM_delay].TIMERXLOAD = ticks - 1;
-    FM4_DTIM[DTIM_delay].TIMERXBGLOAD = ticks - 1;
+    FM4_DTIM[DTIM_ALARM].TIMERXCONTROL = DTIM_CTRL_RESET;   // Detiene
+    FM4_DTIM[DTIM_ALARM].TIMERXINTCLR = 0xFE05;
 
-    // Habilitacion del timer, noInt, 32bits, one-shot,
-    FM4_DTIM[DTIM_delay].TIMERXCONTROL = (1<<7)|(1<<1)|(1<<0);
+    if (alarm_queue == 0)
+    {
+        return;
+    }
 
-    // Espera fin de la cuenta
-    while(FM4_DTIM[DTIM_delay].TIMERXRIS == 0)
+    int32_t remaining = (int32_t)(alarm_queue->deadline - DTIM_GetTicks());
+    if (remaining <= 1)
     {
-        // Empty loop
+        NVIC_SetPendingIRQ(DT1_2_IRQn);   // Ya vencida: se atiende en la ISR
+        return;
     }
 
-    // Limpia interrupciones y detiene el timer
-    FM4_DTIM[DTIM_delay].TIMERXINTCLR = 0xFE05;
-    FM4_DTIM[DTIM_delay].TIMERXCONTROL = 0x20; //Reset value
+    FM4_DTIM[DTIM_ALARM].TIMERXLOAD = (uint32_t)remaining - 1u;
+    // Habilitacion del timer, Int, 32bits, one-shot
+    FM4_DTIM[DTIM_ALARM].TIMERXCONTROL = DTIM_CTRL_EN | DTIM_CTRL_INTEN |
+                                         DTIM_CTRL_32BIT | DTIM_CTRL_ONESHOT;
 }
 
-void delay_ms (uint32_t ms)
+/**
+ * @brief Inserta una alarma en la cola ordenada
+ * @note Llamar con interrupciones deshabilitadas
+ */
+static void alarm_insert(dtim_alarm_t * const a)
+{
+    uint32_t now = DTIM_GetTicks();
+    dtim_alarm_t **p = &alarm_queue;
+
+    // Orden por tiempo restante (módulo 2^32)
+    while ((*p != 0) && ((int32_t)((*p)->deadline - now) <= (int32_t)(a->deadline - now)))
+    {
+        p = &(*p)->next;
+    }
+    a->next = *p;
+    *p = a;
+    a->pending = 1;
+
+    if (alarm_queue == a)
+    {
+        alarm_program();   // Nueva primera alarma
+    }
+}
+
+/**
+ * @brief Extrae una alarma de la cola
+ * @note Llamar con interrupciones deshabilitadas
+ */
+static void alarm_remove(dtim_alarm_t * const a)
+{
+    dtim_alarm_t **p = &alarm_queue;
+
+    while ((*p != 0) && (*p != a))
+    {
+        p = &(*p)->next;
+    }
+    if (*p == a)
+    {
+        *p = a->next;
+        a->next = 0;
+    }
+    a->pending = 0;
+}
+
+void DTIM_Init(void)
+{
+    if (FM4_DTIM[DTIM_TIMEBASE].TIMERXCONTROL & DTIM_CTRL_EN)
+    {
+        return;   // Ya inicializado (alarmas pendientes se conservan)
+    }
+
+    // DTIM1: base de tiempos libre, cuenta descendente desde 0xFFFFFFFF
+    FM4_DTIM[DTIM_TIMEBASE].TIMERXLOAD = 0xFFFFFFFFu;
+    FM4_DTIM[DTIM_TIMEBASE].TIMERXBGLOAD = 0xFFFFFFFFu;
+    FM4_DTIM[DTIM_TIMEBASE].TIMERXCONTROL = DTIM_CTRL_EN | DTIM_CTRL_32BIT;
+
+    // DTIM2: alarma, detenida hasta que haya alguna pendiente
+    FM4_DTIM[DTIM_ALARM].TIMERXCONTROL = DTIM_CTRL_RESET;
+    FM4_DTIM[DTIM_ALARM].TIMERXINTCLR = 0xFE05;
+    alarm_queue = 0;
+
+    // Por debajo de I2S, por encima de SysTick
+    NVIC_SetPriority(DT1_2_IRQn, (1u << __NVIC_PRIO_BITS) - 3u);
+    NVIC_ClearPendingIRQ(DT1_2_IRQn);
+    NVIC_EnableIRQ(DT1_2_IRQn);
+}
+
+uint32_t DTIM_GetTicks(void)
+{
+    return ~FM4_DTIM[DTIM_TIMEBASE].TIMERXVALUE;
+}
+
+int8_t DTIM_AlarmStart(dtim_alarm_t * const a, uint32_t us, dtim_cb_t callback, void *arg)
+{
+    if (us > DTIM_ALARM_MAX_US)
+    {
+        return -1;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (a->pending)
+    {
+        alarm_remove(a);
+    }
+    a->callback = callback;
+    a->arg = arg;
+    a->deadline = DTIM_GetTicks() + us * DTIM_TICKS_US;
+    alarm_insert(a);
+    __set_PRIMASK(primask);
+    return 0;
+}
+
+int8_t DTIM_AlarmRestart(dtim_alarm_t * const a, uint32_t us)
+{
+    if (us > DTIM_ALARM_MAX_US)
+    {
+        return -1;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (a->pending)
+    {
+        alarm_remove(a);
+    }
+    a->deadline += us * DTIM_TICKS_US;
+    alarm_insert(a);
+    __set_PRIMASK(primask);
+    return 0;
+}
+
+void DTIM_AlarmCancel(dtim_alarm_t * const a)
 {
-    // Number of ticks per microsecond
-    uint32_t ticks = (SystemCoreClock / 2000) * ms;
-    FM4_DTIM[DTIM_delay].TIMERXLOAD = ticks - 1;
-    FM4_DTIM[DTIM_delay].TIMERXBGLOAD = ticks - 1;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (a->pending)
+    {
+        uint8_t first = (alarm_queue == a);
+        alarm_remove(a);
+        if (first)
+        {
+            alarm_program();
+        }
+    }
+    __set_PRIMASK(primask);
+}
 
-    // Habilitacion del timer, noInt, 32bits, one-shot,
-    FM4_DTIM[DTIM_delay].TIMERXCONTROL = (1<<7)|(1<<1)|(1<<0);
+/**
+ * @brief ISR del Dual Timer: ejecuta las alarmas vencidas
+ *
+ * @note El vector es compartido por DTIM1 y DTIM2; la base de tiempos
+ *       (DTIM1) no genera interrupciones.
+ */
+void DT1_2_IRAHandler(void)
+{
+    FM4_DTIM[DTIM_ALARM].TIMERXINTCLR = 0xFE05;
 
-    // Espera fin de la cuenta
-    while(FM4_DTIM[DTIM_delay].TIMERXRIS == 0)
+    __disable_irq();
+    while ((alarm_queue != 0) &&
+           ((int32_t)(alarm_queue->deadline - DTIM_GetTicks()) <= 0))
+    {
+        dtim_alarm_t *a = alarm_queue;
+        alarm_queue = a->next;
+        a->next = 0;
+        a->pending = 0;
+
+        // La callback puede programar alarmas (incluida esta)
+        __enable_irq();
+        a->callback(a, a->arg);
+        __disable_irq();
+    }
+    alarm_program();
+    __enable_irq();
+}
+
+void delay_us (uint32_t us)
+{
+    DTIM_Init();   // Sin efecto si la base de tiempos ya está en marcha
+
+    // Espera sobre la base de tiempos (sin reprogramarla)
+    uint32_t start = DTIM_GetTicks();
+    uint32_t ticks = DTIM_TICKS_US * us;
+    while ((DTIM_GetTicks() - start) < ticks)
     {
         // Empty loop
     }
+}
 
-    // Limpia interrupciones y detiene el timer
-    FM4_DTIM[DTIM_delay].TIMERXINTCLR = 0xFE05;
-    FM4_DTIM[DTIM_delay].TIMERXCONTROL = 0x20; //Reset value
+void delay_ms (uint32_t ms)
+{
+    while (ms--)
+    {
+        delay_us(1000);
+    }
 }
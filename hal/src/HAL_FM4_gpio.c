@@ -6,6 +6,9 @@
  *      GPIO_ChannelToggle
  *      GPIO_ChannelMode
  *      GPIO_ChannelDigAna
+ *      GPIO_PortRead
+ *      GPIO_PortWriteMasked
+ *      GPIO_GroupInit / GPIO_GroupWrite / GPIO_GroupRead
  *  Last modified: 2020/09/24 11:07:08
  * @todo reescribir comentarios en doxygen
  */
@@ -194,3 +197,166 @@ void GPIO_ChannelToggle(const GpioChannel_t channel)
     *registro = *registro ^ (1u << bitport);
 
 }
+
+/*------------------------------------------------- GPIO_PortRead -----
+*  Funcion: GPIO_PortRead(port)
+*
+* Proposito:    Esta función lee todos los pines de un puerto
+*
+* Parametros: port     (IN)  Número de puerto (0x0-0xF)
+*
+* Return:                    Contenido de PDIRx
+*
+**********************************************************************/
+uint16_t GPIO_PortRead(const uint8_t port)
+{
+    assert(port < 16);
+
+    volatile uint32_t *registro;
+    registro = &FM4_GPIO->PDIR0 + port;
+    return (uint16_t)*registro;
+}
+
+/*------------------------------------------------- GPIO_PortWriteMasked -----
+*  Funcion: GPIO_PortWriteMasked(port, mask, value)
+*
+* Proposito:    Esta función escribe los pines de mask de un puerto con
+*               una única escritura de PDORx
+*
+* Pre-condición: Los pines deben estar configurados como salida
+*
+* Parametros: port     (IN)  Número de puerto (0x0-0xF)
+              mask     (IN)  Pines a escribir
+              value    (IN)  Valores de los pines
+*
+* Return:      void
+*
+**********************************************************************/
+void GPIO_PortWriteMasked(const uint8_t port, const uint16_t mask, const uint16_t value)
+{
+    assert(port < 16);
+
+    volatile uint32_t *registro;
+    registro = &FM4_GPIO->PDOR0 + port;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();                    // RMW atómica frente a ISR
+    *registro = (*registro & ~(uint32_t)mask) | (value & mask);
+    __set_PRIMASK(primask);
+}
+
+/*------------------------------------------------- GPIO_GroupInit -----
+*  Funcion: GPIO_GroupInit(group, channels, n)
+*
+* Proposito:    Esta función precalcula los pares (puerto, máscara) de un
+*               grupo de pines y el bit de cada pin
+*
+* Parametros: group    (OUT) Grupo
+              channels (IN)  Canales (channels[i] -> bit i)
+              n        (IN)  Número de canales
+*
+* Return:      0 si el grupo está listo, -1 si no cabe
+*
+**********************************************************************/
+int8_t GPIO_GroupInit(GpioGroup_t * const group, const GpioChannel_t * const channels, const uint8_t n)
+{
+    if (n > GPIO_GROUP_MAX_PINS)
+    {
+        return -1;
+    }
+
+    group->n = 0;
+    group->nports = 0;
+    for (uint8_t i = 0; i < n; i++)
+    {
+        assert(channels[i] < 256);
+
+        uint8_t port = channels[i] >> 4;
+        uint8_t bitport = channels[i] & 0xF;
+        uint8_t k;
+
+        for (k = 0; k < group->nports; k++)
+        {
+            if (group->port[k] == port)
+            {
+                break;
+            }
+        }
+        if (k == group->nports)
+        {
+            if (group->nports == GPIO_GROUP_MAX_PORTS)
+            {
+                return -1;
+            }
+            group->port[k] = port;
+            group->mask[k] = 0;
+            group->nports++;
+        }
+        group->mask[k] |= (uint16_t)(1u << bitport);
+        group->pin_port[i] = k;
+        group->pin_bit[i] = bitport;
+    }
+    group->n = n;
+    return 0;
+}
+
+/*------------------------------------------------- GPIO_GroupWrite -----
+*  Funcion: GPIO_GroupWrite(group, value)
+*
+* Proposito:    Esta función escribe un valor en un grupo de pines con
+*               una escritura de PDORx por puerto
+*
+* Pre-condición: Grupo precalculado, pines configurados como salida
+*
+* Parametros: group    (IN)  Grupo
+              value    (IN)  Bit i -> canal i
+*
+* Return:      void
+*
+**********************************************************************/
+void GPIO_GroupWrite(const GpioGroup_t * const group, const uint16_t value)
+{
+    uint16_t port_value[GPIO_GROUP_MAX_PORTS] = { 0 };
+
+    for (uint8_t i = 0; i < group->n; i++)
+    {
+        if (value & (1u << i))
+        {
+            port_value[group->pin_port[i]] |= (uint16_t)(1u << group->pin_bit[i]);
+        }
+    }
+    for (uint8_t k = 0; k < group->nports; k++)
+    {
+        GPIO_PortWriteMasked(group->port[k], group->mask[k], port_value[k]);
+    }
+}
+
+/*------------------------------------------------- GPIO_GroupRead -----
+*  Funcion: GPIO_GroupRead(group)
+*
+* Proposito:    Esta función lee un grupo de pines con una lectura de
+*               PDIRx por puerto
+*
+* Parametros: group    (IN)  Grupo
+*
+* Return:                    Bit i -> estado del canal i
+*
+**********************************************************************/
+uint16_t GPIO_GroupRead(const GpioGroup_t * const group)
+{
+    uint16_t port_value[GPIO_GROUP_MAX_PORTS];
+    uint16_t value = 0;
+
+    for (uint8_t k = 0; k < group->nports; k++)
+    {
+        port_value[k] = GPIO_PortRead(group->port[k]);
+    }
+    for (uint8_t i = 0; i < group->n; i++)
+    {
+        if (port_value[group->pin_port[i]] & (1u << group->pin_bit[i]))
+        {
+            value |= (uint16_t)(1u << i);
+        }
+    }
+    return value;
+}
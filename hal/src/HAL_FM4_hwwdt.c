@@ -7,15 +7,42 @@
  *  - HWWDT_Init(wdogload, wdogreset): Configura registros de carga y modo reset.
  *  - HWWDT_Start(): Arranca el HWWDT si aún está parado.
  *  - HWWDT_GetIntStatus(): Consulta el flag de interrupción del HWWDT.
+ *  - HWWDT_IsRunning(): Indica si el HWWDT está en marcha con reset.
  *  - HWWDT_ReadWdgValue(): Lee el contador actual.
  *  - HWWDT_Feed(pattern1, pattern2): Secuencia segura de alimentación (feed).
+ *  - HWWDT_GetMinRemaining() / HWWDT_ClearMinRemaining(): Telemetría de
+ *    holgura, mínimo del contador observado en los feeds.
  *
+ * Registros protegidos:
+ *  - WDG_LDR y WDG_ICL se desbloquean con key1 en WDG_LCK.
+ *  - WDG_CTL necesita key1 y key2 seguidas.
+ *  - El bloqueo se restablece solo tras la escritura.
+ *
+ * Al vencer la cuenta el HWWDT activa su interrupción (NMI) y recarga; si
+ * vence otra vez sin feed y RESEN = 1, resetea el MCU.
+ *
+ * Todos los accesos pasan por HWWDT_REGS (por defecto FM4_HWWDT). Un modelo
+ * fuera del micro puede definirlo en la compilación para apuntar a un bloque
+ * de registros propio y emular la cuenta atrás, la NMI y el reset.
  */
 
 #include <stdint.h>
 #include "s6e2cc.h"
 #include "HAL_FM4_hwwdt.h"
 
+/** Bloque de registros del HWWDT */
+#ifndef HWWDT_REGS
+#define HWWDT_REGS  FM4_HWWDT
+#endif
+
+/** @name Bits de los registros WDG_CTL y WDG_RIS */
+#define WDG_CTL_INTEN  (1u << 0)  /**< Habilita contador e interrupción */
+#define WDG_CTL_RESEN  (1u << 1)  /**< Habilita el reset */
+#define WDG_RIS_RIS    (1u << 0)  /**< Interrupción pendiente */
+
+/** Mínimo del contador visto por HWWDT_Feed() (holgura del peor caso) */
+static volatile uint32_t hwwdt_min_remaining = UINT32_MAX;
+
 /**
  * @brief Inicializa Hardware Watchdog
  *
@@ -26,10 +53,23 @@
  *
  * @note Esta función solo configura el HWWDT
  *       Si se ejecuta Hwwdg_Start() HWWDT empieza a funcionar.
+ *       Reinicia la telemetría de holgura al periodo completo.
  */
 void HWWDT_Init( uint32_t wdogload, uint8_t wdogreset)
 {
-    //TODO: Implementar función
+    // Parada mientras se configura
+    HWWDT_REGS->WDG_LCK = HWWDT_REG_UNLOCK_key1;
+    HWWDT_REGS->WDG_LCK = HWWDT_REG_UNLOCK_key2;
+    HWWDT_REGS->WDG_CTL = 0u;
+
+    HWWDT_REGS->WDG_LCK = HWWDT_REG_UNLOCK_key1;
+    HWWDT_REGS->WDG_LDR = wdogload;
+
+    HWWDT_REGS->WDG_LCK = HWWDT_REG_UNLOCK_key1;
+    HWWDT_REGS->WDG_LCK = HWWDT_REG_UNLOCK_key2;
+    HWWDT_REGS->WDG_CTL = (wdogreset != 0u) ? WDG_CTL_RESEN : 0u;
+
+    hwwdt_min_remaining = wdogload;
 }
 
 /**
@@ -39,7 +79,12 @@ void HWWDT_Init( uint32_t wdogload, uint8_t wdogreset)
 */
 void HWWDT_Start(void)
 {
-    //TODO: Implementar función
+    if ((HWWDT_REGS->WDG_CTL & WDG_CTL_INTEN) == 0u)
+    {
+        HWWDT_REGS->WDG_LCK = HWWDT_REG_UNLOCK_key1;
+        HWWDT_REGS->WDG_LCK = HWWDT_REG_UNLOCK_key2;
+        HWWDT_REGS->WDG_CTL |= WDG_CTL_INTEN;
+    }
 }
 
 /**
@@ -49,7 +94,18 @@ void HWWDT_Start(void)
 */
 uint8_t HWWDT_GetIntStatus(void)
 {
-    //TODO: Implementar función
+    return (HWWDT_REGS->WDG_RIS & WDG_RIS_RIS) ? 1u : 0u;
+}
+
+/**
+* @brief Indica si el HWWDT llegará a resetear el MCU
+*
+* @return   1/0 contador en marcha con reset
+*/
+uint8_t HWWDT_IsRunning(void)
+{
+    uint32_t ctl = HWWDT_REGS->WDG_CTL;
+    return ((ctl & (WDG_CTL_INTEN | WDG_CTL_RESEN)) == (WDG_CTL_INTEN | WDG_CTL_RESEN)) ? 1u : 0u;
 }
 
 /**
@@ -59,7 +115,7 @@ uint8_t HWWDT_GetIntStatus(void)
 */
 uint32_t HWWDT_ReadWdgValue(void)
 {
-    //TODO: Implementar función
+    return HWWDT_REGS->WDG_VLR;
 }
 
 /**
@@ -72,8 +128,35 @@ uint32_t HWWDT_ReadWdgValue(void)
 * @param [in] u8ClearPattern1   Patron de valor arbitrario
 * @param [in] u8ClearPattern2   Inverso del patron de valor arbitrario
 *
+* @note Antes de recargar muestrea el contador para la telemetría de holgura.
 */
 void HWWDT_Feed(uint8_t u8ClearPattern1, uint8_t u8ClearPattern2)
 {
-    //TODO: Implementar función
+    uint32_t remaining = HWWDT_REGS->WDG_VLR;
+    if (remaining < hwwdt_min_remaining)
+    {
+        hwwdt_min_remaining = remaining;
+    }
+
+    HWWDT_REGS->WDG_LCK = HWWDT_REG_UNLOCK_key1;
+    HWWDT_REGS->WDG_ICL = u8ClearPattern1;     // Borra la interrupción y recarga (1)
+    HWWDT_REGS->WDG_ICL = u8ClearPattern2;     // Borra la interrupción y recarga (2)
+}
+
+/**
+* @brief Mínimo del contador del HWWDT observado al alimentarlo
+*
+* @retval uint32_t: ciclos de CLKLC que quedaban en el feed más tardío
+*/
+uint32_t HWWDT_GetMinRemaining(void)
+{
+    return hwwdt_min_remaining;
+}
+
+/**
+* @brief Reinicia la telemetría de holgura
+*/
+void HWWDT_ClearMinRemaining(void)
+{
+    hwwdt_min_remaining = UINT32_MAX;
 }
@@ -5,11 +5,17 @@
  * @details
  * Proporciona:
  *  - Inicialización del bus I2C en modo maestro.
- *  - Escritura de un byte en un registro de un dispositivo esclavo.
+ *  - Cola de transacciones de escritura atendida por interrupción.
+ *  - Escritura bloqueante de un byte en un registro de un dispositivo esclavo.
  *
  * Características:
- *  - Implementación bloqueante.
- *  - Sin gestión de errores (NACK) ni temporizadores (timeout).
+ *  - Cada byte transmitido genera IBCR.INT (interrupción de estado de MFS2).
+ *    La ISR comprueba el ACK del esclavo (IBSR.RACK), errores de bus
+ *    (IBCR.BER, IBSR.AL) y carga el siguiente byte o genera la condición de
+ *    STOP. La detección de STOP (IBSR.SPC) cierra la transacción y arranca
+ *    la siguiente de la cola, sin esperas activas.
+ *  - Timeout por transacción con una alarma del Dual Timer. Si vence, el
+ *    periférico se libera y la transacción termina con I2C_ERR_TIMEOUT.
  *  - Velocidad objetivo: 400 kbit/s con reloj de sistema de 100 MHz.
  *
  * Configuración de pines:
@@ -22,25 +28,125 @@
 
 #include "mcu.h"
 #include "HAL_FM4_i2c.h"
+#include "HAL_FM4_dtimer.h"
+
+// IBCR
+#define IBCR_MSS   0x80u   // Modo maestro (0 -> STOP)
+#define IBCR_ACKE  0x20u   // Habilita ACK
+#define IBCR_WSEL  0x10u   // Espera tras el bit de ACK
+#define IBCR_CNDE  0x08u   // Interrupción por condición (STOP)
+#define IBCR_INTE  0x04u   // Habilita interrupción
+#define IBCR_BER   0x02u   // Error de bus
+#define IBCR_INT   0x01u   // Fin de byte (escribir 0 para borrar)
+
+// IBSR
+#define IBSR_RACK  0x40u   // 1 -> NACK del esclavo
+#define IBSR_AL    0x08u   // Pérdida de arbitraje
+#define IBSR_SPC   0x02u   // STOP detectado
+
+static i2c_xfer_t *i2c_head = 0;   // Transacción en curso (primera de la cola)
+static i2c_xfer_t *i2c_tail = 0;   // Última de la cola
+static uint8_t i2c_idx;            // Siguiente byte a transmitir
+static int8_t i2c_result;          // Resultado a notificar tras el STOP
+static uint8_t i2c_active;         // i2c_head ya arrancada (START enviado)
+static dtim_alarm_t i2c_timeout;   // Alarma de timeout
+
+static void i2c_timeout_cb(dtim_alarm_t *a, void *arg);
 
 /**
- * @brief Retardo por espera activa.
- *
- * @param nCount Número de iteraciones del bucle (dependiente de la frecuencia de CPU).
- *
- * @warning Precisión no garantizada; no usar para temporización crítica.
- * @note Función interna de ayuda para espaciar eventos del bus.
+ * @brief Genera START y envía la dirección de la primera transacción.
+ * @note Llamar con interrupciones deshabilitadas, bus libre e i2c_active = 0.
  */
-static void DonaldDelay( volatile uint32_t nCount)
+static void i2c_start(void)
 {
-  for (; nCount > 0; nCount--);
+  i2c_xfer_t *x = i2c_head;
+  if (x == 0)
+  {
+    return;
+  }
+
+  i2c_active = 1u;
+  i2c_idx = 0;
+  i2c_result = I2C_OK;
+  DTIM_AlarmStart(&i2c_timeout,
+                  I2C_TIMEOUT_BASE_US + I2C_TIMEOUT_BYTE_US * (x->len + 1u),
+                  i2c_timeout_cb, 0);
+
+  FM4_MFS2->ISBA = 0x00u;                        // disable slave address detection
+  FM4_MFS2->ISMK = 0x00;                         // clear slave mask
+  bFM4_MFS2_I2C_ISMK_EN = 0x01;
+  FM4_MFS2->TDR = (x->address << 1)|0x00;        // load device address into transmit data register
+  FM4_MFS2->IBCR = IBCR_MSS | IBCR_INTE;         // select master mode: START + address
+}
+
+/**
+ * @brief Cierra la transacción en curso y arranca la siguiente.
+ * @note Llamar con interrupciones deshabilitadas.
+ */
+static void i2c_finish(int8_t result)
+{
+  i2c_xfer_t *x = i2c_head;
+
+  DTIM_AlarmCancel(&i2c_timeout);
+  i2c_active = 0u;
+  i2c_head = x->next;
+  if (i2c_head == 0)
+  {
+    i2c_tail = 0;
+  }
+  x->next = 0;
+  x->status = result;
+  if (x->callback != 0)
+  {
+    x->callback(x, x->arg);   // puede encolar (y arrancar) nuevas transacciones
+  }
+  if (!i2c_active)
+  {
+    i2c_start();
+  }
+}
+
+/**
+ * @brief Genera la condición de STOP; la transacción se cierra al detectarla.
+ */
+static void i2c_stop(int8_t result)
+{
+  i2c_result = result;
+  FM4_MFS2->IBCR = IBCR_ACKE | IBCR_CNDE | IBCR_INTE;   // MSS = 0 -> STOP
+}
+
+/**
+ * @brief Libera el periférico tras un error o timeout.
+ */
+static void i2c_abort(int8_t result)
+{
+  FM4_MFS2->IBCR = 0x00u;                        // MSS = 0, sin interrupciones
+  bFM4_MFS2_I2C_IBSR_SPC = 0u;
+  i2c_finish(result);
+}
+
+/**
+ * @brief Timeout de la transacción en curso (ISR del Dual Timer).
+ */
+static void i2c_timeout_cb(dtim_alarm_t *a, void *arg)
+{
+  (void)a;
+  (void)arg;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (i2c_head != 0)
+  {
+    i2c_abort(I2C_ERR_TIMEOUT);
+  }
+  __set_PRIMASK(primask);
 }
 
 /**
  * @brief Inicializa el periférico MFS2 en modo I2C a 400 kbit/s.
  *
  * Configura la multiplexación de pines para SCL y SDA, establece SDA en
- * pseudo open-drain, ajusta el baud rate e inicializa el periférico.
+ * pseudo open-drain, ajusta el baud rate e inicializa el periférico y su
+ * interrupción de estado.
  *
  * @post Bus I2C listo para iniciar transferencias en modo maestro.
  */
@@ -56,6 +162,52 @@ void I2C_init(void)
   bFM4_MFS2_I2C_SMR_RIE = 0u;                    // disable receive interrupts
   bFM4_MFS2_I2C_SMR_TIE = 0u;                    // disable transmit interrupts
   FM4_MFS2->SCR |= 0x80u;                        // reset MFS2 (UPCL = 1)
+
+  i2c_head = 0;
+  i2c_tail = 0;
+  i2c_active = 0u;
+  DTIM_Init();                                   // timeouts
+
+  // Interrupción de estado (IBCR.INT, IBSR.SPC): misma prioridad que el
+  // Dual Timer para que ISR y timeout no se interrumpan entre sí
+  NVIC_SetPriority(MFS2_TX_IRQn, (1u << __NVIC_PRIO_BITS) - 3u);
+  NVIC_ClearPendingIRQ(MFS2_TX_IRQn);
+  NVIC_EnableIRQ(MFS2_TX_IRQn);
+}
+
+int8_t I2C_submit(i2c_xfer_t * const x)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (x->status == I2C_PENDING)
+  {
+    __set_PRIMASK(primask);
+    return -1;
+  }
+
+  x->status = I2C_PENDING;
+  x->next = 0;
+  if (i2c_tail == 0)
+  {
+    i2c_head = x;
+    i2c_tail = x;
+  }
+  else
+  {
+    i2c_tail->next = x;
+    i2c_tail = x;
+  }
+  if (!i2c_active)
+  {
+    i2c_start();                                 // bus libre: arranca ya
+  }
+  __set_PRIMASK(primask);
+  return 0;
+}
+
+uint8_t I2C_busy(void)
+{
+  return i2c_head != 0;
 }
 
 /**
@@ -67,28 +219,74 @@ void I2C_init(void)
  * @param device_address Dirección de 7 bits del dispositivo (sin el bit R/W).
  * @param register_address Dirección del registro interno del dispositivo.
  * @param cmd Byte de datos a escribir en el registro.
+ * @return I2C_OK o código de error.
  *
  * @pre Haber llamado previamente a I2C_init().
- * @note Función bloqueante sin comprobación de NACK ni timeout.
+ * @note Función bloqueante: encola la transacción y espera su fin.
  */
-void I2C_write(uint8_t device_address, uint8_t register_address, uint8_t cmd)
+int8_t I2C_write(uint8_t device_address, uint8_t register_address, uint8_t cmd)
 {
-  FM4_MFS2->ISBA = 0x00u;                        // disable slave address detection
-  FM4_MFS2->ISMK = 0x00;                         // clear slave mask
-  bFM4_MFS2_I2C_ISMK_EN = 0x01;
-  FM4_MFS2->TDR = (device_address << 1)|0x00;    // load codec device address into transmit data register
-  FM4_MFS2->IBCR = 0x80u;                        // select master mode
-  while(!(bFM4_MFS2_I2C_IBCR_INT)) {}            // wait for interrupt flag, i.e. transmission complete
-  FM4_MFS2->TDR = (register_address);            // load codec register address into transmit data register
-  bFM4_MFS2_I2C_IBCR_ACKE = 1u;                  // enable acknowledgment
-  bFM4_MFS2_I2C_IBCR_WSEL = 1u;                  // set wait selection bit
-  bFM4_MFS2_I2C_IBCR_INT = 0u;                   // clear interrupt flag
-  while(!(FM4_MFS2->IBCR & 0x01u)) {}            // wait for interrupt flag, i.e. transmission complete
-  FM4_MFS2->TDR = (cmd);                         // load codec register command into transmit data register
-  bFM4_MFS2_I2C_IBCR_ACKE = 1u;                  // enable acknowledgment
-  bFM4_MFS2_I2C_IBCR_WSEL = 1u;                  // set wait selection bit
-  bFM4_MFS2_I2C_IBCR_INT = 0u;                   // clear interrupt flag
-  while(!(FM4_MFS2->IBCR & 0x01u)) {}            // wait for interrupt flag, i.e. transmission complete
-  FM4_MFS2->IBCR = 0x20u;                        // enable acknowledge
-  DonaldDelay(10000);                            // delay
+  uint8_t data[2] = { register_address, cmd };
+  i2c_xfer_t x = { 0, device_address, data, 2u, I2C_OK, 0, 0 };
+
+  I2C_submit(&x);
+  while (x.status == I2C_PENDING) {}             // wait for completion, error or timeout
+  return x.status;
+}
+
+/**
+ * @brief ISR de estado de MFS2 en modo I2C.
+ *
+ * - IBSR.SPC: STOP completado -> cierra la transacción y arranca la siguiente.
+ * - IBCR.BER / IBSR.AL: error de bus -> aborta.
+ * - IBSR.RACK: NACK del esclavo -> STOP con I2C_ERR_NACK.
+ * - Byte reconocido: carga el siguiente o genera STOP.
+ */
+void MFS2_TX_IRQHandler(void)
+{
+  uint8_t ibsr = FM4_MFS2->IBSR;
+  uint8_t ibcr = FM4_MFS2->IBCR;
+
+  if (i2c_head == 0)
+  {
+    FM4_MFS2->IBCR = 0x00u;                      // interrupción espuria
+    bFM4_MFS2_I2C_IBSR_SPC = 0u;
+    return;
+  }
+
+  if (ibsr & IBSR_SPC)
+  {
+    bFM4_MFS2_I2C_IBSR_SPC = 0u;                 // clear stop condition flag
+    FM4_MFS2->IBCR = 0x00u;
+    i2c_finish(i2c_result);
+    return;
+  }
+
+  if ((ibcr & IBCR_INT) == 0u)
+  {
+    return;
+  }
+
+  if ((ibcr & IBCR_BER) || (ibsr & IBSR_AL))
+  {
+    i2c_abort(I2C_ERR_BUS);
+    return;
+  }
+
+  if (ibsr & IBSR_RACK)
+  {
+    i2c_stop(I2C_ERR_NACK);
+    return;
+  }
+
+  if (i2c_idx < i2c_head->len)
+  {
+    FM4_MFS2->TDR = i2c_head->tx[i2c_idx++];     // load next byte into transmit data register
+    // continue: ACK, wait selection, clear interrupt flag
+    FM4_MFS2->IBCR = IBCR_MSS | IBCR_ACKE | IBCR_WSEL | IBCR_INTE;
+  }
+  else
+  {
+    i2c_stop(I2C_OK);
+  }
 }
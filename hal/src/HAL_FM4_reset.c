@@ -0,0 +1,63 @@
+/**
+ * @file HAL_FM4_reset.c
+ * @brief Capa HAL para la causa del último reset del MCU FM4.
+ * @date :2026/03/25 10:18:44
+ *
+ * Funciones disponibles:
+ *  - RST_GetFlags(): Registro RST_STR leído al arrancar.
+ *  - RST_GetCause(): Categoría de la causa del reset.
+ *
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+#include "HAL_FM4_reset.h"
+
+static uint16_t rst_flags;                   /**< RST_STR leído al arrancar */
+static uint8_t rst_read;                     /**< 1 tras la primera lectura */
+
+uint16_t RST_GetFlags(void)
+{
+    if (rst_read == 0u)
+    {
+        union {
+            uint16_t reg;
+            stc_crg_rst_str_field_t f;
+        } rst;
+
+        rst.reg = FM4_CRG->RST_STR;          // una sola lectura: la lectura borra el registro
+        rst_flags = (uint16_t)((rst.f.PONR  ? RST_FLAG_PONR  : 0u) |
+                               (rst.f.INITX ? RST_FLAG_INITX : 0u) |
+                               (rst.f.LVDH  ? RST_FLAG_LVDH  : 0u) |
+                               (rst.f.SWDR  ? RST_FLAG_SWDR  : 0u) |
+                               (rst.f.HWDR  ? RST_FLAG_HWDR  : 0u) |
+                               (rst.f.CSVR  ? RST_FLAG_CSVR  : 0u) |
+                               (rst.f.FCSR  ? RST_FLAG_FCSR  : 0u) |
+                               (rst.f.SRST  ? RST_FLAG_SRST  : 0u));
+        rst_read = 1u;
+    }
+    return rst_flags;
+}
+
+rst_cause_t RST_GetCause(void)
+{
+    uint16_t f = RST_GetFlags();
+
+    if (f & (RST_FLAG_PONR | RST_FLAG_LVDH))
+    {
+        return RST_POWER_ON;
+    }
+    if (f & (RST_FLAG_HWDR | RST_FLAG_SWDR))
+    {
+        return RST_WATCHDOG;
+    }
+    if (f & RST_FLAG_SRST)
+    {
+        return RST_SOFTWARE;
+    }
+    if (f & RST_FLAG_INITX)
+    {
+        return RST_EXTERNAL;
+    }
+    return RST_OTHER;
+}
@@ -7,6 +7,8 @@
 #include "mcu.h"
 #include "HAL_SysTick.h"
 
+static volatile uint64_t systick_ticks = 0;   /* Ticks desde SysTick_InitIRQ() */
+
 
 /**
  *
@@ -46,3 +48,97 @@ uint32_t SysTick_ChkOvf(void)
   if (SysTick->CTRL&SysTick_CTRL_COUNTFLAG_Msk) overflow=1u;
   return overflow;
 }
+
+/**
+ *
+ * @brief   Configura System Tick en modo interrupción
+ * @param [in] ticks  Número de ciclos de reloj entre dos ticks.
+ * @return  0  Ejecución exitosa.
+ * @return  1  Fallo en la ejecución.
+ */
+uint32_t SysTick_InitIRQ(uint32_t ticks)
+{
+  if (SysTick_Init(ticks) != 0UL)
+  {
+    return (1UL);
+  }
+  systick_ticks = 0;
+  NVIC_SetPriority(SysTick_IRQn, (1UL << __NVIC_PRIO_BITS) - 2UL);   /* Por debajo de I2S */
+  SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;                        /* Habilita interrupción */
+  return (0UL);
+}
+
+/**
+ *
+ * @brief   Incrementa el contador de ticks (desde SysTick_Handler)
+ */
+void SysTick_IncTick(void)
+{
+  systick_ticks++;
+}
+
+/**
+ *
+ * @brief   Devuelve el número de ticks desde SysTick_InitIRQ()
+ */
+uint64_t SysTick_GetTick(void)
+{
+  uint64_t t;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();                                                  /* Lectura atómica de 64 bits */
+  t = systick_ticks;
+  __set_PRIMASK(primask);
+  return t;
+}
+
+/**
+ *
+ * @brief   Devuelve el tiempo desde SysTick_InitIRQ() en ciclos de reloj
+ */
+uint64_t SysTick_GetCycles(void)
+{
+  uint64_t t;
+  uint32_t val;
+  uint32_t load = SysTick->LOAD;
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  t = systick_ticks;
+  val = SysTick->VAL;
+  if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+  {
+    /* Tick pendiente sin atender: VAL se relee tras la recarga */
+    val = SysTick->VAL;
+    t++;
+  }
+  __set_PRIMASK(primask);
+
+  return t * (load + 1UL) + (load - val);
+}
+
+/**
+ *
+ * @brief   Devuelve el tiempo desde SysTick_InitIRQ() en microsegundos
+ */
+uint64_t SysTick_GetUs(void)
+{
+  return SysTick_GetCycles() / (SystemCoreClock / 1000000UL);
+}
+
+/**
+ *
+ * @brief   Comprueba si ha transcurrido un intervalo de ticks
+ * @param [in,out] last   Referencia del consumidor.
+ * @param [in]     ticks  Intervalo en ticks.
+ * @return  0  No ha vencido.
+ * @return  1  Ha vencido.
+ */
+uint32_t SysTick_Elapsed(uint64_t * const last, uint32_t ticks)
+{
+  if ((SysTick_GetTick() - *last) < ticks)
+  {
+    return (0UL);
+  }
+  *last += ticks;
+  return (1UL);
+}
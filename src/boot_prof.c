@@ -0,0 +1,40 @@
+/**
+ * @file boot_prof.c
+ * @date :2026/03/16 09:37:25
+ * @brief Perfilador de las fases de arranque
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+#include "boot_prof.h"
+
+boot_mark_t g_boot_log[BOOT_PROF_MAX];
+volatile uint32_t g_boot_first_sample;
+static uint8_t boot_n;                    /**< Marcas registradas */
+
+void boot_prof_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    boot_n = 0;
+    g_boot_first_sample = 0;
+    boot_mark(BOOT_MAIN);
+}
+
+void boot_mark(boot_phase_t phase)
+{
+    if (boot_n < BOOT_PROF_MAX)
+    {
+        g_boot_log[boot_n].phase = phase;
+        g_boot_log[boot_n].cycles = DWT->CYCCNT;
+        boot_n++;
+    }
+}
+
+const boot_mark_t *boot_prof_get(uint8_t *n)
+{
+    *n = boot_n;
+    return g_boot_log;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file boot_prof.h
+ * @date :2026/03/16 09:37:25
+ * @brief Perfilador de las fases de arranque
+ *
+ * Registra en RAM el instante (DWT->CYCCNT, ciclos de HCLK desde la entrada
+ * en main) en que termina cada fase de la inicialización, y el instante en
+ * que la ISR de I2S recibe la primera muestra (tiempo hasta la primera
+ * muestra). El log se consulta con el depurador (g_boot_log) o con
+ * boot_prof_get().
+ *
+ * @note El tiempo de SystemInit() y de la inicialización de la biblioteca C,
+ *       anterior a main, no se incluye.
+ */
+
+#ifndef _BOOT_PROF_H_
+#define _BOOT_PROF_H_
+
+#include <stdint.h>
+#include "mcu.h"
+
+/** Máximo número de marcas en el log */
+#define BOOT_PROF_MAX 16u
+
+/**
+ * @brief Fases de arranque
+ */
+typedef enum {
+    BOOT_MAIN = 0,        /**< Entrada en main */
+    BOOT_LEDS,            /**< LEDs y pulsador */
+    BOOT_TIMERS,          /**< SysTick y Dual Timer */
+    BOOT_CODEC,           /**< Códec configurado (o encolado, arranque rápido) */
+    BOOT_I2S,             /**< I2S en marcha */
+    BOOT_GPIO,            /**< Pines de depuración */
+    BOOT_DSP,             /**< Buffers, decimador, espectro, temporizadores */
+    BOOT_CODEC_READY,     /**< Escrituras al códec terminadas */
+    BOOT_IRQ,             /**< Interrupción de I2S habilitada */
+    BOOT_SCHED,           /**< Entrada en el bucle principal */
+} boot_phase_t;
+
+/**
+ * @struct boot_mark_t
+ * @brief Marca del log de arranque
+ */
+typedef struct {
+    uint32_t phase;       /**< Fase (boot_phase_t) */
+    uint32_t cycles;      /**< CYCCNT al terminar la fase */
+} boot_mark_t;
+
+extern boot_mark_t g_boot_log[BOOT_PROF_MAX];   /**< Log de arranque */
+extern volatile uint32_t g_boot_first_sample;   /**< CYCCNT de la primera muestra (0 -> aún no) */
+
+/**
+ * @brief Arranca el contador de ciclos y registra BOOT_MAIN
+ * @note Llamar al principio de main
+ */
+void boot_prof_init(void);
+
+/**
+ * @brief Registra el fin de una fase
+ *
+ * @param phase Fase
+ */
+void boot_mark(boot_phase_t phase);
+
+/**
+ * @brief Devuelve el log de arranque
+ *
+ * @param n Puntero donde se guarda el número de marcas
+ * @return Puntero al log
+ */
+const boot_mark_t *boot_prof_get(uint8_t *n);
+
+/**
+ * @brief Registra la primera muestra recibida (llamar desde la ISR de I2S)
+ */
+static inline void boot_first_sample(void)
+{
+    if (g_boot_first_sample == 0u)
+    {
+        g_boot_first_sample = DWT->CYCCNT | 1u;
+    }
+}
+
+#endif  /* _BOOT_PROF_H_ */
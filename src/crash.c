@@ -0,0 +1,137 @@
+/**
+ * @file crash.c
+ * @date :2026/03/20 11:02:17
+ * @brief Registro post-mortem en RAM no inicializada (.noinit)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "mcu.h"
+#include "crash.h"
+#include "circ_buf.h"
+#include "trace.h"
+#include "HAL_FM4_crc.h"
+
+crash_record_t g_crash __attribute__((section(".bss.noinit")));
+crash_record_t g_crash_last;
+
+/** Límites de las regiones del fichero de distribución (build_keil/lab6.sct) */
+extern uint32_t Image$$ER_IROM1$$Base[], Image$$ER_IROM1$$Limit[];
+extern uint32_t Image$$ER_IROM2$$Base[], Image$$ER_IROM2$$Limit[];
+extern uint32_t Image$$RW_IRAM1$$Base[], Image$$RW_IRAM1$$ZI$$Limit[];
+
+/**
+ * @brief Indica si un valor puede ser una dirección de retorno
+ */
+static uint8_t crash_is_code(uint32_t v)
+{
+    if ((v & 1u) == 0u)
+    {
+        return 0;                            // sin bit Thumb
+    }
+    v &= ~1u;
+    return ((v >= (uint32_t)Image$$ER_IROM1$$Base) && (v < (uint32_t)Image$$ER_IROM1$$Limit)) ||
+           ((v >= (uint32_t)Image$$ER_IROM2$$Base) && (v < (uint32_t)Image$$ER_IROM2$$Limit));
+}
+
+/**
+ * @brief Busca direcciones de retorno en la pila por encima del marco
+ */
+static void crash_stack_walk(crash_record_t *r, const uint32_t *frame, uint32_t exc_return)
+{
+    const uint32_t *lo = Image$$RW_IRAM1$$Base;
+    const uint32_t *hi = Image$$RW_IRAM1$$ZI$$Limit;  // pilas de main y de los hilos
+
+    r->nbt = 0;
+    if ((frame < lo) || (frame >= hi) || (((uint32_t)frame & 3u) != 0u))
+    {
+        return;                              // SP corrupto: no se recorre
+    }
+    const uint32_t *p = frame + (((exc_return & 0x10u) == 0u) ? 26u : 8u);  // marco con FPU
+    if (frame[CRASH_XPSR] & (1u << 9))
+    {
+        p++;                                 // palabra de alineamiento del marco
+    }
+    for (uint32_t n = 0; (n < CRASH_STACK_SCAN) && (p < hi) && (r->nbt < CRASH_BT_N); n++, p++)
+    {
+        if (crash_is_code(*p))
+        {
+            r->bt[r->nbt++] = *p;
+        }
+    }
+}
+
+/**
+ * @brief CRC-32 de un registro (todos los campos salvo crc)
+ */
+static uint32_t crash_crc(const crash_record_t *r)
+{
+    return CRC32_Calc((const uint8_t *)r, offsetof(crash_record_t, crc));
+}
+
+void crash_faults_enable(void)
+{
+    SCB->SHCSR |= SCB_SHCSR_USGFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk |
+                  SCB_SHCSR_MEMFAULTENA_Msk;
+}
+
+void crash_save(uint32_t reason, uint32_t info, const uint32_t *frame, uint32_t exc_return)
+{
+    crash_record_t *r = &g_crash;
+
+    __disable_irq();
+    if ((r->magic == CRASH_MAGIC) && (r->crc == crash_crc(r)))
+    {
+        return;                              // el primer fallo gana
+    }
+    r->magic = 0;                            // inválido hasta el CRC
+    r->reason = reason;
+    r->info = info;
+    r->cyccnt = DWT->CYCCNT;
+    for (uint8_t i = 0; i < CRASH_FRAME_WORDS; i++)
+    {
+        r->frame[i] = (frame != NULL) ? frame[i] : 0u;
+    }
+    r->sp = (uint32_t)frame;
+    r->exc_return = exc_return;
+    r->cfsr = SCB->CFSR;
+    r->hfsr = SCB->HFSR;
+    r->mmfar = SCB->MMFAR;
+    r->bfar = SCB->BFAR;
+    r->nbt = 0;
+    if (frame != NULL)
+    {
+        crash_stack_walk(r, frame, exc_return);
+    }
+    r->tx = g_tx_buffer;
+    r->rx = g_rx_buffer;
+    r->ntrace = trace_last(r->trace, CRASH_TRACE_N);
+    r->magic = CRASH_MAGIC;
+    r->crc = crash_crc(r);
+}
+
+const crash_record_t *crash_boot_read(void)
+{
+    const crash_record_t *last = NULL;
+
+    if ((g_crash.magic == CRASH_MAGIC) && (g_crash.crc == crash_crc(&g_crash)))
+    {
+        g_crash_last = g_crash;
+        last = &g_crash_last;
+    }
+    g_crash.magic = 0;                       // notificado (o basura tras encendido)
+    return last;
+}
+
+const char *crash_reason_name(uint32_t reason)
+{
+    switch (reason)
+    {
+        case CRASH_HWWDT: return "HWWDT";
+        case CRASH_HARDFAULT: return "HardFault";
+        case CRASH_MEMMANAGE: return "MemManage";
+        case CRASH_BUSFAULT: return "BusFault";
+        case CRASH_USAGEFAULT: return "UsageFault";
+        default:          return "?";
+    }
+}
@@ -0,0 +1,138 @@
+/**
+ * @file crash.h
+ * @date :2026/03/20 11:02:17
+ * @brief Registro post-mortem en RAM no inicializada (.noinit)
+ *
+ * Antes del reset por fallo (NMI del HWWDT, excepciones de fallo, etc.) se
+ * guarda en g_crash el estado del sistema: marco apilado por la excepción
+ * (r0-r3, r12, LR, PC, xPSR), registros de estado de fallos del SCB,
+ * índices y contenido de los buffers circulares de audio y los últimos
+ * eventos de la traza (trace.h), protegido con un CRC-32.
+ *
+ * g_crash está en la sección .bss.noinit, que el fichero de distribución
+ * (build_keil/lab6.sct) coloca en una región UNINIT: el arranque no la pone
+ * a cero y sobrevive al reset. Tras el reset crash_boot_read() valida el
+ * registro (marca y CRC), lo copia a g_crash_last para el depurador y lo
+ * invalida para no volver a notificarlo.
+ *
+ * Con un marco de excepción se recorre además la pila por encima de él
+ * (como mucho CRASH_STACK_SCAN palabras, sin salir de la RAM de datos) y
+ * se guardan las primeras CRASH_BT_N palabras que parecen direcciones de
+ * retorno (bit Thumb y dentro del código). Es una heurística: puede incluir
+ * valores antiguos de la pila. tools/crash2txt.py decodifica un volcado de
+ * g_crash_last y simboliza las direcciones contra el ELF.
+ *
+ * El primer registro gana: si ya hay uno válido en esta ejecución (p.ej. un
+ * HardFault seguido de la NMI del HWWDT mientras espera el reset),
+ * crash_save() no lo sobrescribe.
+ *
+ * @note Un reset por pérdida de alimentación deja la RAM con contenido
+ *       arbitrario; la marca y el CRC lo descartan.
+ */
+
+#ifndef _CRASH_H_
+#define _CRASH_H_
+
+#include <stdint.h>
+#include "circ_buf.h"
+#include "trace.h"
+
+/** Marca de registro válido ("CRSH") */
+#define CRASH_MAGIC    0x48535243u
+
+/** Eventos de la traza que se conservan */
+#define CRASH_TRACE_N  16u
+
+/** Direcciones de retorno candidatas que se conservan */
+#define CRASH_BT_N     8u
+
+/** Palabras de pila examinadas por encima del marco */
+#define CRASH_STACK_SCAN  128u
+
+/**
+ * @brief Causa del registro
+ */
+typedef enum {
+    CRASH_NONE = 0,           /**< Sin registro */
+    CRASH_HWWDT = 1,          /**< NMI del Hardware Watchdog (info: wdt_sup_late(), 0 -> bucle principal bloqueado) */
+    CRASH_HARDFAULT = 2,      /**< HardFault */
+    CRASH_MEMMANAGE = 3,      /**< MemManage (MPU / XN) */
+    CRASH_BUSFAULT = 4,       /**< BusFault */
+    CRASH_USAGEFAULT = 5,     /**< UsageFault */
+} crash_reason_t;
+
+/**
+ * @brief Posiciones del marco apilado por la excepción
+ */
+enum {
+    CRASH_R0 = 0, CRASH_R1, CRASH_R2, CRASH_R3, CRASH_R12,
+    CRASH_LR, CRASH_PC, CRASH_XPSR, CRASH_FRAME_WORDS
+};
+
+/**
+ * @struct crash_record_t
+ * @brief Registro post-mortem
+ */
+typedef struct {
+    uint32_t magic;                          /**< CRASH_MAGIC si es válido */
+    uint32_t reason;                         /**< crash_reason_t */
+    uint32_t info;                           /**< Dato según la causa */
+    uint32_t cyccnt;                         /**< DWT->CYCCNT al guardar */
+    uint32_t frame[CRASH_FRAME_WORDS];       /**< Marco apilado (0 si no hay) */
+    uint32_t sp;                             /**< Dirección del marco */
+    uint32_t exc_return;                     /**< EXC_RETURN de la excepción */
+    uint32_t cfsr;                           /**< SCB->CFSR */
+    uint32_t hfsr;                           /**< SCB->HFSR */
+    uint32_t mmfar;                          /**< SCB->MMFAR */
+    uint32_t bfar;                           /**< SCB->BFAR */
+    uint32_t nbt;                            /**< Entradas válidas en bt[] */
+    uint32_t bt[CRASH_BT_N];                 /**< Direcciones de retorno candidatas (pila) */
+    circ_buf_t tx;                           /**< g_tx_buffer */
+    circ_buf_t rx;                           /**< g_rx_buffer */
+    uint32_t ntrace;                         /**< Eventos válidos en trace[] */
+    trace_event_t trace[CRASH_TRACE_N];      /**< Últimos eventos, del más antiguo al más reciente */
+    uint32_t crc;                            /**< CRC-32 de los campos anteriores */
+} crash_record_t;
+
+extern crash_record_t g_crash;               /**< Registro en .noinit */
+extern crash_record_t g_crash_last;          /**< Registro del último fallo (tras el arranque) */
+
+/**
+ * @brief Guarda el registro post-mortem
+ *
+ * @param reason     Causa (crash_reason_t)
+ * @param info       Dato según la causa
+ * @param frame      Marco apilado por la excepción (NULL desde código normal)
+ * @param exc_return EXC_RETURN de la excepción (0 si no hay)
+ *
+ * @note Pensada para llamarse con el sistema detenido, justo antes de
+ *       esperar el reset; no vuelve a habilitar interrupciones.
+ */
+void crash_save(uint32_t reason, uint32_t info, const uint32_t *frame, uint32_t exc_return);
+
+/**
+ * @brief Habilita las excepciones MemManage, BusFault y UsageFault
+ *
+ * Sin habilitar, esos fallos escalan a HardFault y se pierde la causa
+ * inmediata (sigue en CFSR).
+ */
+void crash_faults_enable(void);
+
+/**
+ * @brief Valida el registro del arranque anterior
+ *
+ * @return Puntero a g_crash_last si había un registro válido, NULL si no
+ *
+ * @note Llamar una vez al principio de main. Invalida g_crash.
+ */
+const crash_record_t *crash_boot_read(void);
+
+/**
+ * @brief Nombre de la causa de un registro
+ *
+ * @param reason Causa
+ * @return Cadena constante
+ */
+const char *crash_reason_name(uint32_t reason);
+
+#endif  /* _CRASH_H_ */
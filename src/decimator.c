@@ -0,0 +1,182 @@
+/**
+ * @file decimator.c
+ * @date :2026/02/02 09:47:55
+ * @brief Decimadores FIR polifásico y CIC para el receptor FSK
+ *
+ * La salida m es y[m] = sum_k h[k] x[mM - k]. La entrada x[n] contribuye a
+ * las L salidas siguientes con los coeficientes h[q], h[q+M], ... h[q+(L-1)M],
+ * donde q = (M - n mod M) mod M. Cuando q = 0 la salida más antigua queda
+ * completa.
+ *
+ * Diseño (SciPy), coeficientes en Q15:
+ * @code
+ * h4 = remez(24, [0, 2600, 9400, 24000], [1, 0], weight=[1, 10], fs=48000)
+ * h6 = remez(48, [0, 2600, 5400, 24000], [1, 0], weight=[1, 30], fs=48000)
+ * @endcode
+ *
+ * CIC de orden 2: H(z) = ((1 - z^-M) / (1 - z^-1))^2, ganancia M^2 en
+ * continua. Los integradores desbordan sin pérdida (aritmética modular): la
+ * salida de los peines cabe en 32 bits (|y| <= 2^15 M^2). La compensación
+ * [-a, 1+2a, -a] a fs/M tiene ganancia 1 en continua; a se elige para que
+ * la respuesta conjunta sea igual en marca y espacio:
+ * @code
+ *   M = 4 (12 kHz): a = 0.0990 -> ganancia 1.006 en 1200 y 2200 Hz
+ *   M = 6 ( 8 kHz): a = 0.1446 -> ganancia 1.041 en 1200 y 2200 Hz
+ * @endcode
+ */
+
+#include <stdint.h>
+#include "decimator.h"
+
+/**
+ * @brief FIR 48 kHz -> 12 kHz (M = 4, L = 6)
+ */
+static const int16_t h_decim4[24] = {
+    40, 99, 119, -12, -351, -771, -914, -323, 1259, 3614, 6018, 7544,
+    7544, 6018, 3614, 1259, -323, -914, -771, -351, -12, 119, 99, 40
+};
+
+/**
+ * @brief FIR 48 kHz -> 8 kHz (M = 6, L = 8)
+ */
+static const int16_t h_decim6[48] = {
+    -19, -19, -13, 10, 55, 121, 195, 256, 275, 226, 92, -122,
+    -387, -642, -808, -800, -547, -15, 783, 1775, 2841, 3832, 4597, 5014,
+    5014, 4597, 3832, 2841, 1775, 783, -15, -547, -800, -808, -642, -387,
+    -122, 92, 226, 275, 256, 195, 121, 55, 10, -13, -19, -19
+};
+
+int8_t decim_init(decim_t * const d, uint8_t factor)
+{
+    switch (factor)
+    {
+    case 4:
+        d->h = h_decim4;
+        d->phases = sizeof(h_decim4) / sizeof(h_decim4[0]) / 4u;
+        break;
+    case 6:
+        d->h = h_decim6;
+        d->phases = sizeof(h_decim6) / sizeof(h_decim6[0]) / 6u;
+        break;
+    default:
+        return -1;
+    }
+    d->factor = factor;
+    d->q = 0;
+    d->head = 0;
+    for (uint8_t i = 0; i < DECIM_MAX_PHASES; i++)
+    {
+        d->acc[i] = 0;
+    }
+    return 0;
+}
+
+uint8_t decim_process(decim_t * const d, int16_t x, int16_t * const y)
+{
+    const int16_t *h = &d->h[d->q];
+    uint8_t j = d->head;
+
+    // Contribución de x a las L salidas pendientes
+    for (uint8_t i = 0; i < d->phases; i++)
+    {
+        d->acc[j] += (int32_t)h[0] * x;
+        h += d->factor;
+        if (++j == d->phases)
+        {
+            j = 0;
+        }
+    }
+
+    if (d->q != 0u)
+    {
+        d->q--;
+        return 0;
+    }
+
+    // Salida completa: Q30 -> Q15 con redondeo y saturación
+    int32_t acc = (d->acc[d->head] + (1 << 14)) >> 15;
+    if (acc > INT16_MAX)
+    {
+        acc = INT16_MAX;
+    }
+    else if (acc < INT16_MIN)
+    {
+        acc = INT16_MIN;
+    }
+    *y = (int16_t)acc;
+
+    d->acc[d->head] = 0;
+    if (++d->head == d->phases)
+    {
+        d->head = 0;
+    }
+    d->q = d->factor - 1u;
+    return 1;
+}
+
+int8_t decim_cic_init(decim_cic_t * const d, uint8_t factor)
+{
+    switch (factor)
+    {
+    case 4:
+        d->gain = 4096u;               // 2^16 / 16
+        d->comp_a = 1622;              // 0.0990 (Q14)
+        break;
+    case 6:
+        d->gain = 1820u;               // 2^16 / 36
+        d->comp_a = 2369;              // 0.1446 (Q14)
+        break;
+    default:
+        return -1;
+    }
+    d->factor = factor;
+    d->q = factor - 1u;
+    d->i1 = 0;
+    d->i2 = 0;
+    d->c1 = 0;
+    d->c2 = 0;
+    d->z1 = 0;
+    d->z2 = 0;
+    return 0;
+}
+
+uint8_t decim_cic_process(decim_cic_t * const d, int16_t x, int16_t * const y)
+{
+    // Integradores (aritmética modular)
+    d->i1 += (uint32_t)(int32_t)x;
+    d->i2 += d->i1;
+
+    if (d->q != 0u)
+    {
+        d->q--;
+        return 0;
+    }
+    d->q = d->factor - 1u;
+
+    // Peines a fs/M
+    uint32_t c = d->i2 - d->c1;
+    d->c1 = d->i2;
+    int32_t u = (int32_t)(c - d->c2);
+    d->c2 = c;
+
+    // Normalización 1/M^2 -> Q15
+    u = (int32_t)(((int64_t)u * d->gain + (1 << 15)) >> 16);
+
+    // Compensación -a u[m] + (1+2a) u[m-1] - a u[m-2] (Q14)
+    int32_t acc = ((int32_t)(1 << 14) + 2 * d->comp_a) * d->z1
+                - (int32_t)d->comp_a * (u + d->z2);
+    d->z2 = d->z1;
+    d->z1 = u;
+
+    acc = (acc + (1 << 13)) >> 14;
+    if (acc > INT16_MAX)
+    {
+        acc = INT16_MAX;
+    }
+    else if (acc < INT16_MIN)
+    {
+        acc = INT16_MIN;
+    }
+    *y = (int16_t)acc;
+    return 1;
+}
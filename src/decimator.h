@@ -0,0 +1,106 @@
+/**
+ * @file decimator.h
+ * @date :2026/02/02 09:47:55
+ * @brief Decimador FIR polifásico para el receptor FSK
+ *
+ * Reduce la frecuencia de muestreo de la señal recibida (48 kHz) en un factor
+ * M configurable (4 -> 12 kHz, 6 -> 8 kHz), con dos estructuras:
+ *
+ * FIR polifásico (decim_init(), decim_process()):
+ * - M = 4 -> 12 kHz. FIR de 24 coeficientes, 6 acumuladores.
+ * - M = 6 ->  8 kHz. FIR de 48 coeficientes, 8 acumuladores.
+ * Ambos filtros (equirizado, remez) tienen banda de paso 0-2600 Hz (rizado
+ * < 0.2 dB) y atenúan más de 59 dB las bandas que se solapan sobre ella al
+ * decimar (fs_out - 2600 Hz en adelante). Estructura polifásica transpuesta:
+ * cada muestra de entrada realiza exactamente N/M productos, repartidos entre
+ * los N/M acumuladores de las salidas pendientes, sin picos de carga cada M
+ * muestras. Es el que alimenta al monitor de espectro.
+ *
+ * CIC de orden 2 con compensación (decim_cic_init(), decim_cic_process()):
+ * - Dos integradores por muestra de entrada (dos sumas, sin productos).
+ * - Por muestra de salida: dos peines, normalización por 1/M^2 y un FIR de
+ *   compensación de 3 coeficientes [-a, 1+2a, -a] que iguala la caída del
+ *   CIC en 1200 y 2200 Hz (marca y espacio).
+ * - Atenúa unos 12 dB las bandas que se solapan sobre 2600 Hz: suficiente
+ *   para el demodulador FSK (test/host/test_fsk_demod.c mide la BER), no
+ *   para el monitor de espectro. Es el que alimenta al demodulador.
+ *
+ * @note Muestras de entrada y salida en Q15. FIR: acumuladores en Q30
+ *       (32 bits). CIC: integradores en aritmética modular de 32 bits.
+ *       Salidas redondeadas y saturadas.
+ */
+
+#ifndef _DECIMATOR_H_
+#define _DECIMATOR_H_
+
+#include <stdint.h>
+
+/** Máximo número de acumuladores (N/M) de los filtros disponibles */
+#define DECIM_MAX_PHASES 8u
+
+/**
+ * @struct decim_t
+ * @brief Estado de un decimador polifásico
+ */
+typedef struct {
+    const int16_t *h;                  /**< Coeficientes del FIR (Q15) */
+    uint8_t  factor;                   /**< Factor de decimación M */
+    uint8_t  phases;                   /**< Número de acumuladores L = N/M */
+    uint8_t  q;                        /**< Fase de la siguiente muestra de entrada */
+    uint8_t  head;                     /**< Acumulador de la siguiente salida */
+    int32_t  acc[DECIM_MAX_PHASES];    /**< Acumuladores de salidas pendientes */
+} decim_t;
+
+/**
+ * @brief Inicializa un decimador
+ *
+ * @param d      Puntero al decimador
+ * @param factor Factor de decimación: 4 (48k->12k) o 6 (48k->8k)
+ * @return 0 si tiene éxito, -1 si el factor no está soportado
+ */
+int8_t decim_init(decim_t * const d, uint8_t factor);
+
+/**
+ * @brief Procesa una muestra de entrada
+ *
+ * @param d Puntero al decimador
+ * @param x Muestra de entrada (Q15)
+ * @param y Puntero donde se guarda la muestra de salida, si la hay
+ * @return 1 si se ha generado una muestra de salida, 0 en caso contrario
+ */
+uint8_t decim_process(decim_t * const d, int16_t x, int16_t * const y);
+
+/**
+ * @struct decim_cic_t
+ * @brief Estado de un decimador CIC de orden 2 con compensación
+ */
+typedef struct {
+    uint32_t i1, i2;                   /**< Integradores */
+    uint32_t c1, c2;                   /**< Retardos de los peines */
+    int32_t  z1, z2;                   /**< Retardos de la compensación */
+    uint16_t gain;                     /**< round(2^16 / M^2) */
+    int16_t  comp_a;                   /**< a de la compensación (Q14) */
+    uint8_t  factor;                   /**< Factor de decimación M */
+    uint8_t  q;                        /**< Muestras que faltan para la salida */
+} decim_cic_t;
+
+/**
+ * @brief Inicializa un decimador CIC
+ *
+ * @param d      Puntero al decimador
+ * @param factor Factor de decimación: 4 (48k->12k) o 6 (48k->8k)
+ * @return 0 si tiene éxito, -1 si el factor no está soportado
+ */
+int8_t decim_cic_init(decim_cic_t * const d, uint8_t factor);
+
+/**
+ * @brief Procesa una muestra de entrada
+ *
+ * @param d Puntero al decimador
+ * @param x Muestra de entrada (Q15)
+ * @param y Puntero donde se guarda la muestra de salida, si la hay
+ * @return 1 si se ha generado una muestra de salida, 0 en caso contrario
+ */
+uint8_t decim_cic_process(decim_cic_t * const d, int16_t x, int16_t * const y);
+
+#endif  /* _DECIMATOR_H_ */
@@ -0,0 +1,45 @@
+/**
+ * @file dsp_params.c
+ * @date :2026/01/26 11:04:18
+ * @brief Parámetros DSP del módem FSK por frecuencia de muestreo
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dsp_params.h"
+#include "HAL_FM4_i2s.h"
+
+/**
+ * @brief Tabla de parámetros precalculados
+ *
+ * delay = round(22 * fs / 48000), phaseinc = round(f * 65536 / fs),
+ * samples_bit_q8 = round(256 * fs / 1200)
+ */
+static const dsp_params_t dsp_params_tbl[] = {
+    { FS_8000_HZ,   8000u,  4u, 9830u, 18022u,  1707u,
+      { 148485487,  296738252, 148485487 }, {  -830533199, 422944083 } },
+    { FS_16000_HZ, 16000u,  7u, 4915u,  9011u,  3413u,
+      {  45907321,   91491002,  45907321 }, { -1515369088, 647299580 } },
+    { FS_24000_HZ, 24000u, 11u, 3277u,  6007u,  5120u,
+      {  22118693,   43879923,  22118693 }, { -1737881788, 763009212 } },
+    { FS_32000_HZ, 32000u, 15u, 2458u,  4506u,  6827u,
+      {  12998659,   25622331,  12998659 }, { -1845977228, 830153603 } },
+    { FS_48000_HZ, 48000u, 22u, 1638u,  3004u, 10240u,
+      {   6076360,   11759846,   6076360 }, { -1950953976, 904042492 } },
+    { FS_96000_HZ, 96000u, 44u,  819u,  1502u, 20480u,
+      {   1661693,    2912318,   1661693 }, { -2051844891, 985099642 } },
+};
+
+#define DSP_PARAMS_N (sizeof(dsp_params_tbl) / sizeof(dsp_params_tbl[0]))
+
+const dsp_params_t *dsp_params_get(uint8_t fs)
+{
+    for (uint8_t i = 0; i < DSP_PARAMS_N; i++)
+    {
+        if (dsp_params_tbl[i].fs_code == fs)
+        {
+            return &dsp_params_tbl[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file dsp_params.h
+ * @date :2026/01/26 11:04:18
+ * @brief Parámetros DSP del módem FSK por frecuencia de muestreo
+ *
+ * Tabla precalculada con los parámetros del módem FSK (Bell 202, 1200 baud,
+ * marca 1200 Hz, espacio 2200 Hz) para cada frecuencia de muestreo soportada
+ * por I2S_init() y FM4_WM8731_init():
+ * - Retardo del demodulador por autocorrelación (22 muestras a 48 kHz).
+ * - Incrementos de fase del DDS de 16 bits para marca y espacio.
+ * - Muestras por bit en Q8.
+ * - Coeficientes del filtro elíptico de 2º orden en Q30.
+ *
+ * Diseño (Matlab/SciPy), para cada fs:
+ * @code
+ * [b,a] = ellip(2,1,80,1200/(fs/2));
+ * @endcode
+ *
+ * Los usan los módulos con código fuente, cada uno a su frecuencia de
+ * trabajo: fsk_demod_init() (delay, b, a) y fsk_link_tx_init() /
+ * fsk_link_rx_init() (incrementos de fase, muestras por bit).
+ *
+ * @note El códec y el I2S trabajan siempre a 48 kHz: lab5() y
+ *       lab41()/lab42() se distribuyen precompilados en 30319_shared.lib y
+ *       están fijados a esa frecuencia. No hay cambio de fs en ejecución; las
+ *       demás entradas sirven a las etapas tras un decimador (8 kHz con
+ *       M = 6).
+ */
+
+#ifndef _DSP_PARAMS_H_
+#define _DSP_PARAMS_H_
+
+#include <stdint.h>
+
+/** Frecuencia de la marca (bit 1) en Hz */
+#define FSK_MARK_HZ   1200u
+/** Frecuencia del espacio (bit 0) en Hz */
+#define FSK_SPACE_HZ  2200u
+/** Velocidad de transmisión en baudios */
+#define FSK_BAUD      1200u
+
+/**
+ * @struct dsp_params_t
+ * @brief Conjunto de parámetros DSP para una frecuencia de muestreo
+ */
+typedef struct {
+    uint8_t  fs_code;          /**< Código FS_xxx_HZ del códec/I2S */
+    uint32_t fs_hz;            /**< Frecuencia de muestreo en Hz */
+    uint16_t delay;            /**< Retardo del demodulador (muestras) */
+    uint16_t phaseinc_mark;    /**< Incremento de fase DDS de la marca */
+    uint16_t phaseinc_space;   /**< Incremento de fase DDS del espacio */
+    uint32_t samples_bit_q8;   /**< Muestras por bit en Q8 */
+    int32_t  b[3];             /**< Numerador del filtro IIR (Q30) */
+    int32_t  a[2];             /**< Denominador a1, a2 del filtro IIR (Q30) */
+} dsp_params_t;
+
+/**
+ * @brief Busca el conjunto de parámetros de una frecuencia de muestreo
+ *
+ * @param fs Código de frecuencia FS_xxx_HZ
+ * @return Puntero al conjunto de parámetros, NULL si fs no está soportada
+ */
+const dsp_params_t *dsp_params_get(uint8_t fs);
+
+#endif  /* _DSP_PARAMS_H_ */
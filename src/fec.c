@@ -0,0 +1,386 @@
+/**
+ * @file fec.c
+ * @date :2026/01/19 09:32:40
+ * @brief Corrección de errores (FEC): Hamming(7,4) y convolucional K=7 + Viterbi
+ *
+ * Trellis del código convolucional:
+ * - Estado: últimos K-1 = 6 bits de entrada, el más reciente en el bit 0.
+ * - Transición: n = ((p << 1) | b) & 0x3F, registro completo (p << 1) | b.
+ * - Predecesores de n: n >> 1 y (n >> 1) | 0x20.
+ *
+ * Como G0 y G1 tienen a 1 los bits 0 y 6, la mariposa j (predecesores j y
+ * j+32, sucesores 2j y 2j+1) solo necesita una métrica de rama m: las cuatro
+ * ramas tienen métricas m, 2-m, 2-m y m:
+ * @code
+ *   npm[2j]   = min(pm[j] + m,   pm[j+32] + 2-m)
+ *   npm[2j+1] = min(pm[j] + 2-m, pm[j+32] + m)
+ * @endcode
+ * En caso de empate se elige el predecesor j+32 (decisión = 1).
+ */
+
+#include <stdint.h>
+#include "fec.h"
+
+#if defined(__ARM_FEATURE_SIMD32)
+#include "mcu.h"
+#endif
+
+// =============================================================================
+// HAMMING (7,4)
+// =============================================================================
+
+/**
+ * @brief Posición del bit erróneo en función del síndrome (s2 s1 s0)
+ * @note 0xFF -> síndrome nulo, sin error
+ */
+static const uint8_t hamming_syndrome_bit[8] = {
+    0xFF, 4, 5, 0, 6, 1, 2, 3
+};
+
+uint8_t fec_hamming74_encode(uint8_t nibble)
+{
+    uint8_t d0 = (nibble >> 0) & 1u;
+    uint8_t d1 = (nibble >> 1) & 1u;
+    uint8_t d2 = (nibble >> 2) & 1u;
+    uint8_t d3 = (nibble >> 3) & 1u;
+    uint8_t p0 = d0 ^ d1 ^ d3;
+    uint8_t p1 = d0 ^ d2 ^ d3;
+    uint8_t p2 = d1 ^ d2 ^ d3;
+    return (uint8_t)((nibble & 0x0Fu) | (p0 << 4) | (p1 << 5) | (p2 << 6));
+}
+
+uint8_t fec_hamming74_decode(uint8_t code, uint8_t *nibble)
+{
+    uint8_t s0 = ((code >> 4) ^ (code >> 0) ^ (code >> 1) ^ (code >> 3)) & 1u;
+    uint8_t s1 = ((code >> 5) ^ (code >> 0) ^ (code >> 2) ^ (code >> 3)) & 1u;
+    uint8_t s2 = ((code >> 6) ^ (code >> 1) ^ (code >> 2) ^ (code >> 3)) & 1u;
+    uint8_t pos = hamming_syndrome_bit[(s2 << 2) | (s1 << 1) | s0];
+    uint8_t corrected = 0;
+
+    if (pos != 0xFFu)
+    {
+        code ^= (uint8_t)(1u << pos);
+        corrected = 1;
+    }
+    *nibble = code & 0x0Fu;
+    return corrected;
+}
+
+void fec_hamming_encode_byte(uint8_t byte, uint8_t sym[14])
+{
+    uint8_t lo = fec_hamming74_encode(byte & 0x0Fu);
+    uint8_t hi = fec_hamming74_encode(byte >> 4);
+    for (uint8_t i = 0; i < 7u; i++)
+    {
+        sym[i]      = (lo >> i) & 1u;
+        sym[i + 7u] = (hi >> i) & 1u;
+    }
+}
+
+uint8_t fec_hamming_decode_byte(const uint8_t sym[14], uint8_t *byte)
+{
+    uint8_t lo = 0, hi = 0;
+    for (uint8_t i = 0; i < 7u; i++)
+    {
+        lo |= (uint8_t)((sym[i] & 1u) << i);
+        hi |= (uint8_t)((sym[i + 7u] & 1u) << i);
+    }
+    uint8_t nlo, nhi;
+    uint8_t corrected = fec_hamming74_decode(lo, &nlo);
+    corrected += fec_hamming74_decode(hi, &nhi);
+    *byte = (uint8_t)(nlo | (nhi << 4));
+    return corrected;
+}
+
+// =============================================================================
+// CONVOLUCIONAL K=7 r=1/2
+// =============================================================================
+
+/** Número máximo de pasos del trellis por trama */
+#define VITERBI_MAX_STEPS  (8u * FEC_CONV_MAX_BYTES + (FEC_CONV_K - 1))
+/** Pasos entre renormalizaciones de las métricas de 8 bits */
+#define VITERBI_RENORM     16u
+/** Métrica inicial de los estados distintos de 0 */
+#define VITERBI_INIT_PM    32u
+
+/**
+ * @brief Paridad de un valor de 8 bits
+ */
+static uint8_t parity8(uint8_t x)
+{
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return x & 1u;
+}
+
+uint32_t fec_conv_encode(const uint8_t *data, uint32_t nbytes, uint8_t *sym)
+{
+    if (nbytes > FEC_CONV_MAX_BYTES)
+    {
+        return 0;
+    }
+
+    uint8_t reg = 0;
+    uint32_t n = 0;
+    for (uint32_t t = 0; t < 8u * nbytes + (FEC_CONV_K - 1); t++)
+    {
+        uint8_t b = (t < 8u * nbytes) ? ((data[t >> 3] >> (t & 7u)) & 1u) : 0u;
+        reg = (uint8_t)(((reg << 1) | b) & 0x7Fu);
+        sym[n++] = parity8(reg & FEC_CONV_G0);
+        sym[n++] = parity8(reg & FEC_CONV_G1);
+    }
+    return n;
+}
+
+/**
+ * @brief Métricas de camino, 1 byte por estado
+ */
+static union {
+    uint8_t  u8[FEC_CONV_STATES];
+    uint32_t u32[FEC_CONV_STATES / 4];
+} pm[2];
+
+/**
+ * @brief Decisiones ACS: bit n = 1 si el superviviente del estado n viene de
+ *        (n >> 1) | 0x20
+ */
+static uint32_t decisions[VITERBI_MAX_STEPS][FEC_CONV_STATES / 32];
+
+/**
+ * @brief Métrica de rama m de las 32 mariposas para cada par recibido (r0 r1)
+ */
+static union {
+    uint8_t  u8[FEC_CONV_STATES / 2];
+    uint32_t u32[FEC_CONV_STATES / 8];
+} bm_tbl[4];
+
+static uint8_t bm_tbl_ready = 0;
+
+/**
+ * @brief Calcula la tabla de métricas de rama (una sola vez)
+ */
+static void viterbi_init_tables(void)
+{
+    for (uint8_t r = 0; r < 4u; r++)
+    {
+        for (uint8_t j = 0; j < FEC_CONV_STATES / 2; j++)
+        {
+            uint8_t o0 = parity8((uint8_t)(2u * j) & FEC_CONV_G0);
+            uint8_t o1 = parity8((uint8_t)(2u * j) & FEC_CONV_G1);
+            bm_tbl[r].u8[j] = (uint8_t)((o0 ^ (r >> 1)) + (o1 ^ (r & 1u)));
+        }
+    }
+    bm_tbl_ready = 1;
+}
+
+#if defined(__ARM_FEATURE_SIMD32)
+
+/**
+ * @brief Un paso ACS del trellis, 4 mariposas por iteración (SIMD)
+ *
+ * @param old Métricas de entrada
+ * @param new Métricas de salida
+ * @param bm  Métricas de rama m de las 32 mariposas
+ * @param dec Decisiones de salida (64 bits)
+ */
+static void viterbi_acs(const uint32_t *old, uint32_t *new,
+                        const uint32_t *bm, uint32_t *dec)
+{
+    for (uint32_t g = 0; g < FEC_CONV_STATES / 8; g++)
+    {
+        uint32_t a  = old[g];                        // pm[j..j+3]
+        uint32_t b  = old[g + FEC_CONV_STATES / 8];  // pm[j+32..j+35]
+        uint32_t m  = bm[g];
+        uint32_t mc = 0x02020202u - m;
+
+        // Sucesores pares 2j
+        uint32_t x0 = __UQADD8(a, m);
+        uint32_t y0 = __UQADD8(b, mc);
+        __USUB8(x0, y0);                             // GE = x0 >= y0
+        uint32_t n0 = __SEL(y0, x0);
+        uint32_t d  = __SEL(0x40100401u, 0u);
+
+        // Sucesores impares 2j+1
+        uint32_t x1 = __UQADD8(a, mc);
+        uint32_t y1 = __UQADD8(b, m);
+        __USUB8(x1, y1);
+        uint32_t n1 = __SEL(y1, x1);
+        d |= __SEL(0x80200802u, 0u);
+
+        // Entrelazado n0/n1 -> estados 2j..2j+7
+        // e = n0[0] n1[0] n0[2] n1[2], o = n0[1] n1[1] n0[3] n1[3]
+        uint32_t e = __UXTB16(n0) | (__UXTB16(n1) << 8);
+        uint32_t o = __UXTB16(__ROR(n0, 8u)) | (__UXTB16(__ROR(n1, 8u)) << 8);
+        new[2u * g]      = __PKHBT(e, o, 16);
+        new[2u * g + 1u] = __PKHTB(o, e, 16);
+
+        d |= d >> 16;
+        d |= d >> 8;
+        dec[g >> 2] |= (d & 0xFFu) << (8u * (g & 3u));
+    }
+}
+
+/**
+ * @brief Resta a todas las métricas su mínimo
+ * @return Valor restado
+ */
+static uint32_t viterbi_renorm(uint32_t *w)
+{
+    uint32_t m = w[0];
+    for (uint32_t i = 1; i < FEC_CONV_STATES / 4; i++)
+    {
+        __USUB8(m, w[i]);
+        m = __SEL(w[i], m);
+    }
+    uint32_t min = m & 0xFFu;
+    for (uint32_t k = 8; k < 32u; k += 8)
+    {
+        if (((m >> k) & 0xFFu) < min)
+        {
+            min = (m >> k) & 0xFFu;
+        }
+    }
+    uint32_t min4 = min * 0x01010101u;
+    for (uint32_t i = 0; i < FEC_CONV_STATES / 4; i++)
+    {
+        w[i] = __UQSUB8(w[i], min4);
+    }
+    return min;
+}
+
+#else /* versión escalar */
+
+static void viterbi_acs(const uint32_t *old, uint32_t *new,
+                        const uint32_t *bm, uint32_t *dec)
+{
+    const uint8_t *o8 = (const uint8_t *)old;
+    const uint8_t *m8 = (const uint8_t *)bm;
+    uint8_t *n8 = (uint8_t *)new;
+
+    for (uint32_t j = 0; j < FEC_CONV_STATES / 2; j++)
+    {
+        uint32_t m  = m8[j];
+        uint32_t mc = 2u - m;
+        uint32_t a  = o8[j];
+        uint32_t b  = o8[j + FEC_CONV_STATES / 2];
+
+        uint32_t x0 = a + m, y0 = b + mc;
+        uint32_t x1 = a + mc, y1 = b + m;
+        x0 = (x0 > 255u) ? 255u : x0;
+        y0 = (y0 > 255u) ? 255u : y0;
+        x1 = (x1 > 255u) ? 255u : x1;
+        y1 = (y1 > 255u) ? 255u : y1;
+
+        uint32_t s = 2u * j;
+        n8[s]      = (uint8_t)((x0 >= y0) ? y0 : x0);
+        n8[s + 1u] = (uint8_t)((x1 >= y1) ? y1 : x1);
+        dec[s >> 5] |= ((x0 >= y0) ? 1u : 0u) << (s & 31u);
+        dec[s >> 5] |= ((x1 >= y1) ? 1u : 0u) << ((s + 1u) & 31u);
+    }
+}
+
+static uint32_t viterbi_renorm(uint32_t *w)
+{
+    uint8_t *p = (uint8_t *)w;
+    uint8_t min = p[0];
+    for (uint32_t i = 1; i < FEC_CONV_STATES; i++)
+    {
+        if (p[i] < min)
+        {
+            min = p[i];
+        }
+    }
+    for (uint32_t i = 0; i < FEC_CONV_STATES; i++)
+    {
+        p[i] -= min;
+    }
+    return min;
+}
+
+#endif /* __ARM_FEATURE_SIMD32 */
+
+/** Estado de la decodificación en curso */
+static uint32_t vit_steps;             /**< Pasos dados */
+static uint32_t vit_offset;            /**< Suma de las renormalizaciones */
+static uint8_t vit_cur;                /**< Métricas vigentes: pm[vit_cur] */
+
+void fec_viterbi_start(void)
+{
+    if (!bm_tbl_ready)
+    {
+        viterbi_init_tables();
+    }
+
+    // El codificador arranca en el estado 0
+    for (uint32_t i = 0; i < FEC_CONV_STATES; i++)
+    {
+        pm[0].u8[i] = (i == 0u) ? 0u : VITERBI_INIT_PM;
+    }
+    vit_steps = 0;
+    vit_offset = 0;
+    vit_cur = 0;
+}
+
+int8_t fec_viterbi_step(uint8_t r0, uint8_t r1)
+{
+    uint32_t t = vit_steps;
+    if (t >= VITERBI_MAX_STEPS)
+    {
+        return -1;
+    }
+
+    uint8_t r = (uint8_t)(((r0 & 1u) << 1) | (r1 & 1u));
+    decisions[t][0] = 0;
+    decisions[t][1] = 0;
+    viterbi_acs(pm[vit_cur].u32, pm[vit_cur ^ 1u].u32, bm_tbl[r].u32, decisions[t]);
+    vit_cur ^= 1u;
+    if ((t % VITERBI_RENORM) == (VITERBI_RENORM - 1u))
+    {
+        vit_offset += viterbi_renorm(pm[vit_cur].u32);
+    }
+    vit_steps = t + 1u;
+    return 0;
+}
+
+int32_t fec_viterbi_finish(uint32_t nbytes, uint8_t *data)
+{
+    uint32_t steps = 8u * nbytes + (FEC_CONV_K - 1);
+    if ((nbytes > FEC_CONV_MAX_BYTES) || (vit_steps != steps))
+    {
+        return -1;
+    }
+
+    // Traceback desde el estado 0 (trellis terminado por los bits de cola)
+    for (uint32_t i = 0; i < nbytes; i++)
+    {
+        data[i] = 0;
+    }
+    uint8_t state = 0;
+    for (uint32_t t = steps; t-- > 0;)
+    {
+        uint8_t d = (uint8_t)((decisions[t][state >> 5] >> (state & 31u)) & 1u);
+        if (t < 8u * nbytes)
+        {
+            data[t >> 3] |= (uint8_t)((state & 1u) << (t & 7u));
+        }
+        state = (uint8_t)((state >> 1) | (d << 5));
+    }
+
+    return (int32_t)(vit_offset + pm[vit_cur].u8[0]);
+}
+
+int32_t fec_viterbi_decode(const uint8_t *sym, uint32_t nbytes, uint8_t *data)
+{
+    if (nbytes > FEC_CONV_MAX_BYTES)
+    {
+        return -1;
+    }
+
+    fec_viterbi_start();
+    for (uint32_t t = 0; t < 8u * nbytes + (FEC_CONV_K - 1); t++)
+    {
+        fec_viterbi_step(sym[2u * t], sym[2u * t + 1u]);
+    }
+    return fec_viterbi_finish(nbytes, data);
+}
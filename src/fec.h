@@ -0,0 +1,145 @@
+/**
+ * @file fec.h
+ * @date :2026/01/19 09:32:40
+ * @brief Corrección de errores (FEC) para el enlace FSK
+ *
+ * Etapa opcional entre el flujo de bytes y el flujo de bits del módem FSK.
+ * Dos modos:
+ * - Hamming(7,4): modo económico, corrige 1 bit por cada palabra de 7 bits.
+ *   Cada byte se transmite como dos palabras de código (14 bits).
+ * - Convolucional K=7, tasa 1/2 (polinomios 171/133 octal) con decodificador
+ *   de Viterbi en punto fijo: modo robusto, ganancia de codificación ~5 dB.
+ *
+ * Formato de los datos:
+ * - Datos de usuario: bytes empaquetados, LSB primero (como la UART 8N1).
+ * - Símbolos en el canal: un bit por byte (valores 0/1), que es lo que
+ *   produce el demodulador muestra a muestra.
+ *
+ * El enlace (fsk_link.h) lo usa por símbolos según llegan: el Viterbi avanza
+ * un paso por cada par recibido (fec_viterbi_step()) y solo el traceback se
+ * hace al final de la trama, para no bloquear el bucle con la trama entera.
+ *
+ * @note El bucle sumar-comparar-seleccionar (ACS) del Viterbi usa las
+ *       instrucciones SIMD de 8 bits del Cortex-M4 (__UQADD8, __USUB8, __SEL)
+ *       y procesa 4 mariposas por iteración. Si el compilador no soporta
+ *       SIMD (__ARM_FEATURE_SIMD32 no definido) se usa la versión escalar,
+ *       con resultados idénticos.
+ */
+
+#ifndef _FEC_H_
+#define _FEC_H_
+
+#include <stdint.h>
+
+/** Longitud de restricción del código convolucional */
+#define FEC_CONV_K          7
+/** Número de estados del trellis (2^(K-1)) */
+#define FEC_CONV_STATES     (1u << (FEC_CONV_K - 1))
+/** Polinomio generador G0 (171 octal) */
+#define FEC_CONV_G0         0x79u
+/** Polinomio generador G1 (133 octal) */
+#define FEC_CONV_G1         0x5Bu
+
+/** Máximo número de bytes de datos por trama convolucional */
+#define FEC_CONV_MAX_BYTES  32u
+/** Número de símbolos de canal para una trama de n bytes (incluye cola) */
+#define FEC_CONV_SYMBOLS(n) (2u * (8u * (n) + (FEC_CONV_K - 1)))
+
+/**
+ * @brief Modos de FEC disponibles
+ */
+typedef enum {
+    FEC_NONE = 0,      /**< Sin codificación */
+    FEC_HAMMING74,     /**< Hamming(7,4) */
+    FEC_CONV_K7        /**< Convolucional K=7 r=1/2 + Viterbi */
+} fec_mode_t;
+
+/**
+ * @brief Codifica un nibble en una palabra Hamming(7,4)
+ *
+ * @param nibble Dato de 4 bits (d3..d0)
+ * @return Palabra de 7 bits: bits 0..3 datos, bits 4..6 paridad
+ */
+uint8_t fec_hamming74_encode(uint8_t nibble);
+
+/**
+ * @brief Decodifica una palabra Hamming(7,4)
+ *
+ * @param code   Palabra de 7 bits recibida
+ * @param nibble Puntero donde se guarda el nibble corregido
+ * @return 0 sin errores, 1 si se ha corregido un bit
+ */
+uint8_t fec_hamming74_decode(uint8_t code, uint8_t *nibble);
+
+/**
+ * @brief Codifica un byte con Hamming(7,4) en 14 símbolos de canal
+ *
+ * @param byte Byte de datos
+ * @param sym  Array de 14 símbolos (0/1), nibble bajo primero
+ */
+void fec_hamming_encode_byte(uint8_t byte, uint8_t sym[14]);
+
+/**
+ * @brief Decodifica 14 símbolos de canal Hamming(7,4) en un byte
+ *
+ * @param sym  Array de 14 símbolos (0/1)
+ * @param byte Puntero donde se guarda el byte corregido
+ * @return Número de bits corregidos (0..2)
+ */
+uint8_t fec_hamming_decode_byte(const uint8_t sym[14], uint8_t *byte);
+
+/**
+ * @brief Codificador convolucional K=7 r=1/2 de una trama
+ *
+ * Añade K-1 bits de cola a cero para terminar el trellis en el estado 0.
+ *
+ * @param data   Bytes de datos
+ * @param nbytes Número de bytes (<= FEC_CONV_MAX_BYTES)
+ * @param sym    Array de salida con FEC_CONV_SYMBOLS(nbytes) símbolos (0/1)
+ * @return Número de símbolos generados, 0 si nbytes es demasiado grande
+ */
+uint32_t fec_conv_encode(const uint8_t *data, uint32_t nbytes, uint8_t *sym);
+
+/**
+ * @brief Decodificador de Viterbi (decisión dura) de una trama
+ *
+ * @param sym    Símbolos recibidos (0/1), FEC_CONV_SYMBOLS(nbytes) elementos
+ * @param nbytes Número de bytes de la trama (<= FEC_CONV_MAX_BYTES)
+ * @param data   Array de salida de nbytes bytes
+ * @return Métrica de camino del superviviente (nº de símbolos erróneos
+ *         corregidos), -1 si nbytes es demasiado grande
+ *
+ * @note Métricas de camino de 8 bits con renormalización periódica.
+ *       Memoria de decisiones: 8 bytes por bit decodificado (estática).
+ */
+int32_t fec_viterbi_decode(const uint8_t *sym, uint32_t nbytes, uint8_t *data);
+
+/**
+ * @brief Inicia la decodificación de Viterbi de una trama símbolo a símbolo
+ *
+ * @note Un único decodificador (estado estático), compartido con
+ *       fec_viterbi_decode().
+ */
+void fec_viterbi_start(void);
+
+/**
+ * @brief Un paso del trellis con un par de símbolos recibidos
+ *
+ * @param r0 Símbolo de G0 (0/1)
+ * @param r1 Símbolo de G1 (0/1)
+ * @return 0 si tiene éxito, -1 si la trama supera FEC_CONV_MAX_BYTES
+ */
+int8_t fec_viterbi_step(uint8_t r0, uint8_t r1);
+
+/**
+ * @brief Traceback de la trama iniciada con fec_viterbi_start()
+ *
+ * @param nbytes Número de bytes de la trama: deben haberse dado
+ *               FEC_CONV_SYMBOLS(nbytes) / 2 pasos
+ * @param data   Array de salida de nbytes bytes
+ * @return Métrica de camino del superviviente, -1 si el número de pasos no
+ *         corresponde a nbytes
+ */
+int32_t fec_viterbi_finish(uint32_t nbytes, uint8_t *data);
+
+#endif  /* _FEC_H_ */
@@ -0,0 +1,61 @@
+/**
+ * @file fsk_demod.c
+ * @date :2026/04/13 09:12:44
+ * @brief Demodulador FSK por autocorrelación a frecuencia de muestreo reducida
+ *
+ * Filtro DF2T con el producto p (Q15) como entrada y coeficientes en Q30:
+ * @code
+ *   y  = b0 p + s1
+ *   s1 = b1 p - a1 y + s2
+ *   s2 = b2 p - a2 y
+ * @endcode
+ * Los estados se guardan escalados por 2^30 (64 bits) y la salida y se
+ * redondea a Q15 antes de realimentarla.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "fsk_demod.h"
+
+int8_t fsk_demod_init(fsk_demod_t * const d, const dsp_params_t *p)
+{
+    if ((p == NULL) || (p->delay == 0u) || (p->delay > FSK_DEMOD_MAX_DELAY))
+    {
+        return -1;
+    }
+    for (uint8_t i = 0; i < FSK_DEMOD_MAX_DELAY; i++)
+    {
+        d->dly[i] = 0;
+    }
+    d->delay = (uint8_t)p->delay;
+    d->idx = 0;
+    d->b[0] = p->b[0];
+    d->b[1] = p->b[1];
+    d->b[2] = p->b[2];
+    d->a[0] = p->a[0];
+    d->a[1] = p->a[1];
+    d->s1 = 0;
+    d->s2 = 0;
+    d->y = 0;
+    return 0;
+}
+
+uint8_t fsk_demod_process(fsk_demod_t * const d, int16_t x)
+{
+    // Autocorrelación: x[n] * x[n - delay]
+    int32_t p = ((int32_t)x * d->dly[d->idx]) >> 15;
+    d->dly[d->idx] = x;
+    if (++d->idx == d->delay)
+    {
+        d->idx = 0;
+    }
+
+    // Paso bajo elíptico (DF2T)
+    int64_t acc = (int64_t)d->b[0] * p + d->s1;
+    int32_t y = (int32_t)((acc + (1 << 29)) >> 30);
+    d->s1 = (int64_t)d->b[1] * p - (int64_t)d->a[0] * y + d->s2;
+    d->s2 = (int64_t)d->b[2] * p - (int64_t)d->a[1] * y;
+    d->y = y;
+
+    return (y < 0) ? 1u : 0u;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file fsk_demod.h
+ * @date :2026/04/13 09:12:44
+ * @brief Demodulador FSK por autocorrelación a frecuencia de muestreo reducida
+ *
+ * Mismo algoritmo que lab5() (30319_shared.lib), pero en código fuente y
+ * parametrizado por un conjunto de dsp_params.h, de modo que puede trabajar
+ * sobre la salida del decimador (8 kHz) en lugar de a 48 kHz:
+ *  1) Producto de la entrada por la entrada retrasada (delay muestras, ~460 us):
+ *     negativo con la marca (1200 Hz) y positivo con el espacio (2200 Hz).
+ *  2) Filtro elíptico IIR de 2º orden (DF2T, coeficientes b/a en Q30).
+ *  3) Decisión con umbral 0: bit 1 (marca) si la salida es negativa.
+ *
+ * Con el decimador M = 6 delante, el receptor hace por muestra de 48 kHz las
+ * dos sumas del decimador CIC (decim_cic_process()) y una de cada 6 veces el
+ * demodulador, en lugar del demodulador completo en cada muestra.
+ *
+ * @note Muestras de entrada en Q15. Estados del filtro en 64 bits (SMLAL).
+ */
+
+#ifndef _FSK_DEMOD_H_
+#define _FSK_DEMOD_H_
+
+#include <stdint.h>
+#include "dsp_params.h"
+
+/** Máximo retardo soportado (muestras) */
+#define FSK_DEMOD_MAX_DELAY 48u
+
+/**
+ * @struct fsk_demod_t
+ * @brief Estado del demodulador
+ */
+typedef struct {
+    int16_t  dly[FSK_DEMOD_MAX_DELAY];   /**< Línea de retardo */
+    uint8_t  delay;                      /**< Retardo (muestras) */
+    uint8_t  idx;                        /**< Posición de la muestra más antigua */
+    int32_t  b[3];                       /**< Numerador (Q30) */
+    int32_t  a[2];                       /**< Denominador a1, a2 (Q30) */
+    int64_t  s1, s2;                     /**< Estados DF2T (producto x 2^30) */
+    int32_t  y;                          /**< Última salida del filtro (Q15) */
+} fsk_demod_t;
+
+/**
+ * @brief Inicializa el demodulador para una frecuencia de muestreo
+ *
+ * @param d Puntero al demodulador
+ * @param p Parámetros de la frecuencia de trabajo (dsp_params_get())
+ * @return 0 si tiene éxito, -1 si p es NULL o su retardo no cabe
+ */
+int8_t fsk_demod_init(fsk_demod_t * const d, const dsp_params_t *p);
+
+/**
+ * @brief Demodula una muestra
+ *
+ * @param d Puntero al demodulador
+ * @param x Muestra de entrada (Q15)
+ * @return Bit demodulado: 1 (marca) o 0 (espacio)
+ */
+uint8_t fsk_demod_process(fsk_demod_t * const d, int16_t x);
+
+#endif  /* _FSK_DEMOD_H_ */
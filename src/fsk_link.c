@@ -0,0 +1,332 @@
+/**
+ * @file fsk_link.c
+ * @date :2026/04/14 10:21:37
+ * @brief Enlace de datos sobre el módem FSK con corrección de errores (FEC)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "fsk_link.h"
+
+/** Estados del muestreador UART del receptor */
+enum {
+    RX_IDLE = 0,       /**< Esperando el flanco del start */
+    RX_START,          /**< Centro del start */
+    RX_DATA,           /**< Centro de los 8 bits de datos */
+    RX_STOP            /**< Centro del stop */
+};
+
+/**
+ * @brief Símbolos de una trama de n bytes en el modo dado
+ */
+static uint16_t link_symbols(fec_mode_t mode, uint8_t n)
+{
+    switch (mode)
+    {
+    case FEC_NONE:
+        return (uint16_t)(8u * n);
+    case FEC_HAMMING74:
+        return (uint16_t)(14u * n);
+    case FEC_CONV_K7:
+        return (uint16_t)FEC_CONV_SYMBOLS(n);
+    default:
+        return 0;
+    }
+}
+
+// =============================================================================
+// TRANSMISIÓN
+// =============================================================================
+
+int8_t fsk_link_tx_init(fsk_link_tx_t * const tx, fec_mode_t mode, const dsp_params_t *p)
+{
+    if ((p == NULL) || (link_symbols(mode, 1u) == 0u))
+    {
+        return -1;
+    }
+    tx->phaseinc[0] = p->phaseinc_space;
+    tx->phaseinc[1] = p->phaseinc_mark;
+    tx->bit_q8 = p->samples_bit_q8;
+    tx->t_q8 = 0;
+    tx->mode = mode;
+    tx->nsym = 0;
+    tx->nchars = 0;
+    tx->chr = 0;
+    tx->pos = 0;
+    tx->gap = 0;
+    tx->level = 1;
+    DDS16Bits_setPhase(&tx->dds, 0);
+    DDS16Bits_setPhaseInc(&tx->dds, tx->phaseinc[1]);
+    return 0;
+}
+
+uint8_t fsk_link_tx_busy(const fsk_link_tx_t * const tx)
+{
+    return ((tx->chr < tx->nchars) || (tx->gap != 0u)) ? 1u : 0u;
+}
+
+int8_t fsk_link_send(fsk_link_tx_t * const tx, const uint8_t *data, uint8_t n)
+{
+    if ((n == 0u) || (n > FSK_LINK_MAX_BYTES) || fsk_link_tx_busy(tx))
+    {
+        return -1;
+    }
+
+    uint16_t nsym = link_symbols(tx->mode, n);
+    switch (tx->mode)
+    {
+    case FEC_NONE:
+        for (uint16_t i = 0; i < nsym; i++)
+        {
+            tx->sym[i] = (data[i >> 3] >> (i & 7u)) & 1u;
+        }
+        break;
+    case FEC_HAMMING74:
+        for (uint8_t i = 0; i < n; i++)
+        {
+            fec_hamming_encode_byte(data[i], &tx->sym[14u * i]);
+        }
+        break;
+    default:
+        fec_conv_encode(data, n, tx->sym);
+        break;
+    }
+
+    tx->nsym = nsym;
+    tx->chr = 0;
+    tx->pos = 0;
+    tx->t_q8 = 0;                                 // start de un bit entero
+    tx->nchars = (uint16_t)((nsym + 7u) / 8u);
+    return 0;
+}
+
+/**
+ * @brief Nivel de la línea en el bit en curso
+ */
+static uint8_t link_tx_level(const fsk_link_tx_t * const tx)
+{
+    if (tx->chr >= tx->nchars)
+    {
+        return 1;                                 // reposo
+    }
+    if (tx->pos == 0u)
+    {
+        return 0;                                 // start
+    }
+    if (tx->pos == 9u)
+    {
+        return 1;                                 // stop
+    }
+    uint16_t i = (uint16_t)(8u * tx->chr + tx->pos - 1u);
+    return (i < tx->nsym) ? tx->sym[i] : 1u;     // relleno del último carácter
+}
+
+/**
+ * @brief Avanza al siguiente bit de la línea
+ */
+static void link_tx_next_bit(fsk_link_tx_t * const tx)
+{
+    if (tx->chr < tx->nchars)
+    {
+        if (++tx->pos == 10u)
+        {
+            tx->pos = 0;
+            if (++tx->chr == tx->nchars)
+            {
+                tx->gap = FSK_LINK_GAP_BITS;
+            }
+        }
+    }
+    else if (tx->gap != 0u)
+    {
+        tx->gap--;
+    }
+}
+
+int16_t fsk_link_tx_sample(fsk_link_tx_t * const tx)
+{
+    tx->t_q8 += 256u;
+    if (tx->t_q8 >= tx->bit_q8)
+    {
+        tx->t_q8 -= tx->bit_q8;
+        link_tx_next_bit(tx);
+    }
+
+    uint8_t level = link_tx_level(tx);
+    if (level != tx->level)
+    {
+        DDS16Bits_setPhaseInc(&tx->dds, tx->phaseinc[level]);
+        tx->level = level;
+    }
+    return DDS16Bits_getNextSample(&tx->dds);
+}
+
+// =============================================================================
+// RECEPCIÓN
+// =============================================================================
+
+int8_t fsk_link_rx_init(fsk_link_rx_t * const rx, fec_mode_t mode, uint8_t nbytes,
+                        const dsp_params_t *p)
+{
+    if ((p == NULL) || (nbytes == 0u) || (nbytes > FSK_LINK_MAX_BYTES) ||
+        (link_symbols(mode, nbytes) == 0u))
+    {
+        return -1;
+    }
+    rx->mode = mode;
+    rx->nbytes = nbytes;
+    rx->nsym = link_symbols(mode, nbytes);
+    rx->bit_q8 = p->samples_bit_q8;
+    rx->t_q8 = 0;
+    rx->next_q8 = 0;
+    rx->idle_q8 = 0;
+    rx->state = RX_IDLE;
+    rx->last = 0;                                 // espera a la marca antes del primer start
+    rx->k = 0;
+    rx->n = 0;
+    rx->r0 = 0;
+    rx->frames = 0;
+    rx->corrected = 0;
+    rx->framing_errors = 0;
+    rx->dropped = 0;
+    return 0;
+}
+
+/**
+ * @brief Entrega un símbolo al decodificador
+ */
+static void link_rx_symbol(fsk_link_rx_t * const rx, uint8_t s)
+{
+    uint16_t n = rx->n;
+
+    if (n >= rx->nsym)
+    {
+        return;                                   // relleno del último carácter
+    }
+    switch (rx->mode)
+    {
+    case FEC_NONE:
+        rx->acc[n & 7u] = s;
+        if ((n & 7u) == 7u)
+        {
+            uint8_t b = 0;
+            for (uint8_t i = 0; i < 8u; i++)
+            {
+                b |= (uint8_t)(rx->acc[i] << i);
+            }
+            rx->data[n >> 3] = b;
+        }
+        break;
+    case FEC_HAMMING74:
+        rx->acc[n % 14u] = s;
+        if ((n % 14u) == 13u)
+        {
+            rx->corrected += fec_hamming_decode_byte(rx->acc, &rx->data[n / 14u]);
+        }
+        break;
+    default:
+        if (n == 0u)
+        {
+            fec_viterbi_start();
+        }
+        if (n & 1u)
+        {
+            fec_viterbi_step(rx->r0, s);
+        }
+        else
+        {
+            rx->r0 = s;
+        }
+        break;
+    }
+    rx->n = n + 1u;
+}
+
+/**
+ * @brief Fin de carácter: completa la trama si ya están todos los símbolos
+ * @return 1 si se ha completado una trama
+ */
+static uint8_t link_rx_char_end(fsk_link_rx_t * const rx)
+{
+    if (rx->n < rx->nsym)
+    {
+        return 0;
+    }
+    if (rx->mode == FEC_CONV_K7)
+    {
+        int32_t metric = fec_viterbi_finish(rx->nbytes, rx->data);
+        rx->corrected += (metric > 0) ? (uint32_t)metric : 0u;
+    }
+    for (uint8_t i = 0; i < rx->nbytes; i++)
+    {
+        rx->frame[i] = rx->data[i];
+    }
+    rx->frames++;
+    rx->n = 0;
+    return 1;
+}
+
+uint8_t fsk_link_rx_bit(fsk_link_rx_t * const rx, uint8_t bit)
+{
+    uint8_t done = 0;
+
+    if (rx->state == RX_IDLE)
+    {
+        if ((rx->last != 0u) && (bit == 0u))
+        {
+            // Flanco del start: se muestrea en el centro de cada bit
+            rx->state = RX_START;
+            rx->t_q8 = 0;
+            rx->next_q8 = rx->bit_q8 / 2u;
+        }
+        else if (rx->n != 0u)
+        {
+            rx->idle_q8 += 256u;
+            if (rx->idle_q8 > (FSK_LINK_GAP_BITS / 2u) * rx->bit_q8)
+            {
+                rx->n = 0;                        // trama a medias: resincroniza
+                rx->dropped++;
+            }
+        }
+        rx->last = bit;
+        return 0;
+    }
+
+    rx->t_q8 += 256u;
+    if (rx->t_q8 >= rx->next_q8)
+    {
+        rx->next_q8 += rx->bit_q8;
+        switch (rx->state)
+        {
+        case RX_START:
+            if (bit == 0u)
+            {
+                rx->state = RX_DATA;
+                rx->k = 0;
+            }
+            else
+            {
+                rx->state = RX_IDLE;              // falso start (ruido)
+            }
+            break;
+        case RX_DATA:
+            link_rx_symbol(rx, bit);
+            if (++rx->k == 8u)
+            {
+                rx->state = RX_STOP;
+            }
+            break;
+        default:
+            if (bit == 0u)
+            {
+                rx->framing_errors++;
+            }
+            done = link_rx_char_end(rx);
+            rx->state = RX_IDLE;
+            rx->idle_q8 = 0;
+            break;
+        }
+    }
+    rx->last = bit;
+    return done;
+}
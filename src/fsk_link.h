@@ -0,0 +1,153 @@
+/**
+ * @file fsk_link.h
+ * @date :2026/04/14 10:21:37
+ * @brief Enlace de datos sobre el módem FSK con corrección de errores (FEC)
+ *
+ * Transmisión (fsk_link_send(), fsk_link_tx_sample()):
+ *  1) Codifica la trama según el modo fec_mode_t (fec.h): sin codificar
+ *     (8 símbolos por byte), Hamming(7,4) (14) o convolucional K=7
+ *     (FEC_CONV_SYMBOLS(n)).
+ *  2) Empaqueta los símbolos en caracteres UART 8N1 (8 símbolos por
+ *     carácter, LSB primero; el último se rellena con 1), seguidos.
+ *  3) Modula con el DDS (dds.h): marca = 1, espacio = 0, de fase continua.
+ *     Entre tramas la línea queda en reposo (marca) al menos
+ *     FSK_LINK_GAP_BITS bits.
+ *
+ * Recepción (fsk_link_rx_bit(), un bit demodulado por muestra):
+ *  1) Muestreador UART: flanco de bajada del start, muestras en el centro
+ *     de cada bit con samples_bit_q8 de la frecuencia del demodulador.
+ *  2) Cada símbolo se entrega al decodificador según llega: un paso de
+ *     Viterbi por par (fec_viterbi_step()), un byte cada 14 símbolos en
+ *     Hamming. El trabajo por muestra queda acotado.
+ *  3) Trama de longitud fija (nbytes, acordada en los dos extremos): al
+ *     completarse, traceback del Viterbi y la trama queda en frame[].
+ *  4) Resincronización: una trama a medias se descarta si la línea queda en
+ *     reposo más de FSK_LINK_GAP_BITS / 2 bits.
+ *
+ * @note La FEC corrige los símbolos de datos, no los errores en los bits de
+ *       start y stop: un carácter desalineado pierde la trama. Por eso, con
+ *       tramas de 10 bytes, el convolucional (más caracteres por trama) no
+ *       mejora al Hamming (test/host/test_fsk_link.c).
+ * @note El decodificador de Viterbi es único (estado estático de fec.c): un
+ *       solo receptor con FEC_CONV_K7.
+ */
+
+#ifndef _FSK_LINK_H_
+#define _FSK_LINK_H_
+
+#include <stdint.h>
+#include "dds.h"
+#include "dsp_params.h"
+#include "fec.h"
+
+/** Máximo número de bytes por trama */
+#define FSK_LINK_MAX_BYTES    16u
+/** Máximo número de símbolos por trama (convolucional, el más largo) */
+#define FSK_LINK_MAX_SYMBOLS  FEC_CONV_SYMBOLS(FSK_LINK_MAX_BYTES)
+/** Bits de reposo tras cada trama */
+#define FSK_LINK_GAP_BITS     24u
+
+/**
+ * @struct fsk_link_tx_t
+ * @brief Estado del transmisor
+ */
+typedef struct {
+    dds16bits_t dds;                         /**< Oscilador */
+    uint16_t phaseinc[2];                    /**< Incremento de fase: espacio, marca */
+    uint32_t bit_q8;                         /**< Muestras por bit (Q8) */
+    uint32_t t_q8;                           /**< Muestras del bit en curso (Q8) */
+    fec_mode_t mode;                         /**< Codificación */
+    uint16_t nsym;                           /**< Símbolos de la trama */
+    uint16_t nchars;                         /**< Caracteres UART de la trama */
+    uint16_t chr;                            /**< Carácter en curso */
+    uint8_t pos;                             /**< Bit del carácter: 0 start, 1..8, 9 stop */
+    uint8_t gap;                             /**< Bits de reposo que faltan */
+    uint8_t level;                           /**< Nivel de la línea (1 marca) */
+    uint8_t sym[FSK_LINK_MAX_SYMBOLS];       /**< Símbolos de la trama */
+} fsk_link_tx_t;
+
+/**
+ * @struct fsk_link_rx_t
+ * @brief Estado del receptor y estadísticas
+ */
+typedef struct {
+    fec_mode_t mode;                         /**< Codificación */
+    uint8_t nbytes;                          /**< Bytes por trama */
+    uint16_t nsym;                           /**< Símbolos por trama */
+    uint32_t bit_q8;                         /**< Muestras por bit (Q8) */
+    uint32_t t_q8;                           /**< Muestras desde el start (Q8) */
+    uint32_t next_q8;                        /**< Instante de la siguiente muestra */
+    uint32_t idle_q8;                        /**< Tiempo en reposo (Q8) */
+    uint8_t state;                           /**< Estado del muestreador UART */
+    uint8_t last;                            /**< Bit anterior */
+    uint8_t k;                               /**< Bit de datos del carácter */
+    uint16_t n;                              /**< Símbolos recibidos de la trama */
+    uint8_t r0;                              /**< Primer símbolo del par (Viterbi) */
+    uint8_t acc[14];                         /**< Símbolos del byte en curso */
+    uint8_t data[FSK_LINK_MAX_BYTES];        /**< Trama en recepción */
+    uint8_t frame[FSK_LINK_MAX_BYTES];       /**< Última trama recibida */
+    uint32_t frames;                         /**< Tramas recibidas */
+    uint32_t corrected;                      /**< Símbolos corregidos (acumulado) */
+    uint32_t framing_errors;                 /**< Bits de stop a 0 */
+    uint32_t dropped;                        /**< Tramas incompletas descartadas */
+} fsk_link_rx_t;
+
+/**
+ * @brief Inicializa el transmisor
+ *
+ * @param tx   Puntero al transmisor
+ * @param mode Codificación
+ * @param p    Parámetros de la frecuencia de muestreo de salida
+ * @return 0 si tiene éxito, -1 si p es NULL o el modo no es válido
+ */
+int8_t fsk_link_tx_init(fsk_link_tx_t * const tx, fec_mode_t mode, const dsp_params_t *p);
+
+/**
+ * @brief Codifica una trama y la pone en cola de transmisión
+ *
+ * @param tx   Puntero al transmisor
+ * @param data Bytes de la trama
+ * @param n    Número de bytes (1..FSK_LINK_MAX_BYTES)
+ * @return 0 si tiene éxito, -1 si está ocupado (trama o reposo en curso) o
+ *         n no es válido
+ */
+int8_t fsk_link_send(fsk_link_tx_t * const tx, const uint8_t *data, uint8_t n);
+
+/**
+ * @brief Indica si hay una trama (o su reposo posterior) en curso
+ *
+ * @param tx Puntero al transmisor
+ * @return 1 si está ocupado, 0 si acepta una trama
+ */
+uint8_t fsk_link_tx_busy(const fsk_link_tx_t * const tx);
+
+/**
+ * @brief Genera la siguiente muestra de la señal
+ *
+ * @param tx Puntero al transmisor
+ * @return Muestra (Q15)
+ */
+int16_t fsk_link_tx_sample(fsk_link_tx_t * const tx);
+
+/**
+ * @brief Inicializa el receptor
+ *
+ * @param rx     Puntero al receptor
+ * @param mode   Codificación
+ * @param nbytes Bytes por trama (1..FSK_LINK_MAX_BYTES)
+ * @param p      Parámetros de la frecuencia del demodulador
+ * @return 0 si tiene éxito, -1 si algún parámetro no es válido
+ */
+int8_t fsk_link_rx_init(fsk_link_rx_t * const rx, fec_mode_t mode, uint8_t nbytes,
+                        const dsp_params_t *p);
+
+/**
+ * @brief Procesa un bit demodulado
+ *
+ * @param rx  Puntero al receptor
+ * @param bit Bit demodulado (0/1), uno por muestra del demodulador
+ * @return 1 si se ha completado una trama (en rx->frame), 0 en otro caso
+ */
+uint8_t fsk_link_rx_bit(fsk_link_rx_t * const rx, uint8_t bit);
+
+#endif  /* _FSK_LINK_H_ */
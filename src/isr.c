@@ -7,20 +7,41 @@
  * incluyendo:
  * - ISR del periférico I2S para gestión de audio streaming
  * - ISR de interrupción no enmascarable (NMI) del Hardware Watchdog
+ * - ISR de las excepciones de fallo (HardFault, MemManage, BusFault, UsageFault)
  *
  * El sistema utiliza interrupciones para:
  * 1. Transferencia eficiente de datos de audio entre buffers circulares y códec WM8731
  * 2. Detección de fallos críticos mediante el Hardware Watchdog (HWWDT)
+ * 3. Registro post-mortem de las excepciones de fallo del Cortex-M4
  *
  * @section isr_i2s ISR del periférico I2S (PRGCRC_I2S_IRQHandler)
  * Gestiona las transferencias de audio bidireccionales:
  * - TX: Extrae muestras del buffer circular y las envía al códec
  * - RX: Lee muestras del códec y las almacena en el buffer circular
  *
+ * El vector es compartido con la unidad CRC (PRGCRC). El driver HAL_FM4_crc
+ * trabaja en modo síncrono y no habilita su interrupción, por lo que la ISR
+ * solo atiende eventos de I2S.
+ *
+ * @section isr_systick ISR de SysTick (SysTick_Handler)
+ * - Avanza el contador de ticks de 64 bits de HAL_SysTick (base de 1 ms)
+ * - Con _USE_KERNEL_ avanza también la base de tiempos del ejecutivo
+ *   expulsivo (kernel_tick); la ISR de I2S activa el hilo de audio cada
+ *   CIRC_BUF_SIZE / 2 muestras
+ *
+ * @section isr_fault ISR de fallo (HardFault, MemManage, BusFault, UsageFault)
+ * - Guardan el registro post-mortem con los registros de fallo del SCB y un
+ *   recorrido acotado de la pila
+ * - Esperan el reset del HWWDT (el bucle principal ya no lo alimenta). Si
+ *   el HWWDT no está en marcha (SystemInit() lo para y main lo arranca
+ *   después), resetean con NVIC_SystemReset()
+ *
  * @section isr_nmi ISR de NMI (NMI_Handler)
  * Captura el estado del sistema cuando el watchdog detecta un fallo:
- * - Almacena el estado de los buffers circulares para diagnóstico post-mortem
- * - Espera el reset automático del sistema por el HWWDT
+ * - Guarda el registro post-mortem en .noinit (crash.h): marco apilado,
+ *   registros de fallo, buffers circulares y últimos eventos de la traza
+ * - Espera el reset automático del sistema por el HWWDT, o resetea con
+ *   NVIC_SystemReset() si el HWWDT no va a resetear (RESEN = 0)
  *
  * @note Frecuencia de muestreo de audio: 48 kHz
  * @note Las ISR deben ejecutarse lo más rápido posible para no perder muestras
@@ -30,79 +51,154 @@
  */
 
 // Cabeceras de los módulos propios
+#include "boot_prof.h"
 #include "circ_buf.h"
+#include "crash.h"
+#include "trace.h"
+#include "wdt_sup.h"
+#ifdef _USE_KERNEL_
+#include "kernel.h"
+#endif
 // Cabeceras de los módulos HAL y BSP
 #include "FM4_WM8731.h"
 #include "HAL_FM4_i2s.h"
 #include "HAL_FM4_hwwdt.h"
+#include "HAL_SysTick.h"
 // Cabeceras estándar
 #include <stdint.h>
 
 
+#ifdef _USE_KERNEL_
+extern kernel_task_t * const g_audio_thread;  ///< Hilo de audio (main.c)
+#endif
+
+
 // =============================================================================
-// VARIABLES GLOBALES PARA DIAGNÓSTICO POST-MORTEM
+// RUTINAS DE SERVICIO DE INTERRUPCIÓN
 // =============================================================================
 
+
 /**
- * @brief Variables de diagnóstico del estado de los buffers circulares
+ * @brief Parte en C de la ISR de NMI
+ *
+ * Si la NMI la ha generado el Hardware Watchdog, guarda el registro
+ * post-mortem (crash.h), con las tareas retrasadas del supervisor
+ * (wdt_sup_late()) como dato, y se queda en bucle infinito hasta el reset
+ * del HWWDT. Si el HWWDT no va a resetear (HWWDT_IsRunning() = 0),
+ * resetea con NVIC_SystemReset().
+ *
+ * @param frame      Marco apilado por la excepción (r0-r3, r12, LR, PC, xPSR)
+ * @param exc_return Valor de LR a la entrada de la excepción
  *
- * Estas variables se utilizan en el manejador NMI para capturar el estado
- * de los buffers circulares en el momento en que el HWWDT detecta un fallo.
+ * @note El registro sobrevive al reset en la sección .noinit; main lo
+ *       valida al arrancar con crash_boot_read()
  *
- * @note Deben declararse en sección .noinit para preservar sus valores
- *       tras un reset del sistema
+ * @warning Si esta función se ejecuta, indica que el sistema no ha alimentado
+ *          el watchdog a tiempo, señal de un posible bloqueo o mal funcionamiento
  */
-uint8_t g_tx_buf_empty;  ///< Estado del buffer TX: 1 = vacío, 0 = no vacío
-uint8_t g_tx_buf_full;   ///< Estado del buffer TX: 1 = lleno, 0 = no lleno
-uint8_t g_rx_buf_empty;  ///< Estado del buffer RX: 1 = vacío, 0 = no vacío
-uint8_t g_rx_buf_full;   ///< Estado del buffer RX: 1 = lleno, 0 = no lleno
-
-
-// =============================================================================
-// RUTINAS DE SERVICIO DE INTERRUPCIÓN
-// =============================================================================
+__attribute__((used)) void NMI_Handler_C(const uint32_t *frame, uint32_t exc_return)
+{
+  if (HWWDT_GetIntStatus()) {
+    crash_save(CRASH_HWWDT, wdt_sup_late(), frame, exc_return);
+    if (!HWWDT_IsRunning()) {
+      NVIC_SystemReset();
+    }
+    while(1); // Espera el reset del HWWDT
+  }
+}
 
 
 /**
  * @brief ISR de interrupción no enmascarable (NMI)
  *
- * Esta función se ejecuta cuando ocurre una interrupción NMI, típicamente
- * generada por el Hardware Watchdog (HWWDT) antes de provocar un reset del sistema.
+ * Se ejecuta cuando ocurre una interrupción NMI, típicamente generada por el
+ * Hardware Watchdog (HWWDT) antes de provocar un reset del sistema.
+ * Localiza el marco apilado (MSP o PSP según EXC_RETURN) y pasa a
+ * NMI_Handler_C() su dirección y EXC_RETURN.
  *
- * Comportamiento según configuración:
+ * @note Esta ISR tiene la máxima prioridad configurable en el sistema Cortex-M
+ * @note El HWWDT debe estar configurado para generar interrupción NMI antes del reset
+ */
+__attribute__((naked)) void NMI_Handler(void)
+{
+  __asm volatile(
+      "tst     lr, #4              \n"
+      "ite     eq                  \n"
+      "mrseq   r0, msp             \n"
+      "mrsne   r0, psp             \n"
+      "mov     r1, lr              \n"
+      "b       NMI_Handler_C       \n"
+  );
+}
+
+
+/**
+ * @brief Parte en C de las ISR de fallo (HardFault, MemManage, BusFault y
+ *        UsageFault)
  *
- * - Captura el estado de los buffers circulares para diagnóstico post-mortem:
- *   - g_tx_buf_empty: indica si el buffer de transmisión estaba vacío
- *   - g_tx_buf_full: indica si el buffer de transmisión estaba lleno
- *   - g_rx_buf_empty: indica si el buffer de recepción estaba vacío
- *   - g_rx_buf_full: indica si el buffer de recepción estaba lleno
- * - Entra en bucle infinito esperando el reset por HWWDT
- * - Las variables globales permiten análisis post-mortem tras el reset
+ * Obtiene la causa del número de excepción (IPSR), guarda el registro
+ * post-mortem (marco, CFSR/HFSR/MMFAR/BFAR y recorrido de la pila) y se
+ * queda en bucle infinito: el bucle principal deja de alimentar el HWWDT,
+ * que resetea el MCU. La NMI del HWWDT no sobrescribe el registro.
  *
- * @note Esta ISR tiene la máxima prioridad en el sistema Cortex-M
- * @note El HWWDT debe estar configurado para generar interrupción NMI antes del reset
- * @note Las variables g_tx_buf_* y g_rx_buf_* deben estar
- *       en sección .noinit para preservar sus valores tras el reset
+ * SystemInit() para el HWWDT y main lo arranca después de inicializar los
+ * periféricos: un fallo antes de HWWDT_Start() (o con RESEN = 0) resetea
+ * con NVIC_SystemReset() en lugar de quedarse en el bucle para siempre.
  *
- * @warning Si esta función se ejecuta, indica que el sistema no ha alimentado
- *          el watchdog a tiempo, señal de un posible bloqueo o mal funcionamiento
+ * @param frame      Marco apilado por la excepción
+ * @param exc_return Valor de LR a la entrada de la excepción
+ */
+__attribute__((used)) void Fault_Handler_C(const uint32_t *frame, uint32_t exc_return)
+{
+  uint32_t reason;
+  switch (__get_IPSR() & 0x1FFu) {
+    case 4:  reason = CRASH_MEMMANAGE;  break;
+    case 5:  reason = CRASH_BUSFAULT;   break;
+    case 6:  reason = CRASH_USAGEFAULT; break;
+    default: reason = CRASH_HARDFAULT;  break;
+  }
+  crash_save(reason, 0, frame, exc_return);
+  if (!HWWDT_IsRunning()) {
+    NVIC_SystemReset();      // HWWDT parado: no llegaría ningún reset
+  }
+  while(1); // Espera el reset del HWWDT
+}
+
+/**
+ * @brief Entrada común de las ISR de fallo: localiza el marco apilado (MSP
+ *        o PSP según EXC_RETURN) y salta a Fault_Handler_C()
  */
-// void NMI_Handler(void)
-// {
+#define FAULT_HANDLER(name)                           \
+  __attribute__((naked)) void name(void)              \
+  {                                                   \
+    __asm volatile(                                   \
+        "tst     lr, #4              \n"              \
+        "ite     eq                  \n"              \
+        "mrseq   r0, msp             \n"              \
+        "mrsne   r0, psp             \n"              \
+        "mov     r1, lr              \n"              \
+        "b       Fault_Handler_C     \n"              \
+    );                                                \
+  }
+
+FAULT_HANDLER(HardFault_Handler)
+FAULT_HANDLER(MemManage_Handler)
+FAULT_HANDLER(BusFault_Handler)
+FAULT_HANDLER(UsageFault_Handler)
 
-    /**
-     * @brief    *
-     * TODO:
-     *   Implementa el algoritmo:
-     *
-     *      si (si la NMI fue generada por el Hardware Watchdog)
-     *        {
-     *            registrar estado de buffers circulares para diagnóstico post-mortem
-     *            detener la ejecución (bucle infinito), espera reset de HWWDT
-     *        }
-     */
 
-// }
+/**
+ * @brief ISR de SysTick: base de tiempos de 1 ms
+ *
+ * @note Solo se ejecuta si SysTick se ha configurado con SysTick_InitIRQ()
+ */
+void SysTick_Handler(void)
+{
+  SysTick_IncTick();
+#ifdef _USE_KERNEL_
+  kernel_tick();
+#endif
+}
 
 
 /**
@@ -124,6 +220,7 @@ uint8_t g_rx_buf_full;   ///< Estado del buffer RX: 1 = lleno, 0 = no lleno
  *
  * @note Esta función se ejecuta en contexto de interrupción
  * @note Debe ser lo más rápida posible para no perder muestras
+ * @note Solo registra TRACE_I2S_BEGIN/END si TRACE_I2S_DIV != 0 (trace.h)
  * @note Los buffers circulares g_tx_buffer y g_rx_buffer deben estar correctamente inicializados
  *
  * @warning Si los buffers están vacíos (TX) o llenos (RX), detiene la ejecución
@@ -136,6 +233,15 @@ uint8_t g_rx_buf_full;   ///< Estado del buffer RX: 1 = lleno, 0 = no lleno
  */
 void PRGCRC_I2S_IRQHandler(void)
 {
+#if TRACE_I2S_DIV
+  static uint16_t trace_i2s_n = 0;
+  uint8_t trace_i2s = (++trace_i2s_n >= TRACE_I2S_DIV);
+  if (trace_i2s) {
+    trace_i2s_n = 0;
+    trace(TRACE_I2S_BEGIN, 0);
+  }
+#endif
+  wdt_sup_checkin(WDT_SUP_I2S);
 
   // ---------------------------------------------------------------------------
   // GESTIÓN DE TRANSMISIÓN I2S (TX)
@@ -174,6 +280,7 @@ void PRGCRC_I2S_IRQHandler(void)
     // Leer muestra del códec WM8731
     int16_t chL_rx, chR_rx;  // Canal izquierdo y derecho
     FM4_WM8731_rd(&chL_rx, &chR_rx);
+    boot_first_sample();     // tiempo hasta la primera muestra (solo la primera vez)
 
     // Almacenar solo el canal izquierdo en el buffer circular
     uint8_t error_push = circ_buf_push(&g_rx_buffer, chL_rx);
@@ -189,6 +296,20 @@ void PRGCRC_I2S_IRQHandler(void)
       //__BKPT(3); // Breakpoint de error crítico
       while(1); // Dejo de alimentar al hwwdt. Error crítico
     }
+
+#ifdef _USE_KERNEL_
+    // Activa el hilo de audio con medio buffer acumulado
+    static uint8_t rx_count = 0;
+    if (++rx_count == CIRC_BUF_SIZE / 2) {
+      rx_count = 0;
+      kernel_signal(g_audio_thread);
+    }
+#endif
+  }
+#if TRACE_I2S_DIV
+  if (trace_i2s) {
+    trace(TRACE_I2S_END, 0);
   }
+#endif
 }
 // EOF
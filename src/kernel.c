@@ -0,0 +1,347 @@
+/**
+ * @file kernel.c
+ * @date :2026/02/23 09:15:42
+ * @brief Ejecutivo expulsivo de prioridades fijas (SysTick + PendSV)
+ *
+ * Marco de pila de un hilo expulsado (PSP, de direcciones bajas a altas):
+ * @code
+ *   [s16-s31]                  solo si EXC_RETURN bit 4 = 0
+ *   r4-r11, EXC_RETURN         guardados por PendSV_Handler
+ *   r0-r3, r12, lr, pc, xpsr   apilados por el hardware
+ *   [s0-s15, fpscr, reservado] solo si EXC_RETURN bit 4 = 0
+ * @endcode
+ *
+ * Los tiempos en ciclos (periodos y plazos de hasta 65 s a 200 MHz) se
+ * calculan en 64 bits.
+ *
+ * Solo se compila con _USE_KERNEL_ (el planificador cooperativo no lo usa).
+ * Salvo PendSV_Handler, el código es C portable y se prueba en el host
+ * (test/host/test_kernel.c).
+ */
+
+#ifdef _USE_KERNEL_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "mcu.h"
+#include "kernel.h"
+#include "trace.h"
+
+/** Palabras del marco inicial: r4-r11, EXC_RETURN + marco hardware */
+#define FRAME_WORDS     17u
+/** Retorno a modo hilo con PSP y sin contexto FPU */
+#define EXC_RETURN_PSP  0xFFFFFFFDu
+
+static kernel_task_t *kernel_tcb;             /**< Bloques de control */
+static uint8_t kernel_n;                      /**< Número de tareas */
+static kernel_task_t kernel_idle;             /**< Tarea de fondo (main) */
+static kernel_task_t *kernel_current;         /**< Hilo en ejecución */
+static kernel_task_t *volatile kernel_next;   /**< Hilo elegido por el planificador */
+static volatile uint32_t kernel_ms;           /**< Base de tiempos (ms) */
+static uint32_t cycles_us;                    /**< Ciclos por microsegundo */
+
+/** Pila de excepciones: las ISR dejan de usar la pila de main */
+static uint64_t kernel_msp[KERNEL_MSP_WORDS / 2u];
+
+/**
+ * @brief Elige el hilo listo más prioritario y solicita PendSV si cambia
+ * @note Llamar con interrupciones deshabilitadas
+ */
+static void kernel_schedule(void)
+{
+    if (kernel_current == NULL)
+    {
+        return;   // kernel_start() aún no se ha llamado
+    }
+
+    kernel_task_t *t = &kernel_idle;
+    for (uint8_t i = 0; i < kernel_n; i++)
+    {
+        if ((kernel_tcb[i].pending != 0u) || kernel_tcb[i].active)
+        {
+            t = &kernel_tcb[i];
+            break;
+        }
+    }
+    kernel_next = t;
+    if (t != kernel_current)
+    {
+        SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    }
+}
+
+/**
+ * @brief Nueva activación de una tarea
+ * @note Llamar con interrupciones deshabilitadas
+ */
+static void kernel_release(kernel_task_t *t)
+{
+    if (t->pending == 0u)
+    {
+        t->release = DWT->CYCCNT;
+    }
+    if (t->cfg->period_ms == 0u)
+    {
+        t->pending = 1;   // eventos: se agrupan en una activación
+    }
+    else
+    {
+        if ((t->pending != 0u) || t->active)
+        {
+            t->misses++;   // la activación anterior no ha terminado
+        }
+        t->pending++;
+    }
+}
+
+/**
+ * @brief Cuerpo común de los hilos: una llamada a la tarea por activación
+ */
+static void kernel_thread(kernel_task_t *t)
+{
+    const kernel_task_cfg_t *c = t->cfg;
+    uint32_t deadline_us = (c->deadline_us != 0u) ? c->deadline_us
+                         : (c->period_ms != 0u)   ? 1000u * c->period_ms
+                                                  : c->interarrival_us;
+    uint64_t deadline = (uint64_t)deadline_us * cycles_us;
+
+    for (;;)
+    {
+        __disable_irq();
+        t->active = 0;
+        while (t->pending == 0u)
+        {
+            // Bloqueado: PendSV cede la CPU al habilitar interrupciones
+            kernel_schedule();
+            __enable_irq();
+            __disable_irq();
+        }
+        t->pending--;
+        t->active = 1;
+        uint32_t release = t->release;
+        uint32_t exec0 = t->exec + (DWT->CYCCNT - t->slice);
+        __enable_irq();
+
+        c->callback();
+
+        __disable_irq();
+        uint32_t now = DWT->CYCCNT;
+        uint32_t exec = t->exec + (now - t->slice) - exec0;
+        uint32_t resp = now - release;
+        __enable_irq();
+
+        t->runs++;
+        if (exec > t->wcet)
+        {
+            t->wcet = exec;
+        }
+        if (resp > t->resp_max)
+        {
+            t->resp_max = resp;
+        }
+        if ((deadline != 0u) && (resp > deadline))
+        {
+            t->misses++;
+        }
+    }
+}
+
+int8_t kernel_init(const kernel_task_cfg_t *cfg, kernel_task_t *tcb, uint8_t n)
+{
+    if (n > KERNEL_MAX_TASKS)
+    {
+        return -1;
+    }
+
+    // Contador de ciclos del DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    cycles_us = SystemCoreClock / 1000000u;
+
+    for (uint8_t i = 0; i < n; i++)
+    {
+        const kernel_task_cfg_t *c = &cfg[i];
+        if ((c->stack == NULL) || (c->stack_bytes < 4u * (FRAME_WORDS + 8u)))
+        {
+            return -1;
+        }
+
+        // Marco inicial: como si el hilo hubiera sido expulsado antes de empezar
+        uint32_t *sp = (uint32_t *)((uint8_t *)c->stack + (c->stack_bytes & ~7u));
+        *--sp = 0x01000000u;                               // xPSR (bit T)
+        *--sp = (uint32_t)(uintptr_t)kernel_thread & ~1u;  // pc
+        *--sp = 0;                                         // lr
+        *--sp = 0;                                         // r12
+        *--sp = 0;                                         // r3
+        *--sp = 0;                                         // r2
+        *--sp = 0;                                         // r1
+        *--sp = (uint32_t)(uintptr_t)&tcb[i];              // r0 = t
+        *--sp = EXC_RETURN_PSP;                            // EXC_RETURN
+        for (uint8_t r = 0; r < 8u; r++)
+        {
+            *--sp = 0;                                     // r11-r4
+        }
+
+        tcb[i].sp = sp;
+        tcb[i].cfg = c;
+        tcb[i].pending = 0;
+        tcb[i].next_release = c->period_ms;
+        tcb[i].active = 0;
+        tcb[i].exec = 0;
+        tcb[i].slice = 0;
+        tcb[i].runs = 0;
+        tcb[i].wcet = 0;
+        tcb[i].resp_max = 0;
+        tcb[i].misses = 0;
+        tcb[i].rta = 0;
+    }
+
+    kernel_tcb = tcb;
+    kernel_n = n;
+    kernel_ms = 0;
+    return 0;
+}
+
+void kernel_start(void)
+{
+    __disable_irq();
+
+    // PendSV la menos prioritaria (SysTick justo por encima, SysTick_InitIRQ)
+    NVIC_SetPriority(PendSV_IRQn, (1u << __NVIC_PRIO_BITS) - 1u);
+
+    // main continúa en PSP sobre su pila; las excepciones pasan a kernel_msp
+    __set_PSP(__get_MSP());
+    __set_CONTROL(__get_CONTROL() | CONTROL_SPSEL_Msk);
+    __ISB();
+    __set_MSP((uint32_t)(uintptr_t)&kernel_msp[KERNEL_MSP_WORDS / 2u]);
+
+    kernel_idle.cfg = NULL;
+    kernel_idle.slice = DWT->CYCCNT;
+    kernel_current = &kernel_idle;
+    kernel_next = &kernel_idle;
+    __enable_irq();
+}
+
+void kernel_tick(void)
+{
+    uint8_t released = 0;
+
+    __disable_irq();
+    kernel_ms++;
+    for (uint8_t i = 0; i < kernel_n; i++)
+    {
+        kernel_task_t *t = &kernel_tcb[i];
+        uint16_t period = t->cfg->period_ms;
+        if ((period != 0u) && (kernel_ms == t->next_release))
+        {
+            t->next_release += period;
+            kernel_release(t);
+            released = 1;
+        }
+    }
+    if (released)
+    {
+        kernel_schedule();
+    }
+    __enable_irq();
+}
+
+void kernel_signal(kernel_task_t *t)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    kernel_release(t);
+    kernel_schedule();
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Cambio de hilo (llamada desde PendSV_Handler)
+ *
+ * @param sp Pila del hilo saliente, con su contexto ya guardado
+ * @return Pila del hilo entrante
+ */
+__attribute__((used)) uint32_t *kernel_switch(uint32_t *sp)
+{
+    __disable_irq();
+    uint32_t now = DWT->CYCCNT;
+    kernel_current->exec += now - kernel_current->slice;
+    kernel_current->sp = sp;
+    kernel_current = kernel_next;
+    kernel_current->slice = now;
+    trace(TRACE_THREAD_VALUE, (kernel_current == &kernel_idle)
+                              ? 0xFFFFu : (uint16_t)(kernel_current - kernel_tcb));
+    sp = kernel_current->sp;
+    __enable_irq();
+    return sp;
+}
+
+#ifdef __arm__
+/**
+ * @brief Cambio de contexto
+ *
+ * Guarda r4-r11 y EXC_RETURN (y s16-s31 si el hilo usa la FPU) en la pila
+ * del hilo saliente y los recupera de la del hilo entrante.
+ */
+__attribute__((naked)) void PendSV_Handler(void)
+{
+    __asm volatile(
+        "mrs     r0, psp             \n"
+        "tst     lr, #0x10           \n"
+        "it      eq                  \n"
+        "vstmdbeq r0!, {s16-s31}     \n"
+        "stmdb   r0!, {r4-r11, lr}   \n"
+        "bl      kernel_switch       \n"
+        "ldmia   r0!, {r4-r11, lr}   \n"
+        "tst     lr, #0x10           \n"
+        "it      eq                  \n"
+        "vldmiaeq r0!, {s16-s31}     \n"
+        "msr     psp, r0             \n"
+        "bx      lr                  \n"
+    );
+}
+#endif
+
+uint8_t kernel_rta(void)
+{
+    uint64_t period[KERNEL_MAX_TASKS];
+    uint8_t failed = 0;
+
+    for (uint8_t i = 0; i < kernel_n; i++)
+    {
+        const kernel_task_cfg_t *c = kernel_tcb[i].cfg;
+        period[i] = (uint64_t)((c->period_ms != 0u) ? 1000u * c->period_ms
+                                                    : c->interarrival_us) * cycles_us;
+    }
+
+    for (uint8_t i = 0; i < kernel_n; i++)
+    {
+        const kernel_task_cfg_t *c = kernel_tcb[i].cfg;
+        uint64_t deadline = (c->deadline_us != 0u) ? (uint64_t)c->deadline_us * cycles_us
+                                                   : period[i];
+        uint64_t r = kernel_tcb[i].wcet;
+        uint64_t prev = 0;
+
+        // Iteración de punto fijo; interferencia de las más prioritarias
+        while ((r != prev) && (r <= deadline))
+        {
+            prev = r;
+            r = kernel_tcb[i].wcet;
+            for (uint8_t j = 0; j < i; j++)
+            {
+                if (period[j] != 0u)
+                {
+                    r += ((prev + period[j] - 1u) / period[j]) * kernel_tcb[j].wcet;
+                }
+            }
+        }
+        kernel_tcb[i].rta = (r > UINT32_MAX) ? UINT32_MAX : (uint32_t)r;
+        if ((r > deadline) && (failed == 0u))
+        {
+            failed = i + 1u;
+        }
+    }
+    return failed;
+}
+
+#endif  /* _USE_KERNEL_ */
@@ -0,0 +1,121 @@
+/**
+ * @file kernel.h
+ * @date :2026/02/23 09:15:42
+ * @brief Ejecutivo expulsivo de prioridades fijas (SysTick + PendSV)
+ *
+ * Alternativa al planificador cooperativo (scheduler.h) para cuando una
+ * tarea lenta no puede retrasar a las tareas de la frecuencia de muestreo.
+ * Se activa compilando con _USE_KERNEL_.
+ *
+ * - Cada tarea es un hilo con su propia pila (PSP) que ejecuta la función de
+ *   la tarea una vez por activación.
+ * - Prioridades fijas: orden de la tabla, la primera es la más prioritaria.
+ * - Activación periódica desde kernel_tick() (SysTick_Handler, 1 ms) o por
+ *   evento con kernel_signal() (desde una ISR, p.ej. I2S).
+ * - El cambio de contexto se hace en PendSV, con la prioridad más baja, de
+ *   forma que nunca interrumpe a otra ISR.
+ * - Contexto FPU opcional: los registros s16-s31 solo se guardan si el hilo
+ *   ha usado la FPU (EXC_RETURN bit 4 = 0, apilado perezoso del Cortex-M4F).
+ * - La función que llama a kernel_start() (main) pasa a ser la tarea de
+ *   fondo, con la prioridad más baja, y continúa ejecutando su bucle.
+ *
+ * El análisis de tiempo de respuesta (kernel_rta()) comprueba la
+ * planificabilidad rate-monotonic del conjunto con los WCET medidos.
+ */
+
+#ifndef _KERNEL_H_
+#define _KERNEL_H_
+
+#include <stdint.h>
+
+/** Número máximo de tareas (sin contar la de fondo) */
+#define KERNEL_MAX_TASKS 8u
+
+/** Palabras de la pila de excepciones (MSP) */
+#define KERNEL_MSP_WORDS 256u
+
+/**
+ * @brief Declara la pila de un hilo (alineada a 8 bytes, AAPCS)
+ *
+ * @param name  Nombre del array
+ * @param words Tamaño en palabras de 32 bits (par)
+ */
+#define KERNEL_STACK(name, words) static uint64_t name[(words) / 2u]
+
+/**
+ * @struct kernel_task_cfg_t
+ * @brief Descriptor estático de una tarea
+ */
+typedef struct {
+    const char *name;          /**< Nombre (diagnóstico) */
+    uint16_t period_ms;        /**< Periodo en ms, 0 -> activación por kernel_signal() */
+    uint32_t interarrival_us;  /**< Separación mínima entre eventos (solo period_ms = 0) */
+    uint32_t deadline_us;      /**< Plazo relativo en us, 0 -> periodo */
+    void (*callback)(void);    /**< Función de la tarea */
+    uint64_t *stack;           /**< Pila del hilo (KERNEL_STACK) */
+    uint32_t stack_bytes;      /**< Tamaño de la pila en bytes */
+} kernel_task_cfg_t;
+
+/**
+ * @struct kernel_task_t
+ * @brief Bloque de control de un hilo
+ */
+typedef struct {
+    uint32_t *sp;              /**< Pila guardada */
+    const kernel_task_cfg_t *cfg;  /**< Descriptor */
+    volatile uint32_t pending; /**< Activaciones pendientes */
+    uint32_t next_release;     /**< Siguiente activación (ms) */
+    uint32_t release;          /**< CYCCNT de la activación en curso */
+    uint8_t active;            /**< 1 mientras se ejecuta una activación */
+    uint32_t exec;             /**< Ciclos de CPU acumulados por el hilo */
+    uint32_t slice;            /**< CYCCNT al entrar el hilo en CPU */
+    uint32_t runs;             /**< Número de activaciones completadas */
+    uint32_t wcet;             /**< Peor tiempo de ejecución medido (ciclos) */
+    uint32_t resp_max;         /**< Peor tiempo de respuesta medido (ciclos) */
+    uint32_t misses;           /**< Plazos perdidos */
+    uint32_t rta;              /**< Tiempo de respuesta calculado (ciclos, saturado a UINT32_MAX) */
+} kernel_task_t;
+
+/**
+ * @brief Inicializa el ejecutivo y las pilas de los hilos
+ *
+ * @param cfg Tabla de tareas (orden = prioridad)
+ * @param tcb Array de bloques de control, uno por tarea
+ * @param n   Número de tareas (máximo KERNEL_MAX_TASKS)
+ * @return 0 si tiene éxito, -1 si n o alguna pila no son válidos
+ */
+int8_t kernel_init(const kernel_task_cfg_t *cfg, kernel_task_t *tcb, uint8_t n);
+
+/**
+ * @brief Arranca el ejecutivo
+ *
+ * Configura PendSV con la prioridad más baja y convierte a la función
+ * llamante en la tarea de fondo. SysTick debe estar ya en modo interrupción
+ * (SysTick_InitIRQ()). Retorna a la tarea de fondo en cuanto no hay hilos
+ * listos.
+ */
+void kernel_start(void);
+
+/**
+ * @brief Base de tiempos de 1 ms (llamar desde SysTick_Handler)
+ */
+void kernel_tick(void);
+
+/**
+ * @brief Activa una tarea por evento (llamable desde ISR)
+ *
+ * @param t Bloque de control de la tarea
+ */
+void kernel_signal(kernel_task_t *t);
+
+/**
+ * @brief Análisis de tiempo de respuesta con los WCET medidos
+ *
+ * R = C_i + sum_{j<i} ceil(R / T_j) * C_j, iterado hasta converger o superar
+ * el plazo. Deja el resultado en el campo rta de cada tarea.
+ *
+ * @return 0 si el conjunto es planificable, i + 1 si la tarea i no lo es
+ */
+uint8_t kernel_rta(void);
+
+#endif  /* _KERNEL_H_ */
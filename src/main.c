@@ -11,9 +11,13 @@
  * - Decodificación de protocolo UART
  * - Visualización de estado mediante LED RGB
  *
- * El programa utiliza un ejecutivo cíclico con organización Round-Robin de tareas:
- * - Tareas periódicas (cada ~1 ms): gestión de pulsaciones y LEDs
- * - Tareas de streaming: procesamiento continuo de audio I2S
+ * El programa utiliza un planificador cooperativo dirigido por tabla (scheduler.h):
+ * - Tareas periódicas (cada 1 ms): gestión de pulsaciones
+ * - Tareas de fondo: procesamiento continuo de audio I2S, monitor de
+ *   espectro y temporizadores software
+ * El planificador registra el WCET, los plazos perdidos y la utilización
+ * de cada tarea. Los LEDs los refresca el motor de LEDs por interrupción
+ * (FM4_led_engine.h), sin coste en el bucle principal.
  *
  * @note Frecuencia de muestreo: 48 kHz
  * @note Base de tiempos: 1 ms (SysTick)
@@ -28,23 +32,436 @@
 // =============================================================================
 
 // Cabeceras de los módulos propios
+#include "boot_prof.h"
 #include "circ_buf.h"
+#include "crash.h"
 #include "dds.h"
+#include "decimator.h"
+#include "dsp_params.h"
+#include "fsk_demod.h"
+#include "fsk_link.h"
+#include "kernel.h"
 #include "lab5.h"
 #include "lab4.h"
-#include "pulsaciones.h"
+#include "scheduler.h"
+#include "spectrum.h"
+#include "timer_wheel.h"
+#include "trace.h"
+#include "wdt_sup.h"
 
 // Cabeceras de los módulos HAL y BSP
 #include "FM4_WM8731.h"
+#include "FM4_led_engine.h"
 #include "FM4_leds_sw.h"
+#include "FM4_sw2.h"
+#include "HAL_FM4_dtimer.h"
 #include "HAL_FM4_gpio.h"
+#include "HAL_FM4_hwwdt.h"
 #include "HAL_FM4_i2s.h"
+#include "HAL_FM4_reset.h"
 #include "HAL_SysTick.h"
 
 // Cabeceras estándar
 #include "mcu.h"
+#include <stddef.h>
 #include <stdint.h>
 
+// =============================================================================
+// CONFIGURACIÓN
+// =============================================================================
+
+/**
+ * Arranque rápido: la configuración del códec por I2C (~0.6 ms estimados con
+ * el modelo de test/host/test_wm8731.c) se solapa con el resto de la
+ * inicialización y solo se espera a su fin (FM4_WM8731_sync) antes de
+ * habilitar la interrupción de I2S. Comentar para el arranque secuencial.
+ * Tiempos de cada fase en g_boot_log (boot_prof.h).
+ */
+#define FAST_BOOT
+
+/**
+ * Monitor de espectro de la recepción: decimador FIR 48 kHz -> 8 kHz y FFT
+ * en segundo plano. Añade 8 MAC por muestra recibida a task_audio_rx (el
+ * demodulador usa su propio decimador CIC, más barato y con menos rechazo
+ * del aliasing). Comentar para quitarlo.
+ */
+#define SPECTRUM_MONITOR
+
+/**
+ * Enlace de datos con corrección de errores (fsk_link.h): cada pulsación de
+ * SW2 transmite la trama LINK_MSG codificada en el modo FSK_LINK (FEC_NONE,
+ * FEC_HAMMING74 o FEC_CONV_K7) y task_audio_rx la decodifica (g_link_rx:
+ * última trama, tramas, bits corregidos). Comentar para transmitir con
+ * lab41().
+ */
+#define FSK_LINK  FEC_CONV_K7
+#define LINK_MSG  "SEMP 30319"
+
+/**
+ * Hardware Watchdog: periodo en ciclos de CLKLC (__CLKLC = 100 kHz). Lo
+ * alimenta el supervisor de tareas (wdt_sup.h); la holgura del peor caso
+ * queda en HWWDT_GetMinRemaining().
+ *
+ * Calibración: con WDOG_CALIBRATE el HWWDT arranca con un periodo holgado y,
+ * tras WDOG_CAL_MS con carga representativa, g_wdog_cal guarda el peor
+ * intervalo entre feeds medido y el wdogload derivado con WDOG_MARGIN_PCT y
+ * la tolerancia de CLKLC (HWWDT_US_TO_LOAD). Ese valor sustituye al
+ * periodo por defecto en WDOG_LOAD.
+ */
+//#define WDOG_CALIBRATE
+#define WDOG_MARGIN_PCT  50u      // Margen sobre el peor intervalo medido
+#define WDOG_CAL_MS      10000u   // Duración de la medida
+
+#ifdef WDOG_CALIBRATE
+#define WDOG_LOAD        HWWDT_MS_TO_TICKS(1000u)
+#else
+#define WDOG_LOAD        HWWDT_MS_TO_TICKS(10u)   // Sin calibrar
+#endif
+
+// =============================================================================
+// ESTADO COMPARTIDO ENTRE TAREAS
+// =============================================================================
+
+static uint8_t pulsacion = 0;  // Estado de pulsación actual (0: sin pulsar, 1: corta, 2: larga)
+static uint8_t contador = 0;   // Contador de pulsaciones cortas (0-7)
+static int16_t sample = 0;     // Muestra de audio a transmitir (formato Q15)
+static decim_cic_t rx_cic;     // Decimador CIC 48 kHz -> 8 kHz del demodulador
+static fsk_demod_t rx_demod;   // Demodulador FSK a 8 kHz
+#ifdef FSK_LINK
+static fsk_link_tx_t link_tx;  // Transmisor del enlace (48 kHz)
+fsk_link_rx_t g_link_rx;       // Receptor del enlace (8 kHz), leer con el depurador
+#endif
+#ifdef SPECTRUM_MONITOR
+static decim_t rx_decim;       // Decimador 48 kHz -> 8 kHz del monitor de espectro
+#endif
+
+rst_cause_t g_reset_cause;     // Causa del último reset (HAL_FM4_reset.h)
+uint8_t g_codec_warm;          // 1 si se ha reutilizado la configuración del códec
+
+// =============================================================================
+// EFECTOS DE LOS LEDS (motor de LEDs, FM4_led_engine.h)
+// =============================================================================
+
+static const led_pattern_t led_rgb_on = { LED_PAT_CONST, 255, 0, 0 };       // Color del contador
+static const led_pattern_t led_eth_breath = { LED_PAT_BREATH, 64, 2000, 0 }; // Sistema en marcha
+static const led_pattern_t led_rgb_crash = { LED_PAT_BLINK, 255, 500, 250 }; // Registro post-mortem (hasta pulsar SW2)
+
+// =============================================================================
+// CALIBRACIÓN DEL HARDWARE WATCHDOG
+// =============================================================================
+
+#ifdef WDOG_CALIBRATE
+/**
+ * Resultado de la calibración del HWWDT (leer con el depurador)
+ */
+struct {
+  uint32_t max_feed_us;        // Peor intervalo entre feeds medido
+  uint32_t load;               // wdogload derivado
+} g_wdog_cal;
+
+static sw_timer_t wdog_cal_timer;
+
+/**
+ * @brief Fin de la ventana de calibración del HWWDT
+ */
+static void wdog_cal_done(sw_timer_t *t, void *arg)
+{
+  (void)t;
+  (void)arg;
+  g_wdog_cal.max_feed_us = wdt_sup_max_feed_us();
+  g_wdog_cal.load = HWWDT_US_TO_LOAD(g_wdog_cal.max_feed_us, WDOG_MARGIN_PCT);
+}
+#endif
+
+// =============================================================================
+// TAREAS
+// =============================================================================
+
+/**
+ * @brief Tareas 1 y 2: Detección de pulsaciones y contador de estado
+ *
+ * Recoge los eventos del pulsador SW2, capturado por interrupción externa
+ * con antirrebote diferido (FM4_sw2.h), que clasifica las pulsaciones en:
+ * - 0: Sin pulsación
+ * - 1: Pulsación corta (< SW2_LONG_MS = 200 ms)
+ * - 2: Pulsación larga (>= SW2_LONG_MS)
+ *
+ * Incrementa el contador con cada pulsación corta (módulo 8)
+ * Resetea el contador con cada pulsación larga
+ *
+ * El estado del contador se muestra con el color del LED RGB; el motor de
+ * LEDs solo se actualiza cuando el contador cambia.
+ */
+static void task_pulsador(void)
+{
+  wdt_sup_checkin(WDT_SUP_PULSADOR);
+
+  static const rgb_color_t color[8] = {
+      OFF,     // 0: Apagado
+      RED,     // 1: Rojo
+      GREEN,   // 2: Verde
+      BLUE,    // 3: Azul
+      YELLOW,  // 4: Amarillo
+      MAGENTA, // 5: Magenta
+      CYAN,    // 6: Cian
+      WHITE    // 7: Blanco
+  };
+  sw2_event_t ev;
+  pulsacion = Sw2GetEvent(&ev) ? ev.type : SW2_NONE; // Un evento por tick
+  if (pulsacion != SW2_NONE) {
+    trace(TRACE_SW2_VALUE, pulsacion);
+  }
+
+  if (pulsacion == 1) {
+    contador = (contador + 1) & 7; // Incremento módulo 8 (equivalente a % 8)
+  }
+  if (pulsacion == 2) {
+    contador = 0; // Reset del contador
+  }
+  if (pulsacion != 0) {
+    led_engine_rgb(color[contador], &led_rgb_on);
+  }
+}
+
+/**
+ * @brief Tarea 3: Generación y transmisión de muestras de audio
+ *
+ * Genera una muestra de audio FSK y la inserta en el buffer de transmisión
+ * El procesamiento real se realiza solo si hay espacio en el buffer
+ *
+ * @note El buffer g_tx_buffer se comparte con la ISR, requiere protección
+ */
+static void task_audio_tx(void)
+{
+  __disable_irq(); // Proteger acceso a variable compartida
+  uint8_t error_push = circ_buf_push(&g_tx_buffer, sample);
+  __enable_irq();
+
+  if (error_push == 0) {
+    // Buffer tiene espacio disponible, generar nueva muestra
+
+#ifdef FSK_LINK
+    /**
+     * Enlace con FEC: cada pulsación transmite LINK_MSG (se ignora si
+     * todavía hay una trama en curso)
+     */
+    if (pulsacion != 0) {
+      (void)fsk_link_send(&link_tx, (const uint8_t *)LINK_MSG, sizeof(LINK_MSG) - 1u);
+    }
+    sample = fsk_link_tx_sample(&link_tx);
+#else
+    /**
+     * Opciones de modulación FSK disponibles:
+     *
+     * lab41(): Genera señal FSK con datos predefinidos
+     * - Útil para pruebas básicas de modulación
+     */
+    sample = lab41(pulsacion);
+
+    /**
+     * lab42(): Genera señal FSK transmitiendo un buffer de texto
+     * - Permite transmitir mensajes de texto completos
+     * - El texto se codifica en formato UART y modula en FSK
+     */
+    // static char frase[] = "SEMP 30319";
+    // sample = lab42(pulsacion, frase);
+#endif
+  }
+}
+
+/**
+ * @brief Tarea 4: Recepción y demodulación de señales FSK
+ *
+ * Lee datos del buffer de recepción (si hay disponibles), los decima a
+ * 8 kHz (CIC) y demodula la salida con fsk_demod_process(): por muestra de
+ * 48 kHz, dos sumas, y una de cada 6 el demodulador completo
+ *
+ * El bit demodulado se visualiza en el pin P7D para depuración y sus
+ * cambios se registran en la traza (TRACE_BIT_VALUE)
+ */
+static void task_audio_rx(void)
+{
+  int16_t rxdata;
+  __disable_irq(); // Proteger acceso a variable compartida
+  uint8_t error = circ_buf_pop(&g_rx_buffer, &rxdata);
+  __enable_irq();
+
+  if (error == 0) {
+    // Hay datos en el buffer de recepción, procesar
+    wdt_sup_checkin(WDT_SUP_AUDIO_RX);
+
+    /**
+     * Decima la muestra y demodula la salida a 8 kHz
+     * El bit (0 o 1) se refleja en el pin GPIO P7D
+     * para visualización con osciloscopio o analizador lógico
+     * (lab5(rxdata) es la alternativa a 48 kHz de la biblioteca)
+     */
+    int16_t rx_low;
+    if (decim_cic_process(&rx_cic, rxdata, &rx_low)) {
+      static uint8_t last_bit = 0xFF;
+      uint8_t bit = fsk_demod_process(&rx_demod, rx_low);
+      GPIO_FastWrite(P7D, bit ? GPIO_HIGH : GPIO_LOW);  // un único STR (bit-band)
+      if (bit != last_bit) {
+        trace(TRACE_BIT_VALUE, bit);  // solo los cambios, para no llenar la traza
+        last_bit = bit;
+      }
+
+#ifdef FSK_LINK
+      // Muestreo UART y decodificación; trama completa en g_link_rx.frame
+      (void)fsk_link_rx_bit(&g_link_rx, bit);
+#endif
+
+      /**
+       * Opcional: Decodificar el bit según protocolo UART
+       * Descomentar para recuperar caracteres transmitidos
+       * (uart_decode() cuenta muestras de 48 kHz: un bit cada 6)
+       */
+      // for (uint8_t k = 0; k < 6; k++) {
+      //   const char* caracter = uart_decode(bit);
+      //   if (caracter != NULL) {
+      //     Carácter completo recibido, procesar
+      //   }
+      // }
+    }
+
+#ifdef SPECTRUM_MONITOR
+    /**
+     * Decima la muestra y la entrega al monitor de espectro
+     */
+    int16_t rx_dec;
+    if (decim_process(&rx_decim, rxdata, &rx_dec)) {
+      spectrum_push(rx_dec);
+    }
+#endif
+  }
+}
+
+/**
+ * @brief Tarea 5: Monitor de espectro
+ *
+ * Ejecuta un paso corto del análisis (ventana, etapa FFT o potencias)
+ * con los ciclos sobrantes del bucle
+ */
+static void task_spectrum(void)
+{
+#ifdef SPECTRUM_MONITOR
+  spectrum_run();
+#endif
+}
+
+/**
+ * @brief Tarea 6: Servicio de temporizadores software
+ *
+ * Procesa los ticks transcurridos y ejecuta los temporizadores vencidos
+ */
+static void task_timers(void)
+{
+  timer_wheel_run(SysTick_GetTick());
+}
+
+// =============================================================================
+// TABLA DE TAREAS
+// =============================================================================
+
+/**
+ * Tareas vigiladas por el supervisor del HWWDT (índice = wdt_sup_id_t)
+ *
+ * La ISR de I2S y el demodulador progresan con cada muestra (21 us); el
+ * pulsador cada 1 ms. Las ventanas dejan margen para las pasadas lentas del
+ * bucle y quedan por debajo del periodo del HWWDT (10 ms).
+ */
+static const wdt_sup_task_t wdt_tasks[] = {
+  //  nombre        ventana
+  //                  (ms)
+  { "i2s",             2 },
+  { "audio_rx",        2 },
+  { "pulsador",        5 },
+};
+
+#define N_WDT_TASKS (sizeof(wdt_tasks) / sizeof(wdt_tasks[0]))
+
+static wdt_sup_stats_t wdt_stats[N_WDT_TASKS];
+
+#ifdef _USE_KERNEL_
+
+/**
+ * @brief Hilo de audio: atiende TX y RX hasta vaciar lo acumulado
+ *
+ * La ISR de I2S lo activa cada CIRC_BUF_SIZE / 2 muestras recibidas
+ */
+static void thread_audio(void)
+{
+  for (uint8_t i = 0; i < CIRC_BUF_SIZE; i++) {
+    task_audio_tx();
+    task_audio_rx();
+  }
+}
+
+/**
+ * @brief Hilo de control (1 ms): pulsador y LED RGB
+ */
+static void thread_control(void)
+{
+  task_pulsador();
+}
+
+KERNEL_STACK(stack_audio, 256);
+KERNEL_STACK(stack_control, 128);
+
+/**
+ * Tabla de hilos del ejecutivo expulsivo (orden = prioridad, rate-monotonic)
+ *
+ * El hilo de audio se activa cada 4 muestras (83 us a 48 kHz) y debe
+ * terminar antes de que lleguen otras 4 para no desbordar los buffers.
+ * Las tareas de fondo (espectro y temporizadores) quedan en el bucle de main.
+ */
+static const kernel_task_cfg_t threads_cfg[] = {
+  //  nombre    periodo  separación  plazo  función          pila
+  //             (ms)       (us)      (us)
+  { "audio",       0,        83,       83,  thread_audio,    stack_audio,   sizeof(stack_audio)   },
+  { "control",     1,         0,        0,  thread_control,  stack_control, sizeof(stack_control) },
+};
+
+#define N_THREADS (sizeof(threads_cfg) / sizeof(threads_cfg[0]))
+
+/**
+ * Bloques de control de los hilos (WCET, tiempo de respuesta, plazos
+ * perdidos). kernel_rta() deja en ellos el análisis de planificabilidad.
+ */
+static kernel_task_t threads[N_THREADS];
+
+/** Hilo de audio, activado desde PRGCRC_I2S_IRQHandler */
+kernel_task_t * const g_audio_thread = &threads[0];
+
+#else
+
+/**
+ * Tabla de tareas del planificador (orden = prioridad)
+ *
+ * Las tareas de audio tienen como plazo el intervalo máximo entre dos
+ * ejecuciones: con CIRC_BUF_SIZE = 8 muestras a 48 kHz el buffer cubre
+ * unos 145 us, se fija un plazo de 100 us.
+ */
+static const sched_task_t tasks[] = {
+  //  nombre        periodo offset presupuesto plazo  función
+  //                  (ms)   (ms)     (us)      (us)
+  { "pulsador",        1,     0,       5,        0,   task_pulsador   },
+  { "audio_tx",        0,     0,      10,      100,   task_audio_tx   },
+  { "audio_rx",        0,     0,      15,      100,   task_audio_rx   },
+  { "spectrum",        0,     0,      50,        0,   task_spectrum   },
+  { "timers",          0,     0,      20,        0,   task_timers     },
+};
+
+#define N_TASKS (sizeof(tasks) / sizeof(tasks[0]))
+
+/**
+ * Estadísticas de ejecución (WCET, plazos perdidos, utilización)
+ * Consultar con el depurador o mediante sched_utilization()
+ */
+static sched_stats_t task_stats[N_TASKS];
+
+#endif
+
 // =============================================================================
 // FUNCIÓN PRINCIPAL
 // =============================================================================
@@ -55,13 +472,18 @@
  * Realiza la inicialización de todos los periféricos y ejecuta el bucle
  * principal con el ejecutivo cíclico de tareas.
  *
- * Secuencia de inicialización:
+ * Secuencia de inicialización (cada fase se registra en g_boot_log):
  * 1. Configuración de LEDs y pulsador SW2
  * 2. Configuración del temporizador SysTick (base de tiempos 1 ms)
  * 3. Inicialización del códec de audio WM8731 y comunicación I2S
+ *    (con FAST_BOOT las escrituras I2C continúan en segundo plano; tras un
+ *    reset por watchdog o software se reutiliza la configuración del códec
+ *    si se ha conservado)
  * 4. Configuración de pines GPIO para depuración
- * 5. Inicialización de buffers circulares
- * 6. Habilitación de interrupciones
+ * 5. Inicialización de buffers circulares y módulos DSP
+ * 6. Espera al fin de la configuración del códec y habilitación de
+ *    interrupciones
+ * 7. Inicialización del planificador
  *
  * @return int32_t Código de retorno (nunca se alcanza)
  */
@@ -71,15 +493,40 @@ int32_t main(void) {
   // INICIALIZACIÓN DE PERIFÉRICOS
   // ---------------------------------------------------------------------------
 
+  // Perfilado del arranque (DWT->CYCCNT desde este punto) y traza de eventos
+  boot_prof_init();
+  trace_init();
+
+  // Causa del reset (g_reset_cause en el depurador) y registro post-mortem
+  // del arranque anterior (g_crash_last)
+  g_reset_cause = RST_GetCause();
+  const crash_record_t *crash = crash_boot_read();
+  crash_faults_enable();
+
   // Configuración de LEDS y pulsador SW2
   LedsSwInit();
+  boot_mark(BOOT_LEDS);
 
   // Configuración e inicio Systick para base de tiempos de 1ms
-  SysTick_Init(SystemCoreClock / 1000); // Tick cada 1ms
+  SysTick_InitIRQ(SystemCoreClock / 1000); // Tick cada 1ms, por interrupción
+
+  // Base de tiempos (DTIM1) y alarmas asíncronas (DTIM2) del Dual Timer
+  DTIM_Init();
+  boot_mark(BOOT_TIMERS);
+
+  // Motor de LEDs (ISR del Dual Timer): LED Ethernet en respiración
+  led_engine_init();
+  led_engine_set(LED_ETH, &led_eth_breath);
+  if (crash != NULL) {
+    led_engine_rgb(RED, &led_rgb_crash);  // El último reset fue por fallo
+  }
+
+  // Pulsador SW2 por interrupción externa (INT05_0)
+  Sw2IrqInit();
 
   // llamadas para configurar y arrancar el watchdog
-  //HWWDT_Init( ?? , ?? ); // periodo de 10ms, con reset
-  //HWWDT_Start();         // arranca el watchdog
+  HWWDT_Init(WDOG_LOAD, 1); // periodo de 10ms, con reset
+  HWWDT_Start();            // arranca el watchdog
 
   /**
    * Inicialización del códec de audio WM8731
@@ -88,13 +535,30 @@ int32_t main(void) {
    * - Ganancia de salida auriculares: 0 dB
    * - Ganancia de entrada line-in: 0 dB
    */
-  FM4_WM8731_init(FS_48000_HZ,               // Sampling rate (sps)
-                  WM8731_LINE_IN,            // Audio input port
-                  WM8731_HP_OUT_GAIN_0_DB,   // Output headphone jack Gain (dB)
-                  WM8731_LINE_IN_GAIN_0_DB); // Line-in input gain (dB)
+  if ((g_reset_cause == RST_WATCHDOG) || (g_reset_cause == RST_SOFTWARE)) {
+    // Arranque en caliente: el códec no se resetea con el MCU
+    g_codec_warm = FM4_WM8731_init_warm(FS_48000_HZ,               // Sampling rate (sps)
+                                        WM8731_LINE_IN,            // Audio input port
+                                        WM8731_HP_OUT_GAIN_0_DB,   // Output headphone jack Gain (dB)
+                                        WM8731_LINE_IN_GAIN_0_DB); // Line-in input gain (dB)
+  } else {
+#ifdef FAST_BOOT
+    FM4_WM8731_init_async(FS_48000_HZ,               // Sampling rate (sps)
+                          WM8731_LINE_IN,            // Audio input port
+                          WM8731_HP_OUT_GAIN_0_DB,   // Output headphone jack Gain (dB)
+                          WM8731_LINE_IN_GAIN_0_DB); // Line-in input gain (dB)
+#else
+    FM4_WM8731_init(FS_48000_HZ,               // Sampling rate (sps)
+                    WM8731_LINE_IN,            // Audio input port
+                    WM8731_HP_OUT_GAIN_0_DB,   // Output headphone jack Gain (dB)
+                    WM8731_LINE_IN_GAIN_0_DB); // Line-in input gain (dB)
+#endif
+  }
+  boot_mark(BOOT_CODEC);
 
   // Puesta en marcha de I2S (inicia transferencia de audio)
   I2S_start();
+  boot_mark(BOOT_I2S);
 
   /**
    * Configuración de pines GPIO para depuración
@@ -107,6 +571,7 @@ int32_t main(void) {
   // Inicializar pines en estado bajo
   GPIO_ChannelWrite(P7D, GPIO_LOW);
   GPIO_ChannelWrite(PF1, GPIO_LOW);
+  boot_mark(BOOT_GPIO);
 
   /**
    * Inicialización del buffer circular de transmisión
@@ -114,160 +579,87 @@ int32_t main(void) {
    */
   circ_buf_init(&g_tx_buffer, 4, 0);
 
+  /**
+   * Receptor FSK
+   * - Decimación CIC 48 kHz -> 8 kHz
+   * - Demodulador con los parámetros de 8 kHz (dsp_params.h)
+   */
+  decim_cic_init(&rx_cic, 6);
+  fsk_demod_init(&rx_demod, dsp_params_get(FS_8000_HZ));
+
+#ifdef FSK_LINK
+  /**
+   * Enlace de datos: transmisor a 48 kHz, receptor tras el demodulador
+   * (8 kHz), tramas de longitud fija sizeof(LINK_MSG) - 1
+   */
+  fsk_link_tx_init(&link_tx, FSK_LINK, dsp_params_get(FS_48000_HZ));
+  fsk_link_rx_init(&g_link_rx, FSK_LINK, sizeof(LINK_MSG) - 1u, dsp_params_get(FS_8000_HZ));
+#endif
+
+#ifdef SPECTRUM_MONITOR
+  /**
+   * Monitor de espectro de la recepción
+   * - Decimación 48 kHz -> 8 kHz
+   * - FFT de 256 puntos en segundo plano
+   */
+  decim_init(&rx_decim, 6);
+  spectrum_init(dsp_params_get(FS_8000_HZ)->fs_hz);
+#endif
+
+  // Temporizadores software sobre la base de tiempos de SysTick
+  timer_wheel_init(SysTick_GetTick());
+#ifdef WDOG_CALIBRATE
+  sw_timer_init(&wdog_cal_timer, wdog_cal_done, NULL);
+  sw_timer_start(&wdog_cal_timer, WDOG_CAL_MS, 0);  // fin de la medida
+#endif
+  boot_mark(BOOT_DSP);
+
+  // Espera (por estado, no por tiempo) al fin de las escrituras al códec;
+  // inmediato si ya han terminado o no las hay (arranque en caliente)
+  FM4_WM8731_sync();
+  boot_mark(BOOT_CODEC_READY);
+
   // Habilita interrupción I2S para gestión de transferencias de audio
   NVIC_EnableIRQ(PRGCRC_I2S_IRQn);
+  boot_mark(BOOT_IRQ);
 
-
+#ifdef _USE_KERNEL_
   // ---------------------------------------------------------------------------
-  // EJECUTIVO CÍCLICO (ROUND-ROBIN)
+  // EJECUTIVO EXPULSIVO
   // ---------------------------------------------------------------------------
 
+  kernel_init(threads_cfg, threads, N_THREADS);
+  boot_mark(BOOT_SCHED);
+  wdt_sup_init(wdt_tasks, wdt_stats, N_WDT_TASKS);
+  kernel_start();
+
   /**
-   * Variables de control del ejecutivo cíclico
+   * Bucle principal: tarea de fondo, expulsada por los hilos
    */
-  uint8_t pulsacion = 0;  // Estado de pulsación actual (0: sin pulsar, 1: corta, 2: larga)
-  uint8_t contador = 0;   // Contador de pulsaciones cortas (0-7)
-  int16_t sample = 0;     // Muestra de audio a transmitir (formato Q15)
+  while (1) {
+    task_spectrum();
+    task_timers();
+    wdt_sup_poll(); // feed del HWWDT si todas las tareas vigiladas cumplen
+  }
+#else
+  // ---------------------------------------------------------------------------
+  // PLANIFICADOR COOPERATIVO
+  // ---------------------------------------------------------------------------
+
+  sched_init(tasks, task_stats, N_TASKS);
+  boot_mark(BOOT_SCHED);
+  wdt_sup_init(wdt_tasks, wdt_stats, N_WDT_TASKS);
 
   /**
    * Bucle principal infinito
-   * Implementa un ejecutivo cíclico con tareas periódicas y continuas
+   * El contador de ticks de SysTick marca la base de tiempos de 1 ms de las
+   * tareas periódicas; una pasada lenta no pierde activaciones
    */
   while (1) {
-
-    // -------------------------------------------------------------------------
-    // TAREAS PERIÓDICAS (cada ~1ms)
-    // -------------------------------------------------------------------------
-
-    /**
-     * Las siguientes tareas se ejecutan cada vez que el SysTick genera
-     * un evento de overflow (aproximadamente cada 1 ms)
-     */
-    if (SysTick_ChkOvf()) {
-
-
-      // Tarea 1: Detección y clasificación de pulsaciones
-      /**
-       * Lee el estado del pulsador SW2 y lo procesa mediante la máquina
-       * de estados de antirebote que clasifica las pulsaciones en:
-       * - 0: Sin pulsación
-       * - 1: Pulsación corta (< 200 ms)
-       * - 2: Pulsación larga (>= 200 ms)
-       */
-      uint8_t entrada = Sw2Read(); // Lee SW2
-      pulsacion = pulsaciones(entrada, 0);
-
-      // Tarea 2: Actualización del contador de estado
-      /**
-       * Incrementa el contador con cada pulsación corta (módulo 8)
-       * Resetea el contador con cada pulsación larga
-       */
-      if (pulsacion == 1) {
-        contador = (contador + 1) & 7; // Incremento módulo 8 (equivalente a % 8)
-      }
-      if (pulsacion == 2) {
-        contador = 0; // Reset del contador
-      }
-
-      // Tarea 3: Control del LED RGB según el contador
-      /**
-       * Muestra el estado del contador mediante diferentes colores
-       * en el LED RGB. Permite visualizar el funcionamiento del sistema.
-       */
-      static const rgb_color_t color[8] = {
-          OFF,     // 0: Apagado
-          RED,     // 1: Rojo
-          GREEN,   // 2: Verde
-          BLUE,    // 3: Azul
-          YELLOW,  // 4: Amarillo
-          MAGENTA, // 5: Magenta
-          CYAN,    // 6: Cian
-          WHITE    // 7: Blanco
-      };
-      LedRGB(color[contador]);
-    }
-
-    // -------------------------------------------------------------------------
-    // TAREAS DE STREAMING DE AUDIO
-    // -------------------------------------------------------------------------
-
-    // Tarea 4: Generación y transmisión de muestras de audio
-    /**
-     * Genera una muestra de audio FSK y la inserta en el buffer de transmisión
-     * El procesamiento real se realiza solo si hay espacio en el buffer
-     *
-     * @note La variable 'pulsacion' se comparte con la ISR, requiere protección
-     */
-    __disable_irq(); // Proteger acceso a variable compartida
-    uint8_t error_push = circ_buf_push(&g_tx_buffer, sample);
-    __enable_irq();
-
-    if (error_push == 0) {
-      // Buffer tiene espacio disponible, generar nueva muestra
-
-      /**
-       * Opciones de modulación FSK disponibles:
-       *
-       * lab41(): Genera señal FSK con datos predefinidos
-       * - Útil para pruebas básicas de modulación
-       */
-      sample = lab41(pulsacion);
-
-      /**
-       * lab42(): Genera señal FSK transmitiendo un buffer de texto
-       * - Permite transmitir mensajes de texto completos
-       * - El texto se codifica en formato UART y modula en FSK
-       */
-      // static char frase[] = "SEMP 30319";
-      // sample = lab42(pulsacion, frase);
-    }
-
-    // Tarea 5: Recepción y demodulación de señales FSK
-    /**
-     * Lee datos del buffer de recepción (si hay disponibles)
-     * y los procesa mediante el demodulador FSK
-     *
-     * El bit demodulado se visualiza en el pin P7D para depuración
-     */
-    int16_t rxdata;
-    __disable_irq(); // Proteger acceso a variable compartida
-    uint8_t error = circ_buf_pop(&g_rx_buffer, &rxdata);
-    __enable_irq();
-
-    if (error == 0) {
-      // Hay datos en el buffer de recepción, procesar
-
-      /**
-       * Demodula la muestra FSK y recupera el bit digital
-       * El resultado (0 o 1) se refleja en el pin GPIO P7D
-       * para visualización con osciloscopio o analizador lógico
-       */
-      uint8_t bit = lab5(rxdata);
-      GPIO_ChannelWrite(P7D, bit ? GPIO_HIGH : GPIO_LOW);
-
-      /**
-       * Opcional: Decodificar el bit según protocolo UART
-       * Descomentar para recuperar caracteres transmitidos
-       */
-      // const char* caracter = uart_decode(bit);
-      // if (caracter != NULL) {
-      //   Carácter completo recibido, procesar
-      // }
-    }
-
-    // -------------------------------------------------------------------------
-    // TAREAS CONTINUAS
-    // -------------------------------------------------------------------------
-
-    /**
-     * Tarea 6: Efecto breathing en LED Ethernet
-     * Se ejecuta continuamente para proporcionar indicación visual
-     * de que el sistema está en funcionamiento
-     */
-    if (1) {
-      breath_led(LED_ETH);
-    }
+    sched_run();
+    wdt_sup_poll(); // feed del HWWDT si todas las tareas vigiladas cumplen
   }
+#endif
 
   return 0; // Never reached
 }
@@ -0,0 +1,150 @@
+/**
+ * @file scheduler.c
+ * @date :2026/02/16 10:02:37
+ * @brief Planificador cooperativo dirigido por tabla
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "mcu.h"
+#include "scheduler.h"
+#include "trace.h"
+#include "HAL_SysTick.h"
+
+static const sched_task_t *sched_tasks;   /**< Tabla de tareas */
+static sched_stats_t *sched_stats;        /**< Estadísticas por tarea */
+static uint8_t sched_n;                   /**< Número de tareas */
+
+static uint32_t cycles_us;                /**< Ciclos por microsegundo */
+static uint32_t cycles_ms;                /**< Ciclos por tick (1 ms) */
+static uint32_t window_last;              /**< CYCCNT al inicio de la pasada anterior */
+static uint64_t window;                   /**< Ciclos de la ventana de medida */
+
+void sched_init(const sched_task_t *tasks, sched_stats_t *stats, uint8_t n)
+{
+    // Contador de ciclos del DWT (libre: lo comparten boot_prof y trace)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    sched_tasks = tasks;
+    sched_stats = stats;
+    sched_n = n;
+    cycles_us = SystemCoreClock / 1000000u;
+    cycles_ms = SystemCoreClock / 1000u;
+
+    uint32_t now_ms = (uint32_t)SysTick_GetTick();
+    for (uint8_t i = 0; i < n; i++)
+    {
+        stats[i].next_release = now_ms + tasks[i].offset_ms;
+    }
+    sched_stats_reset();
+}
+
+void sched_run(void)
+{
+    uint32_t pass_start = DWT->CYCCNT;
+    window += pass_start - window_last;
+    window_last = pass_start;
+    uint64_t now_tick = SysTick_GetTick();
+    uint32_t now_ms = (uint32_t)now_tick;
+
+    for (uint8_t i = 0; i < sched_n; i++)
+    {
+        const sched_task_t *t = &sched_tasks[i];
+        sched_stats_t *s = &sched_stats[i];
+        uint64_t since = 0;
+
+        if (t->period_ms != 0u)
+        {
+            uint32_t late = now_ms - s->next_release;
+            if ((int32_t)late < 0)
+            {
+                continue;   // aún no se ha activado
+            }
+            if (late >= t->period_ms)
+            {
+                // Activaciones saltadas: plazos perdidos
+                uint32_t skipped = late / t->period_ms;
+                s->misses += skipped;
+                s->next_release += skipped * t->period_ms;
+                late -= skipped * t->period_ms;
+            }
+            s->next_release += t->period_ms;
+            // Ciclos transcurridos desde la activación
+            since = SysTick_GetCycles() - (now_tick - late) * cycles_ms;
+        }
+
+        trace(TRACE_TASK_BEGIN, i);
+        uint32_t start = DWT->CYCCNT;
+        if ((t->period_ms == 0u) && (s->runs > 0u) && (t->deadline_us != 0u))
+        {
+            // Tarea de fondo: intervalo máximo entre ejecuciones
+            if ((start - s->last_start) > t->deadline_us * cycles_us)
+            {
+                s->misses++;
+            }
+        }
+
+        t->callback();
+
+        uint32_t end = DWT->CYCCNT;
+        trace(TRACE_TASK_END, i);
+        uint32_t exec = end - start;
+        s->last_start = start;
+        s->runs++;
+        s->busy += exec;
+        if (exec > s->wcet)
+        {
+            s->wcet = exec;
+        }
+        if ((t->budget_us != 0u) && (exec > t->budget_us * cycles_us))
+        {
+            s->overruns++;
+        }
+        if (t->period_ms != 0u)
+        {
+            uint32_t deadline = (t->deadline_us != 0u) ? t->deadline_us
+                                                      : 1000u * t->period_ms;
+            if ((since + exec) > (uint64_t)deadline * cycles_us)
+            {
+                s->misses++;
+            }
+        }
+    }
+}
+
+uint32_t sched_utilization(uint8_t i)
+{
+    if ((i >= sched_n) || (window == 0u))
+    {
+        return 0;
+    }
+    return (uint32_t)((sched_stats[i].busy * 10000u) / window);
+}
+
+uint32_t sched_utilization_periodic(void)
+{
+    uint32_t u = 0;
+    for (uint8_t i = 0; i < sched_n; i++)
+    {
+        if (sched_tasks[i].period_ms != 0u)
+        {
+            u += sched_utilization(i);
+        }
+    }
+    return u;
+}
+
+void sched_stats_reset(void)
+{
+    for (uint8_t i = 0; i < sched_n; i++)
+    {
+        sched_stats[i].runs = 0;
+        sched_stats[i].wcet = 0;
+        sched_stats[i].overruns = 0;
+        sched_stats[i].misses = 0;
+        sched_stats[i].busy = 0;
+    }
+    window = 0;
+    window_last = DWT->CYCCNT;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file scheduler.h
+ * @date :2026/02/16 10:02:37
+ * @brief Planificador cooperativo dirigido por tabla
+ *
+ * Sustituye el ejecutivo cíclico escrito a mano en main(). La base de tiempos
+ * es el contador de ticks de 1 ms de HAL_SysTick (SysTick_InitIRQ()), de modo
+ * que un bucle lento no pierde activaciones. Cada tarea se
+ * describe en una tabla estática (periodo, desfase, presupuesto, plazo y
+ * función) y el planificador:
+ * - Ejecuta las tareas periódicas en su instante de activación, en el orden
+ *   de la tabla (orden = prioridad).
+ * - Ejecuta las tareas de fondo (periodo 0) en cada pasada del bucle.
+ * - Mide con DWT->CYCCNT el tiempo de ejecución de cada activación y
+ *   registra el peor caso (WCET), los excesos de presupuesto y los plazos
+ *   perdidos.
+ * - Calcula la utilización de cada tarea sobre la ventana de medida.
+ *
+ * Plazos:
+ * - Tareas periódicas: plazo relativo desde la activación (0 -> periodo).
+ *   Si una tarea se activa con más de un periodo de retraso, se cuentan
+ *   como perdidas las activaciones saltadas.
+ * - Tareas de fondo: máximo intervalo entre dos ejecuciones consecutivas.
+ *   Es el mecanismo para detectar que el trabajo añadido al bucle está
+ *   dejando sin servicio a las tareas de streaming de audio.
+ *
+ * @note Cooperativo: una tarea nunca interrumpe a otra. El presupuesto y el
+ *       plazo solo se vigilan, no se imponen.
+ */
+
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+#include <stdint.h>
+
+/**
+ * @struct sched_task_t
+ * @brief Descriptor estático de una tarea
+ */
+typedef struct {
+    const char *name;          /**< Nombre (diagnóstico) */
+    uint16_t period_ms;        /**< Periodo en ms, 0 -> tarea de fondo */
+    uint16_t offset_ms;        /**< Desfase de la primera activación en ms */
+    uint32_t budget_us;        /**< Presupuesto de ejecución en us, 0 -> sin límite */
+    uint32_t deadline_us;      /**< Plazo en us (ver descripción del módulo) */
+    void (*callback)(void);    /**< Función de la tarea */
+} sched_task_t;
+
+/**
+ * @struct sched_stats_t
+ * @brief Estadísticas de ejecución de una tarea
+ */
+typedef struct {
+    uint32_t next_release;     /**< Siguiente activación (ms) */
+    uint32_t last_start;       /**< CYCCNT al inicio de la última ejecución */
+    uint32_t runs;             /**< Número de ejecuciones */
+    uint32_t wcet;             /**< Peor tiempo de ejecución (ciclos) */
+    uint32_t overruns;         /**< Ejecuciones que superan el presupuesto */
+    uint32_t misses;           /**< Plazos perdidos */
+    uint64_t busy;             /**< Ciclos ejecutando en la ventana de medida */
+} sched_stats_t;
+
+/**
+ * @brief Inicializa el planificador y el contador de ciclos DWT
+ *
+ * @param tasks Tabla de tareas (orden = prioridad)
+ * @param stats Array de estadísticas, uno por tarea
+ * @param n     Número de tareas
+ */
+void sched_init(const sched_task_t *tasks, sched_stats_t *stats, uint8_t n);
+
+/**
+ * @brief Ejecuta una pasada del planificador
+ *
+ * Ejecuta las tareas periódicas activadas y todas las tareas de fondo.
+ * Llamar continuamente desde el bucle principal.
+ */
+void sched_run(void);
+
+/**
+ * @brief Devuelve la utilización de una tarea en la ventana de medida
+ *
+ * @param i Índice de la tarea en la tabla
+ * @return Utilización en tanto por diez mil (10000 = 100 %)
+ */
+uint32_t sched_utilization(uint8_t i);
+
+/**
+ * @brief Devuelve la utilización total de las tareas periódicas
+ *
+ * @return Utilización en tanto por diez mil. Lo que queda hasta 10000 es el
+ *         tiempo disponible para las tareas de fondo.
+ */
+uint32_t sched_utilization_periodic(void);
+
+/**
+ * @brief Reinicia la ventana de medida de utilización y las estadísticas
+ */
+void sched_stats_reset(void);
+
+#endif  /* _SCHEDULER_H_ */
@@ -0,0 +1,315 @@
+/**
+ * @file spectrum.c
+ * @date :2026/02/09 12:20:31
+ * @brief Monitor de espectro de la señal recibida (FFT radix-4 en punto fijo)
+ *
+ * FFT radix-4 de diezmado en frecuencia (DIF). Mariposa de la etapa con
+ * cuarto de longitud q y paso de twiddle s, para j = 0..q-1:
+ * @code
+ *   y0 = (a + b + c + d) / 4
+ *   y1 = (a - jb - c + jd) / 4 * W^(js)
+ *   y2 = (a - b + c - d) / 4 * W^(2js)
+ *   y3 = (a + jb - c - jd) / 4 * W^(3js)
+ * @endcode
+ * La salida queda en orden de dígitos base 4 invertidos.
+ */
+
+#include <stdint.h>
+#include "spectrum.h"
+#include "dsp_params.h"
+
+/**
+ * @brief cos(2*pi*k/N) en Q15, k = 0..N-1
+ * @note sin(2*pi*k/N) = cos_tbl[(k - N/4) mod N]
+ */
+static const int16_t cos_tbl[SPECTRUM_N] = {
+    32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285, 32137, 31971, 31785, 31580,
+    31356, 31113, 30852, 30571, 30273, 29956, 29621, 29268, 28898, 28510, 28105, 27683,
+    27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731, 23170, 22594, 22005, 21403,
+    20787, 20159, 19519, 18868, 18204, 17530, 16846, 16151, 15446, 14732, 14010, 13279,
+    12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179, 6393, 5602, 4808, 4011,
+    3212, 2410, 1608, 804, 0, -804, -1608, -2410, -3212, -4011, -4808, -5602,
+    -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793, -12539, -13279, -14010, -14732,
+    -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+    -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790, -27245, -27683, -28105, -28510,
+    -28898, -29268, -29621, -29956, -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+    -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757, -32767, -32757, -32728, -32678,
+    -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+    -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683, -27245, -26790, -26319, -25832,
+    -25329, -24811, -24279, -23731, -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+    -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279, -12539, -11793, -11039, -10278,
+    -9512, -8739, -7962, -7179, -6393, -5602, -4808, -4011, -3212, -2410, -1608, -804,
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739,
+    9512, 10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279, 24811,
+    25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521,
+    32609, 32678, 32728, 32757
+};
+
+/**
+ * @brief Estados del análisis incremental
+ */
+typedef enum {
+    SPECTRUM_IDLE,     /**< Esperando un bloque completo */
+    SPECTRUM_FFT,      /**< Ejecutando etapas radix-4 */
+    SPECTRUM_POWER     /**< Cálculo de potencias y medias */
+} spectrum_state_t;
+
+static int16_t collect[2][SPECTRUM_N];         /**< Bloques de entrada (doble buffer) */
+static int16_t work[2 * SPECTRUM_N];           /**< Datos complejos re,im in situ */
+static uint32_t avg_power[SPECTRUM_N / 2 + 1]; /**< Potencia media por bin */
+
+static uint16_t fill_count;       /**< Muestras en el bloque en curso */
+static uint8_t  fill_idx;         /**< Bloque que se está llenando */
+static uint8_t  ready;            /**< Hay un bloque completo sin procesar */
+static uint8_t  stage;            /**< Siguiente etapa radix-4 */
+static spectrum_state_t state;
+static spectrum_report_t report;
+
+/**
+ * @brief Satura un valor de 32 bits a 16 bits
+ */
+static int16_t sat16(int32_t x)
+{
+    if (x > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (x < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)x;
+}
+
+/**
+ * @brief Multiplica (re, im) por W^k = cos - j sin y guarda en out
+ */
+static void twiddle_mul(int32_t re, int32_t im, uint32_t k, int16_t *out)
+{
+    int32_t c = cos_tbl[k & (SPECTRUM_N - 1u)];
+    int32_t s = cos_tbl[(k - SPECTRUM_N / 4u) & (SPECTRUM_N - 1u)];
+    out[0] = sat16((re * c + im * s) >> 15);
+    out[1] = sat16((im * c - re * s) >> 15);
+}
+
+/**
+ * @brief Ejecuta una etapa radix-4 sobre work[]
+ *
+ * @param st Índice de la etapa (0..SPECTRUM_STAGES-1)
+ */
+static void fft_stage(uint8_t st)
+{
+    uint32_t q = SPECTRUM_N >> (2u * (st + 1u));   // cuarto de la sub-DFT
+    uint32_t s = 1u << (2u * st);                  // paso de twiddle
+
+    for (uint32_t base = 0; base < SPECTRUM_N; base += 4u * q)
+    {
+        for (uint32_t j = 0; j < q; j++)
+        {
+            int16_t *pa = &work[2u * (base + j)];
+            int16_t *pb = pa + 2u * q;
+            int16_t *pc = pb + 2u * q;
+            int16_t *pd = pc + 2u * q;
+
+            int32_t ar = pa[0], ai = pa[1];
+            int32_t br = pb[0], bi = pb[1];
+            int32_t cr = pc[0], ci = pc[1];
+            int32_t dr = pd[0], di = pd[1];
+
+            int32_t s0r = ar + cr, s0i = ai + ci;   // a + c
+            int32_t d0r = ar - cr, d0i = ai - ci;   // a - c
+            int32_t s1r = br + dr, s1i = bi + di;   // b + d
+            int32_t d1r = br - dr, d1i = bi - di;   // b - d
+
+            // y0 = a + b + c + d
+            pa[0] = (int16_t)((s0r + s1r) >> 2);
+            pa[1] = (int16_t)((s0i + s1i) >> 2);
+            // y2 = a - b + c - d
+            twiddle_mul((s0r - s1r) >> 2, (s0i - s1i) >> 2, 2u * j * s, pc);
+            // y1 = (a - c) - j(b - d)
+            twiddle_mul((d0r + d1i) >> 2, (d0i - d1r) >> 2, j * s, pb);
+            // y3 = (a - c) + j(b - d)
+            twiddle_mul((d0r - d1i) >> 2, (d0i + d1r) >> 2, 3u * j * s, pd);
+        }
+    }
+}
+
+/**
+ * @brief Inversión de dígitos base 4 de un índice de 8 bits
+ */
+static uint32_t digit_reverse(uint32_t k)
+{
+    uint32_t r = 0;
+    for (uint8_t i = 0; i < SPECTRUM_STAGES; i++)
+    {
+        r = (r << 2) | (k & 3u);
+        k >>= 2;
+    }
+    return r;
+}
+
+/**
+ * @brief Aproximación de log2(x) en Q8 (mantisa lineal)
+ */
+static int32_t log2_q8(uint32_t x)
+{
+    int32_t e = 31;
+    if (x == 0u)
+    {
+        return 0;
+    }
+    while ((x & 0x80000000u) == 0u)
+    {
+        x <<= 1;
+        e--;
+    }
+    return (e << 8) + (int32_t)((x >> 23) & 0xFFu);
+}
+
+/**
+ * @brief SNR en décimas de dB: 100*log10(a/b) = 30.103*log2(a/b)
+ */
+static int16_t snr_db10(uint32_t a, uint32_t b)
+{
+    int32_t diff = log2_q8(a) - log2_q8(b);
+    return (int16_t)((diff * 7706) >> 16);
+}
+
+/**
+ * @brief Bin más cercano a f_hz, en 1..SPECTRUM_N/2-1: el lóbulo de 3 bins
+ *        de spectrum_get_report() queda dentro de avg_power[]
+ */
+static uint16_t tone_bin(uint32_t f_hz, uint32_t fs_hz)
+{
+    uint32_t bin = (fs_hz > 0u) ? (f_hz * SPECTRUM_N + fs_hz / 2u) / fs_hz : SPECTRUM_N;
+    if (bin < 1u)
+    {
+        bin = 1u;
+    }
+    else if (bin > SPECTRUM_N / 2u - 1u)
+    {
+        bin = SPECTRUM_N / 2u - 1u;
+    }
+    return (uint16_t)bin;
+}
+
+void spectrum_init(uint32_t fs_hz)
+{
+    for (uint32_t k = 0; k <= SPECTRUM_N / 2u; k++)
+    {
+        avg_power[k] = 0;
+    }
+    fill_count = 0;
+    fill_idx = 0;
+    ready = 0;
+    state = SPECTRUM_IDLE;
+    report.blocks = 0;
+    report.dropped = 0;
+    report.bin_mark = tone_bin(FSK_MARK_HZ, fs_hz);
+    report.bin_space = tone_bin(FSK_SPACE_HZ, fs_hz);
+}
+
+void spectrum_push(int16_t x)
+{
+    collect[fill_idx][fill_count++] = x;
+    if (fill_count < SPECTRUM_N)
+    {
+        return;
+    }
+    fill_count = 0;
+    if (ready)
+    {
+        report.dropped++;   // el bloque anterior sigue pendiente, se sobrescribe este
+        return;
+    }
+    ready = 1;
+    fill_idx ^= 1u;
+}
+
+uint8_t spectrum_run(void)
+{
+    switch (state)
+    {
+    case SPECTRUM_IDLE:
+        if (!ready)
+        {
+            return 0;
+        }
+        {
+            // Ventana de Hann: w[n] = (1 - cos(2*pi*n/N)) / 2
+            const int16_t *x = collect[fill_idx ^ 1u];
+            for (uint32_t n = 0; n < SPECTRUM_N; n++)
+            {
+                int32_t w = (32767 - cos_tbl[n]) >> 1;
+                work[2u * n] = (int16_t)((x[n] * w) >> 15);
+                work[2u * n + 1u] = 0;
+            }
+        }
+        stage = 0;
+        state = SPECTRUM_FFT;
+        break;
+
+    case SPECTRUM_FFT:
+        fft_stage(stage);
+        if (++stage == SPECTRUM_STAGES)
+        {
+            state = SPECTRUM_POWER;
+        }
+        break;
+
+    case SPECTRUM_POWER:
+        for (uint32_t k = 0; k <= SPECTRUM_N / 2u; k++)
+        {
+            const int16_t *X = &work[2u * digit_reverse(k)];
+            uint32_t p = (uint32_t)((int32_t)X[0] * X[0]) + (uint32_t)((int32_t)X[1] * X[1]);
+            avg_power[k] = avg_power[k] - (avg_power[k] >> SPECTRUM_AVG_SHIFT)
+                         + (p >> SPECTRUM_AVG_SHIFT);
+        }
+        report.blocks++;
+        ready = 0;
+        state = SPECTRUM_IDLE;
+        break;
+
+    default:
+        state = SPECTRUM_IDLE;
+        break;
+    }
+    return 1;
+}
+
+uint32_t spectrum_power(uint16_t bin)
+{
+    return (bin <= SPECTRUM_N / 2u) ? avg_power[bin] : 0u;
+}
+
+void spectrum_get_report(spectrum_report_t * const r)
+{
+    uint16_t bm = report.bin_mark;
+    uint16_t bs = report.bin_space;
+    uint64_t sum = 0;
+    uint32_t n = 0;
+
+    // Suelo de ruido: media de los bins fuera de los lóbulos de los tonos
+    for (uint16_t k = 2; k < SPECTRUM_N / 2u; k++)
+    {
+        if ((k + 2u >= bm && k <= bm + 2u) || (k + 2u >= bs && k <= bs + 2u))
+        {
+            continue;
+        }
+        sum += avg_power[k];
+        n++;
+    }
+    uint32_t noise = (n > 0u) ? (uint32_t)(sum / n) : 0u;
+
+    // Potencia del tono: lóbulo principal de la ventana de Hann (3 bins)
+    uint32_t floor3 = 3u * noise + 1u;
+    uint32_t pm = (avg_power[bm - 1u] >> 2) + (avg_power[bm] >> 2) + (avg_power[bm + 1u] >> 2);
+    uint32_t ps = (avg_power[bs - 1u] >> 2) + (avg_power[bs] >> 2) + (avg_power[bs + 1u] >> 2);
+
+    report.noise = noise;
+    report.snr_mark = snr_db10(pm, floor3 >> 2);
+    report.snr_space = snr_db10(ps, floor3 >> 2);
+    *r = report;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file spectrum.h
+ * @date :2026/02/09 12:20:31
+ * @brief Monitor de espectro de la señal recibida (FFT radix-4 en punto fijo)
+ *
+ * Analizador en segundo plano para diagnosticar el enlace FSK:
+ * - Recoge bloques de SPECTRUM_N muestras decimadas de la recepción.
+ * - Aplica ventana de Hann y calcula una FFT radix-4 in situ en Q15,
+ *   escalando por 1/4 en cada etapa (la salida es X[k]/N).
+ * - Mantiene la potencia media por bin (media exponencial, 1/2^SPECTRUM_AVG_SHIFT).
+ * - Estima la SNR de los tonos de marca y espacio frente al suelo de ruido.
+ *
+ * El cálculo se divide en pasos cortos (ventana, cada etapa radix-4 y el
+ * cálculo de potencias). spectrum_run() ejecuta como mucho un paso por
+ * llamada, de modo que puede ejecutarse con los ciclos sobrantes del bucle
+ * principal sin retrasar las tareas de streaming de audio.
+ *
+ * @note spectrum_push() y spectrum_run() deben llamarse desde el mismo
+ *       contexto (bucle principal). Si llega un bloque completo mientras el
+ *       anterior aún se procesa, se descarta y se contabiliza.
+ */
+
+#ifndef _SPECTRUM_H_
+#define _SPECTRUM_H_
+
+#include <stdint.h>
+
+/** Puntos de la FFT (potencia de 4) */
+#define SPECTRUM_N          256u
+/** Número de etapas radix-4 (log4 N) */
+#define SPECTRUM_STAGES     4u
+/** Constante de tiempo de la media de potencias (bloques = 2^shift) */
+#define SPECTRUM_AVG_SHIFT  3u
+
+/**
+ * @struct spectrum_report_t
+ * @brief Resumen del estado del enlace
+ */
+typedef struct {
+    uint32_t blocks;        /**< Bloques procesados */
+    uint32_t dropped;       /**< Bloques descartados por falta de ciclos */
+    uint16_t bin_mark;      /**< Bin del tono de marca */
+    uint16_t bin_space;     /**< Bin del tono de espacio */
+    uint32_t noise;         /**< Potencia media de ruido por bin */
+    int16_t  snr_mark;      /**< SNR del tono de marca (décimas de dB) */
+    int16_t  snr_space;     /**< SNR del tono de espacio (décimas de dB) */
+} spectrum_report_t;
+
+/**
+ * @brief Inicializa el monitor de espectro
+ *
+ * Los bins de los tonos se limitan a 1..SPECTRUM_N/2-1: con un tono fuera
+ * de banda (fs_hz < 2 * FSK_SPACE_HZ) el informe mide el bin del borde.
+ *
+ * @param fs_hz Frecuencia de muestreo de las muestras que se entregarán (Hz)
+ */
+void spectrum_init(uint32_t fs_hz);
+
+/**
+ * @brief Entrega una muestra decimada al monitor
+ *
+ * @param x Muestra en Q15
+ */
+void spectrum_push(int16_t x);
+
+/**
+ * @brief Ejecuta un paso del análisis pendiente
+ *
+ * @return 1 si se ha ejecutado un paso, 0 si no había trabajo pendiente
+ */
+uint8_t spectrum_run(void);
+
+/**
+ * @brief Devuelve la potencia media de un bin
+ *
+ * @param bin Índice del bin (0..SPECTRUM_N/2)
+ * @return Potencia media (|X[k]|^2, escala Q30)
+ */
+uint32_t spectrum_power(uint16_t bin);
+
+/**
+ * @brief Calcula el resumen de SNR de los tonos FSK
+ *
+ * @param r Puntero a la estructura donde se guarda el resumen
+ */
+void spectrum_get_report(spectrum_report_t * const r);
+
+#endif  /* _SPECTRUM_H_ */
@@ -0,0 +1,198 @@
+/**
+ * @file timer_wheel.c
+ * @date :2026/03/02 10:41:07
+ * @brief Temporizadores software sobre una rueda jerárquica
+ *
+ * Ranura de un temporizador con vencimiento e y tick actual j:
+ * - nivel 0 si e - j < 64:      ranura e & 63
+ * - nivel n si e - j < 64^(n+1): ranura (e >> 6n) & 63
+ * Cuando el índice del nivel 0 vuelve a 0, la ranura actual del nivel 1 se
+ * reparte sobre el nivel 0, y así sucesivamente (cascada).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "timer_wheel.h"
+
+#define TW_BITS    6u                      /**< Bits por nivel */
+#define TW_SIZE    (1u << TW_BITS)         /**< Ranuras por nivel */
+#define TW_MASK    (TW_SIZE - 1u)
+#define TW_LEVELS  4u                      /**< Niveles */
+#define TW_RANGE   (1uL << (TW_BITS * TW_LEVELS))  /**< Alcance en ticks */
+
+static timer_node_t wheel[TW_LEVELS][TW_SIZE];   /**< Cabeceras de ranura */
+static uint64_t wheel_tick;                      /**< Siguiente tick a procesar */
+
+/**
+ * @brief Inserta un nodo al final de una lista
+ */
+static void list_add(timer_node_t *head, timer_node_t *n)
+{
+    n->prev = head->prev;
+    n->next = head;
+    head->prev->next = n;
+    head->prev = n;
+}
+
+/**
+ * @brief Extrae un nodo de su lista
+ */
+static void list_del(timer_node_t *n)
+{
+    n->prev->next = n->next;
+    n->next->prev = n->prev;
+    n->next = NULL;
+    n->prev = NULL;
+}
+
+/**
+ * @brief Mueve el contenido de una lista a otra (vacía)
+ */
+static void list_move(timer_node_t *from, timer_node_t *to)
+{
+    if (from->next == from)
+    {
+        to->next = to;
+        to->prev = to;
+        return;
+    }
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    from->next = from;
+    from->prev = from;
+}
+
+/**
+ * @brief Coloca un temporizador en la ranura que le corresponde
+ */
+static void wheel_add(sw_timer_t *t)
+{
+    uint64_t e = t->expires;
+    uint64_t delta = e - wheel_tick;
+    uint8_t level = 0;
+
+    if ((int64_t)delta < 0)
+    {
+        e = wheel_tick;                        // ya vencido: ranura actual
+    }
+    else
+    {
+        if (delta >= TW_RANGE)
+        {
+            e = wheel_tick + TW_RANGE - 1u;    // fuera de alcance: se reprograma
+            delta = TW_RANGE - 1u;
+        }
+        while (delta >= TW_SIZE)
+        {
+            delta >>= TW_BITS;
+            level++;
+        }
+    }
+    list_add(&wheel[level][(e >> (TW_BITS * level)) & TW_MASK], &t->node);
+}
+
+/**
+ * @brief Reparte la ranura actual de un nivel sobre los inferiores
+ *
+ * @return Índice de la ranura (0 -> hay que propagar al nivel siguiente)
+ */
+static uint8_t wheel_cascade(uint8_t level)
+{
+    uint8_t idx = (wheel_tick >> (TW_BITS * level)) & TW_MASK;
+    timer_node_t list;
+
+    list_move(&wheel[level][idx], &list);
+    while (list.next != &list)
+    {
+        sw_timer_t *t = (sw_timer_t *)list.next;
+        list_del(&t->node);
+        wheel_add(t);
+    }
+    return idx;
+}
+
+void timer_wheel_init(uint64_t now)
+{
+    for (uint8_t l = 0; l < TW_LEVELS; l++)
+    {
+        for (uint8_t i = 0; i < TW_SIZE; i++)
+        {
+            wheel[l][i].next = &wheel[l][i];
+            wheel[l][i].prev = &wheel[l][i];
+        }
+    }
+    wheel_tick = now + 1u;                     // now ya cuenta como procesado
+}
+
+void sw_timer_init(sw_timer_t * const t, sw_timer_cb_t callback, void *arg)
+{
+    t->node.next = NULL;
+    t->node.prev = NULL;
+    t->expires = 0;
+    t->period = 0;
+    t->callback = callback;
+    t->arg = arg;
+}
+
+void sw_timer_start(sw_timer_t * const t, uint32_t delay, uint32_t period)
+{
+    sw_timer_cancel(t);
+    // Relativo al último tick procesado; 0 equivale a 1 (siguiente tick)
+    t->expires = wheel_tick - 1u + ((delay != 0u) ? delay : 1u);
+    t->period = period;
+    wheel_add(t);
+}
+
+void sw_timer_cancel(sw_timer_t * const t)
+{
+    if (t->node.next != NULL)
+    {
+        list_del(&t->node);
+    }
+}
+
+uint8_t sw_timer_is_active(const sw_timer_t * const t)
+{
+    return t->node.next != NULL;
+}
+
+void timer_wheel_run(uint64_t now)
+{
+    while ((int64_t)(now - wheel_tick) >= 0)
+    {
+        uint8_t idx = wheel_tick & TW_MASK;
+        timer_node_t list;
+
+        // Cascada de los niveles superiores al completar una vuelta
+        for (uint8_t l = 1; (idx == 0u) && (l < TW_LEVELS); l++)
+        {
+            if (wheel_cascade(l) != 0u)
+            {
+                break;
+            }
+        }
+
+        // Vencidos: la ranura se separa antes de ejecutar callbacks, que
+        // pueden arrancar o cancelar temporizadores
+        list_move(&wheel[0][idx], &list);
+        wheel_tick++;
+        while (list.next != &list)
+        {
+            sw_timer_t *t = (sw_timer_t *)list.next;
+            list_del(&t->node);
+            if (t->expires >= wheel_tick)
+            {
+                wheel_add(t);                  // reprogramado al límite del alcance
+                continue;
+            }
+            if (t->period != 0u)
+            {
+                t->expires += t->period;
+                wheel_add(t);
+            }
+            t->callback(t, t->arg);
+        }
+    }
+}
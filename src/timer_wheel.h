@@ -0,0 +1,109 @@
+/**
+ * @file timer_wheel.h
+ * @date :2026/03/02 10:41:07
+ * @brief Temporizadores software sobre una rueda jerárquica
+ *
+ * Servicio de temporizadores de un disparo y periódicos con base de tiempos
+ * en ticks de SysTick (1 ms). Pensado para sustituir los contadores que cada
+ * módulo mantiene por su cuenta y las esperas activas:
+ * - Arrancar, cancelar y vencer un temporizador cuesta O(1).
+ * - El coste por tick no depende del número de temporizadores activos (solo
+ *   se recorre la ranura que vence), por lo que admite miles de ellos.
+ * - Sin memoria dinámica: el temporizador (sw_timer_t) lo reserva el usuario y
+ *   contiene los enlaces de la lista.
+ *
+ * Rueda de 4 niveles de 64 ranuras: el nivel 0 tiene resolución de 1 tick,
+ * el nivel n de 64^n ticks. Los temporizadores lejanos bajan de nivel
+ * (cascada) cuando la rueda inferior da la vuelta. Alcance directo de 2^24
+ * ticks (~4.6 h a 1 ms); los plazos mayores se reprograman al llegar al
+ * final del alcance.
+ *
+ * @note Las funciones de callback se ejecutan desde timer_wheel_run(), en el
+ *       contexto del bucle principal. El servicio no es reentrante: no debe
+ *       usarse desde ISR.
+ */
+
+#ifndef _TIMER_WHEEL_H_
+#define _TIMER_WHEEL_H_
+
+#include <stdint.h>
+
+/**
+ * @struct timer_node_t
+ * @brief Enlaces de lista doblemente enlazada (cabeceras de ranura)
+ */
+typedef struct timer_node {
+    struct timer_node *next;           /**< Siguiente */
+    struct timer_node *prev;           /**< Anterior */
+} timer_node_t;
+
+struct sw_timer;
+
+/** Función de callback: recibe el temporizador vencido y su argumento */
+typedef void (*sw_timer_cb_t)(struct sw_timer *t, void *arg);
+
+/**
+ * @struct sw_timer_t
+ * @brief Temporizador software
+ */
+typedef struct sw_timer {
+    timer_node_t node;                 /**< Enlaces (debe ser el primer campo) */
+    uint64_t expires;                  /**< Tick de vencimiento */
+    uint32_t period;                   /**< Periodo en ticks, 0 -> un disparo */
+    sw_timer_cb_t callback;            /**< Función a ejecutar al vencer */
+    void *arg;                         /**< Argumento de la función */
+} sw_timer_t;
+
+/**
+ * @brief Inicializa la rueda
+ *
+ * El tick now se da por procesado: un temporizador arrancado a continuación
+ * con retardo d vence en now + d.
+ *
+ * @param now Tick actual (SysTick_GetTick())
+ */
+void timer_wheel_init(uint64_t now);
+
+/**
+ * @brief Inicializa un temporizador (inactivo)
+ *
+ * @param t        Temporizador
+ * @param callback Función a ejecutar al vencer
+ * @param arg      Argumento de la función
+ */
+void sw_timer_init(sw_timer_t * const t, sw_timer_cb_t callback, void *arg);
+
+/**
+ * @brief Arranca (o rearranca) un temporizador
+ *
+ * @param t      Temporizador inicializado con sw_timer_init()
+ * @param delay  Ticks hasta el primer vencimiento (0 -> en el siguiente tick)
+ * @param period Periodo en ticks, 0 -> un disparo
+ */
+void sw_timer_start(sw_timer_t * const t, uint32_t delay, uint32_t period);
+
+/**
+ * @brief Cancela un temporizador (sin efecto si está inactivo)
+ *
+ * @param t Temporizador
+ */
+void sw_timer_cancel(sw_timer_t * const t);
+
+/**
+ * @brief Indica si un temporizador está en marcha
+ *
+ * @param t Temporizador
+ * @return 1 si está en marcha, 0 en caso contrario
+ */
+uint8_t sw_timer_is_active(const sw_timer_t * const t);
+
+/**
+ * @brief Procesa los ticks transcurridos hasta now y ejecuta los vencidos
+ *
+ * Si el llamante se ha retrasado varios ticks, se procesan todos en orden.
+ *
+ * @param now Tick actual (SysTick_GetTick())
+ */
+void timer_wheel_run(uint64_t now);
+
+#endif  /* _TIMER_WHEEL_H_ */
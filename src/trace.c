@@ -0,0 +1,40 @@
+/**
+ * @file trace.c
+ * @date :2026/03/19 10:12:40
+ * @brief Registro de eventos en RAM (traza binaria)
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+#include "trace.h"
+
+trace_t g_trace;
+
+void trace_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    g_trace.size = TRACE_SIZE;
+    g_trace.hz = SystemCoreClock;
+    g_trace.idx = 0;
+    g_trace.magic = TRACE_MAGIC;
+}
+
+uint16_t trace_last(trace_event_t *out, uint16_t n)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t idx = g_trace.idx;
+    uint32_t avail = (idx < TRACE_SIZE) ? idx : TRACE_SIZE;
+    if (n > avail)
+    {
+        n = (uint16_t)avail;
+    }
+    for (uint16_t i = 0; i < n; i++)
+    {
+        out[i] = g_trace.ev[(idx - n + i) & (TRACE_SIZE - 1u)];
+    }
+    __set_PRIMASK(primask);
+    return n;
+}
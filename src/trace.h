@@ -0,0 +1,116 @@
+/**
+ * @file trace.h
+ * @date :2026/03/19 10:12:40
+ * @brief Registro de eventos en RAM (traza binaria)
+ *
+ * Cada evento ocupa 8 bytes: marca de tiempo de 32 bits (DWT->CYCCNT),
+ * identificador de 16 bits y dato de 16 bits. Los eventos se guardan en un
+ * anillo que sobrescribe los más antiguos; trace() se puede llamar desde
+ * cualquier contexto (hilo, tarea o ISR) y se reduce a unas pocas
+ * instrucciones con las interrupciones deshabilitadas.
+ *
+ * Volcado: guardar g_trace completo desde el depurador, p.ej. en µVision
+ * @code
+ *   SAVE trace.hex &g_trace, ((char *)&g_trace) + sizeof(g_trace) - 1
+ * @endcode
+ * y convertirlo con tools/trace2vcd.py (VCD o JSON para Perfetto).
+ *
+ * Convención de identificadores (la usa el conversor, que lee esta
+ * cabecera): los pares NOMBRE_BEGIN / NOMBRE_END delimitan intervalos
+ * (el dato distingue instancias, p.ej. el índice de tarea); NOMBRE_VALUE
+ * registra el valor de una señal; el resto son eventos instantáneos.
+ */
+
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include <stdint.h>
+#include "mcu.h"
+
+/** Número de eventos del anillo (potencia de 2) */
+#define TRACE_SIZE  256u
+
+/**
+ * Traza de la ISR de I2S: se registra 1 de cada TRACE_I2S_DIV entradas (0 la
+ * quita). Cada ISR son 2 eventos y a 48 kHz el anillo completo cubriría solo
+ * 2.7 ms, expulsando los eventos de tareas y bits; con 48 queda una ISR por
+ * milisegundo.
+ */
+#ifndef TRACE_I2S_DIV
+#define TRACE_I2S_DIV  0u
+#endif
+
+/** Marca de validez de la cabecera ("TRC1") */
+#define TRACE_MAGIC 0x31435254u
+
+/**
+ * @brief Identificadores de evento
+ * @note Mantener los valores explícitos: tools/trace2vcd.py los lee de aquí.
+ */
+typedef enum {
+    TRACE_I2S_BEGIN = 1,      /**< Entrada en la ISR de I2S (con TRACE_I2S_DIV) */
+    TRACE_I2S_END = 2,        /**< Salida de la ISR de I2S (con TRACE_I2S_DIV) */
+    TRACE_TASK_BEGIN = 3,     /**< Inicio de tarea del planificador (dato: índice) */
+    TRACE_TASK_END = 4,       /**< Fin de tarea del planificador (dato: índice) */
+    TRACE_BIT_VALUE = 5,      /**< Bit demodulado (dato: 0/1) */
+    TRACE_SW2_VALUE = 6,      /**< Evento de SW2 (dato: 1 corta, 2 larga) */
+    TRACE_THREAD_VALUE = 7,   /**< Hilo en ejecución del ejecutivo (dato: índice, 0xFFFF idle) */
+    TRACE_USER = 0x100,       /**< Primer identificador libre para depuración */
+} trace_id_t;
+
+/**
+ * @struct trace_event_t
+ * @brief Evento de la traza (8 bytes)
+ */
+typedef struct {
+    uint32_t t;               /**< DWT->CYCCNT */
+    uint16_t id;              /**< trace_id_t */
+    uint16_t payload;         /**< Dato */
+} trace_event_t;
+
+/**
+ * @struct trace_t
+ * @brief Anillo de eventos con cabecera para el conversor
+ */
+typedef struct {
+    uint32_t magic;           /**< TRACE_MAGIC */
+    uint32_t size;            /**< TRACE_SIZE */
+    uint32_t hz;              /**< Frecuencia de CYCCNT (SystemCoreClock) */
+    uint32_t idx;             /**< Eventos escritos (el siguiente va en idx % size) */
+    trace_event_t ev[TRACE_SIZE];
+} trace_t;
+
+extern trace_t g_trace;
+
+/**
+ * @brief Vacía la traza y arranca el contador de ciclos
+ */
+void trace_init(void);
+
+/**
+ * @brief Devuelve los últimos eventos, del más antiguo al más reciente
+ *
+ * @param out Destino
+ * @param n   Número máximo de eventos
+ * @return Número de eventos copiados
+ */
+uint16_t trace_last(trace_event_t *out, uint16_t n);
+
+/**
+ * @brief Registra un evento
+ *
+ * @param id      Identificador (trace_id_t)
+ * @param payload Dato
+ */
+static inline void trace(uint16_t id, uint16_t payload)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    trace_event_t *e = &g_trace.ev[g_trace.idx++ & (TRACE_SIZE - 1u)];
+    e->t = DWT->CYCCNT;
+    e->id = id;
+    e->payload = payload;
+    __set_PRIMASK(primask);
+}
+
+#endif  /* _TRACE_H_ */
@@ -0,0 +1,93 @@
+/**
+ * @file wdt_sup.c
+ * @date :2026/03/23 09:40:12
+ * @brief Supervisor de tareas sobre el Hardware Watchdog
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+#include "wdt_sup.h"
+#include "HAL_FM4_hwwdt.h"
+#include "HAL_SysTick.h"
+
+volatile uint32_t g_wdt_sup_checkins[WDT_SUP_MAX];
+
+static const wdt_sup_task_t *sup_tasks;
+static wdt_sup_stats_t *sup_stats;
+static uint8_t sup_n;
+static uint32_t sup_last_poll;
+static volatile uint32_t sup_late;
+static uint32_t sup_last_feed;               // CYCCNT del último feed
+static uint32_t sup_max_feed;                // Mayor intervalo entre feeds (ciclos)
+
+void wdt_sup_init(const wdt_sup_task_t *tasks, wdt_sup_stats_t *stats, uint8_t n)
+{
+    uint32_t now = (uint32_t)SysTick_GetTick();
+
+    sup_tasks = tasks;
+    sup_stats = stats;
+    sup_n = (n > WDT_SUP_MAX) ? WDT_SUP_MAX : n;
+    sup_last_poll = now;
+    sup_late = 0;
+    sup_last_feed = DWT->CYCCNT;
+    sup_max_feed = 0;
+    for (uint8_t i = 0; i < sup_n; i++)
+    {
+        sup_stats[i].seen = g_wdt_sup_checkins[i];
+        sup_stats[i].last_ms = now;
+        sup_stats[i].max_gap_ms = 0;
+    }
+}
+
+void wdt_sup_poll(void)
+{
+    uint32_t now = (uint32_t)SysTick_GetTick();
+    if (now == sup_last_poll)
+    {
+        return;                              // una evaluación por tick
+    }
+    sup_last_poll = now;
+
+    uint32_t late = sup_late;
+    for (uint8_t i = 0; i < sup_n; i++)
+    {
+        wdt_sup_stats_t *st = &sup_stats[i];
+        uint32_t count = g_wdt_sup_checkins[i];
+        uint32_t gap = now - st->last_ms;
+        if (count != st->seen)
+        {
+            st->seen = count;
+            st->last_ms = now;
+            if (gap > st->max_gap_ms)
+            {
+                st->max_gap_ms = gap;
+            }
+        }
+        else if (gap > sup_tasks[i].window_ms)
+        {
+            late |= 1u << i;
+        }
+    }
+    sup_late = late;
+
+    if (late == 0u)
+    {
+        uint32_t t = DWT->CYCCNT;
+        if (t - sup_last_feed > sup_max_feed)
+        {
+            sup_max_feed = t - sup_last_feed;
+        }
+        sup_last_feed = t;
+        HWWDT_Feed(WDT_SUP_PATTERN, (uint8_t)~WDT_SUP_PATTERN);
+    }
+}
+
+uint32_t wdt_sup_late(void)
+{
+    return sup_late;
+}
+
+uint32_t wdt_sup_max_feed_us(void)
+{
+    return (uint32_t)(((uint64_t)sup_max_feed * 1000000u) / SystemCoreClock);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file wdt_sup.h
+ * @date :2026/03/23 09:40:12
+ * @brief Supervisor de tareas sobre el Hardware Watchdog
+ *
+ * Con un único HWWDT_Feed() en el bucle principal el watchdog solo prueba
+ * que el bucle gira. El supervisor condiciona el feed a que cada tarea
+ * vigilada (ISR, tarea del planificador o hilo) haya dado señales de vida
+ * dentro de su ventana:
+ * - La tarea llama a wdt_sup_checkin() cada vez que progresa. Es un
+ *   incremento de un contador propio de la tarea, válido en cualquier
+ *   contexto siempre que cada identificador se use desde un único contexto.
+ * - wdt_sup_poll(), desde el bucle principal, evalúa las ventanas una vez
+ *   por tick de SysTick (1 ms) y alimenta el HWWDT solo si ninguna tarea
+ *   se ha retrasado.
+ * - El retraso es permanente: la primera tarea que supera su ventana deja
+ *   de alimentar el HWWDT para siempre y su bit queda en wdt_sup_late(),
+ *   que la NMI guarda en el registro post-mortem (crash.h).
+ *
+ * Para cada tarea se registra además el mayor intervalo observado entre
+ * dos señales de vida (resolución de 1 ms), referencia para ajustar las
+ * ventanas, y para el HWWDT el mayor intervalo entre feeds medido con
+ * DWT->CYCCNT (wdt_sup_max_feed_us()), del que se deriva su periodo con
+ * HWWDT_US_TO_LOAD().
+ */
+
+#ifndef _WDT_SUP_H_
+#define _WDT_SUP_H_
+
+#include <stdint.h>
+
+/** Número máximo de tareas vigiladas */
+#define WDT_SUP_MAX      8u
+
+/** Patrón del feed del HWWDT (el segundo patrón es su inverso) */
+#define WDT_SUP_PATTERN  0xA5u
+
+/**
+ * @brief Tareas vigiladas (índice en la tabla de main.c)
+ */
+typedef enum {
+    WDT_SUP_I2S = 0,          /**< ISR de I2S */
+    WDT_SUP_AUDIO_RX = 1,     /**< Demodulador (task_audio_rx) */
+    WDT_SUP_PULSADOR = 2,     /**< Tarea del pulsador */
+} wdt_sup_id_t;
+
+/**
+ * @struct wdt_sup_task_t
+ * @brief Descriptor estático de una tarea vigilada
+ */
+typedef struct {
+    const char *name;          /**< Nombre (diagnóstico) */
+    uint16_t window_ms;        /**< Máximo intervalo entre señales de vida (ms) */
+} wdt_sup_task_t;
+
+/**
+ * @struct wdt_sup_stats_t
+ * @brief Estado y estadísticas de una tarea vigilada
+ */
+typedef struct {
+    uint32_t seen;             /**< Último valor del contador evaluado */
+    uint32_t last_ms;          /**< Tick de la última señal de vida */
+    uint32_t max_gap_ms;       /**< Mayor intervalo entre señales de vida */
+} wdt_sup_stats_t;
+
+/** Contadores de señales de vida, uno por tarea */
+extern volatile uint32_t g_wdt_sup_checkins[WDT_SUP_MAX];
+
+/**
+ * @brief Inicializa el supervisor
+ *
+ * @param tasks Tabla de tareas vigiladas (índice = wdt_sup_id_t)
+ * @param stats Array de estado, uno por tarea
+ * @param n     Número de tareas (<= WDT_SUP_MAX)
+ *
+ * @note Las ventanas empiezan a contar en esta llamada: llamar con las
+ *       interrupciones y el planificador ya configurados.
+ */
+void wdt_sup_init(const wdt_sup_task_t *tasks, wdt_sup_stats_t *stats, uint8_t n);
+
+/**
+ * @brief Evalúa las ventanas y alimenta el HWWDT si todas se cumplen
+ *
+ * Llamar continuamente desde el bucle principal.
+ */
+void wdt_sup_poll(void);
+
+/**
+ * @brief Tareas retrasadas
+ *
+ * @return Máscara de bits (bit i = tarea i), 0 si todas han cumplido
+ */
+uint32_t wdt_sup_late(void);
+
+/**
+ * @brief Mayor intervalo entre dos feeds del HWWDT desde wdt_sup_init()
+ *
+ * @return Intervalo en us
+ */
+uint32_t wdt_sup_max_feed_us(void);
+
+/**
+ * @brief Señal de vida de una tarea
+ *
+ * @param id Identificador (wdt_sup_id_t)
+ */
+static inline void wdt_sup_checkin(uint8_t id)
+{
+    g_wdt_sup_checkins[id]++;
+}
+
+#endif  /* _WDT_SUP_H_ */
@@ -0,0 +1,29 @@
+/**
+ * @file dds_stub.c
+ * @date :2026/04/14 10:21:37
+ * @brief DDS de 16 bits (dds.h) para las pruebas en el host
+ *
+ * 30319_shared.lib solo existe compilada para ARM. Mismo comportamiento:
+ * el acumulador avanza el incremento en cada muestra y la salida es el seno
+ * de la fase, a plena escala.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include "dds.h"
+
+void DDS16Bits_setPhase(dds16bits_t *p_dds, uint16_t phase)
+{
+    p_dds->phaseAccumulator = phase;
+}
+
+void DDS16Bits_setPhaseInc(dds16bits_t *p_dds, uint16_t phaseinc)
+{
+    p_dds->phaseIncrement = phaseinc;
+}
+
+int16_t DDS16Bits_getNextSample(dds16bits_t *p_dds)
+{
+    p_dds->phaseAccumulator += p_dds->phaseIncrement;
+    return (int16_t)lrint(32767.0 * sin(2.0 * M_PI * p_dds->phaseAccumulator / 65536.0));
+}
@@ -0,0 +1,34 @@
+/**
+ * @file fec_acs.h
+ * @date :2026/04/14 10:21:37
+ * @brief Funciones internas de fec.c para las pruebas en el host
+ *
+ * fec_scalar.c y fec_simd.c incluyen src/fec.c, sin y con
+ * __ARM_FEATURE_SIMD32 (intrínsecos en C de mcu.h), con sus funciones
+ * públicas renombradas fec_scalar_* y fec_simd_*, y exportan el ACS y la
+ * renormalización de cada versión para compararlas en el mismo programa.
+ */
+
+#ifndef _FEC_ACS_H_
+#define _FEC_ACS_H_
+
+#include <stdint.h>
+
+/**
+ * @brief viterbi_acs() y viterbi_renorm() de la versión escalar
+ */
+void fec_scalar_acs(const uint32_t *old, uint32_t *new, const uint32_t *bm, uint32_t *dec);
+uint32_t fec_scalar_renorm(uint32_t *w);
+
+/**
+ * @brief viterbi_acs() y viterbi_renorm() de la versión SIMD
+ */
+void fec_simd_acs(const uint32_t *old, uint32_t *new, const uint32_t *bm, uint32_t *dec);
+uint32_t fec_simd_renorm(uint32_t *w);
+
+/**
+ * @brief fec_viterbi_decode() de la versión SIMD
+ */
+int32_t fec_simd_viterbi_decode(const uint8_t *sym, uint32_t nbytes, uint8_t *data);
+
+#endif  /* _FEC_ACS_H_ */
@@ -0,0 +1,30 @@
+/**
+ * @file fec_simd.c
+ * @date :2026/04/14 10:21:37
+ * @brief fec.c compilado con __ARM_FEATURE_SIMD32 para las pruebas en el host
+ */
+
+#define __ARM_FEATURE_SIMD32 1
+
+#define fec_hamming74_encode     fec_simd_hamming74_encode
+#define fec_hamming74_decode     fec_simd_hamming74_decode
+#define fec_hamming_encode_byte  fec_simd_hamming_encode_byte
+#define fec_hamming_decode_byte  fec_simd_hamming_decode_byte
+#define fec_conv_encode          fec_simd_conv_encode
+#define fec_viterbi_decode       fec_simd_viterbi_decode
+#define fec_viterbi_start        fec_simd_viterbi_start
+#define fec_viterbi_step         fec_simd_viterbi_step
+#define fec_viterbi_finish       fec_simd_viterbi_finish
+
+#include "fec.c"
+#include "fec_acs.h"
+
+void fec_simd_acs(const uint32_t *old, uint32_t *new, const uint32_t *bm, uint32_t *dec)
+{
+    viterbi_acs(old, new, bm, dec);
+}
+
+uint32_t fec_simd_renorm(uint32_t *w)
+{
+    return viterbi_renorm(w);
+}
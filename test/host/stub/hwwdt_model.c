@@ -0,0 +1,127 @@
+/**
+ * @file hwwdt_model.c
+ * @date :2026/04/09 16:22:05
+ * @brief Modelo del Hardware Watchdog para las pruebas en el host
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "s6e2cc.h"
+#include "HAL_FM4_hwwdt.h"
+#include "hwwdt_model.h"
+
+#define CTL_INTEN     (1u << 0)
+#define CTL_RESEN     (1u << 1)
+#define LCK_LOCKED    1u               /**< Lectura de WDG_LCK bloqueado */
+#define ICL_NONE      0xFFFFFFFFu      /**< WDG_ICL sin escribir */
+
+FM4_HWWDT_TypeDef mcu_hwwdt;
+hwwdt_model_t g_hwwdt_model;
+
+static uint32_t ldr, ctl, count;       /**< Valores aceptados */
+
+static void hwwdt_model_publish(void)
+{
+    mcu_hwwdt.WDG_LDR = ldr;
+    mcu_hwwdt.WDG_CTL = ctl;
+    mcu_hwwdt.WDG_VLR = count;
+    mcu_hwwdt.WDG_ICL = ICL_NONE;
+    mcu_hwwdt.WDG_LCK = LCK_LOCKED;
+}
+
+void hwwdt_model_reset(void)
+{
+    memset(&g_hwwdt_model, 0, sizeof(g_hwwdt_model));
+    ldr = 0xFFFFu;
+    ctl = CTL_INTEN | CTL_RESEN;
+    count = ldr;
+    mcu_hwwdt.WDG_RIS = 0;
+    hwwdt_model_publish();
+}
+
+void hwwdt_model_sync(void)
+{
+    hwwdt_model_t *m = &g_hwwdt_model;
+    uint32_t lck = mcu_hwwdt.WDG_LCK;
+    uint8_t key1 = (lck == HWWDT_REG_UNLOCK_key1) || (lck == HWWDT_REG_UNLOCK_key2);
+    uint8_t key2 = (lck == HWWDT_REG_UNLOCK_key2);
+
+    if (mcu_hwwdt.WDG_LDR != ldr)
+    {
+        if (key1)
+        {
+            ldr = mcu_hwwdt.WDG_LDR;
+            count = ldr;
+        }
+        else
+        {
+            m->lock_errors++;
+        }
+    }
+    if (mcu_hwwdt.WDG_CTL != ctl)
+    {
+        if (key2)
+        {
+            uint32_t start = (mcu_hwwdt.WDG_CTL & ~ctl) & CTL_INTEN;
+            ctl = mcu_hwwdt.WDG_CTL & (CTL_INTEN | CTL_RESEN);
+            if (start)
+            {
+                count = ldr;
+            }
+        }
+        else
+        {
+            m->lock_errors++;
+        }
+    }
+    if (mcu_hwwdt.WDG_ICL != ICL_NONE)
+    {
+        if (key1)
+        {
+            mcu_hwwdt.WDG_RIS = 0;
+            count = ldr;
+            m->feeds++;
+            m->feed_tick = m->tick;
+        }
+        else
+        {
+            m->lock_errors++;
+        }
+    }
+    hwwdt_model_publish();
+}
+
+void hwwdt_model_tick(void)
+{
+    hwwdt_model_t *m = &g_hwwdt_model;
+
+    if (m->reset)
+    {
+        return;
+    }
+    hwwdt_model_sync();
+    m->tick++;
+    if ((ctl & CTL_INTEN) == 0u)
+    {
+        return;
+    }
+    if (--count == 0u)
+    {
+        count = ldr;
+        if (mcu_hwwdt.WDG_RIS & 1u)
+        {
+            if (ctl & CTL_RESEN)
+            {
+                m->reset = 1;
+                m->reset_tick = m->tick;
+            }
+        }
+        else
+        {
+            mcu_hwwdt.WDG_RIS = 1;
+            m->nmis++;
+            m->nmi_tick = m->tick;
+        }
+    }
+    mcu_hwwdt.WDG_VLR = count;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file hwwdt_model.h
+ * @date :2026/04/09 16:22:05
+ * @brief Modelo del Hardware Watchdog para las pruebas en el host
+ *
+ * Emula sobre FM4_HWWDT (mcu_hwwdt) la cuenta atrás a un ciclo de CLKLC por
+ * hwwdt_model_tick():
+ * - Solo cuenta con WDG_CTL.INTEN = 1. Arrancarlo, escribir WDG_LDR o
+ *   escribir WDG_ICL (feed) recarga el contador con WDG_LDR; el feed borra
+ *   además WDG_RIS.
+ * - Cuando el contador llega a 0 con WDG_RIS = 0: WDG_RIS = 1 (NMI) y
+ *   recarga. Si llega a 0 con WDG_RIS = 1 y WDG_CTL.RESEN = 1: reset. Así,
+ *   sin feeds, la NMI llega WDG_LDR ciclos después del último (feed_tick)
+ *   y el reset 2 x WDG_LDR ciclos después.
+ *
+ * Las escrituras del driver no se interceptan: el modelo las detecta al
+ * principio de cada tick (o en hwwdt_model_sync()) comparando con su copia.
+ * Se aceptan si el último valor escrito en WDG_LCK es la clave que exige el
+ * registro (key1 para LDR e ICL, key2 tras key1 para CTL); si no, se
+ * deshacen y se cuentan en lock_errors. Después WDG_LCK vuelve a leer 1
+ * (bloqueado). WDG_VLR y WDG_RIS son de solo lectura.
+ *
+ * Estado tras hwwdt_model_reset(), como tras un reset del FM4: contador en
+ * marcha con WDG_LDR = 0xFFFF y RESEN = 1 (SystemInit() lo para).
+ */
+
+#ifndef _HWWDT_MODEL_H_
+#define _HWWDT_MODEL_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Estado observable del modelo
+ */
+typedef struct {
+    uint64_t tick;            /**< Ciclos de CLKLC simulados */
+    uint32_t nmis;            /**< NMI generadas */
+    uint64_t nmi_tick;        /**< Tick de la última NMI */
+    uint8_t reset;            /**< 1 tras el reset por el HWWDT */
+    uint64_t reset_tick;      /**< Tick del reset */
+    uint32_t feeds;           /**< Feeds aceptados */
+    uint64_t feed_tick;       /**< Tick en que se aplicó el último feed */
+    uint32_t lock_errors;     /**< Escrituras rechazadas por el bloqueo */
+} hwwdt_model_t;
+
+extern hwwdt_model_t g_hwwdt_model;
+
+/**
+ * @brief Estado de reset del HWWDT y estadísticas a cero
+ */
+void hwwdt_model_reset(void);
+
+/**
+ * @brief Aplica las escrituras del driver desde la última llamada
+ */
+void hwwdt_model_sync(void);
+
+/**
+ * @brief Un ciclo de CLKLC (aplica antes las escrituras pendientes)
+ *
+ * @note Tras el reset por el HWWDT no hace nada hasta hwwdt_model_reset().
+ */
+void hwwdt_model_tick(void);
+
+#endif  /* _HWWDT_MODEL_H_ */
@@ -0,0 +1,249 @@
+/**
+ * @file i2c_model.c
+ * @date :2026/04/15 17:05:12
+ * @brief Modelo de MFS2 en modo I2C con un WM8731 como esclavo, para las
+ *        pruebas en el host
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "mcu.h"
+#include "HAL_FM4_i2c.h"
+#include "HAL_FM4_dtimer.h"
+#include "i2c_model.h"
+
+// Bits de IBCR/IBSR (hal/src/HAL_FM4_i2c.c)
+#define IBCR_MSS   0x80u
+#define IBCR_ACKE  0x20u
+#define IBCR_CNDE  0x08u
+#define IBCR_INTE  0x04u
+#define IBCR_BER   0x02u
+#define IBCR_INT   0x01u
+#define IBSR_RACK  0x40u
+#define IBSR_AL    0x08u
+#define IBSR_SPC   0x02u
+
+#define WM8731_RESET_REG  15u
+
+void MFS2_TX_IRQHandler(void);
+
+i2c_model_t g_i2c_model;
+
+/** Valores de reset de R0-R9 del WM8731 */
+static const uint16_t wm8731_reset_value[10] = {
+    0x097, 0x097, 0x079, 0x079, 0x00A, 0x008, 0x09F, 0x00A, 0x000, 0x000
+};
+
+/* ---------------------------------------------------------------- DTIM -- */
+
+void DTIM_Init(void)
+{
+}
+
+int8_t DTIM_AlarmStart(dtim_alarm_t * const a, uint32_t us, dtim_cb_t callback, void *arg)
+{
+    a->deadline = g_i2c_model.now_us + us;
+    a->callback = callback;
+    a->arg = arg;
+    a->pending = 1;
+    g_i2c_model.alarm = a;
+    g_i2c_model.alarm_starts++;
+    return 0;
+}
+
+void DTIM_AlarmCancel(dtim_alarm_t * const a)
+{
+    a->pending = 0;
+}
+
+/* -------------------------------------------------------------- WM8731 -- */
+
+static void wm8731_reset(void)
+{
+    memcpy(g_i2c_model.wm8731_reg, wm8731_reset_value, sizeof(wm8731_reset_value));
+}
+
+/**
+ * @brief El esclavo recibe un byte; devuelve 1 si lo reconoce
+ */
+static uint8_t wm8731_byte(uint8_t n, uint8_t b)
+{
+    i2c_model_t *m = &g_i2c_model;
+
+    if (n == 0u)
+    {
+        m->addressed = ((b >> 1) == I2C_MODEL_WM8731_ADDR) && ((b & 1u) == 0u);
+        m->rx_n = 0;
+        return m->addressed;
+    }
+    if (!m->addressed || (m->rx_n >= sizeof(m->rx)))
+    {
+        return 0;
+    }
+    m->rx[m->rx_n++] = b;
+    return 1;
+}
+
+/**
+ * @brief STOP: el WM8731 escribe las palabras completas recibidas
+ */
+static void wm8731_stop(void)
+{
+    i2c_model_t *m = &g_i2c_model;
+
+    if (!m->addressed)
+    {
+        return;
+    }
+    for (uint8_t i = 0; i + 1u < m->rx_n; i += 2u)
+    {
+        uint8_t reg = m->rx[i] >> 1;
+        if (reg < 16u)
+        {
+            m->wm8731_reg[reg] = (uint16_t)(((m->rx[i] & 1u) << 8) | m->rx[i + 1u]);
+            m->wm8731_writes++;
+        }
+        if (reg == WM8731_RESET_REG)
+        {
+            wm8731_reset();
+            m->wm8731_resets++;
+        }
+    }
+}
+
+/* ---------------------------------------------------------------- MFS2 -- */
+
+void i2c_model_reset(i2c_fault_t fault, uint8_t at)
+{
+    uint32_t now_us = g_i2c_model.now_us;
+    dtim_alarm_t *alarm = g_i2c_model.alarm;
+
+    memset(&g_i2c_model, 0, sizeof(g_i2c_model));
+    g_i2c_model.now_us = now_us;
+    g_i2c_model.alarm = alarm;
+    g_i2c_model.fault = fault;
+    g_i2c_model.fault_at = at;
+    wm8731_reset();
+}
+
+void i2c_model_mcu_reset(void)
+{
+    if (g_i2c_model.busy)
+    {
+        g_i2c_model.busy = 0;
+        g_i2c_model.aborts++;                     // sin STOP: el esclavo la descarta
+    }
+    g_i2c_model.alarm = 0;
+    memset(&mcu_mfs2, 0, sizeof(mcu_mfs2));
+    bFM4_MFS2_I2C_IBSR_SPC = 0u;
+}
+
+void i2c_model_step(void)
+{
+    FM4_MFS_I2C_TypeDef *r = FM4_MFS2;
+    i2c_model_t *m = &g_i2c_model;
+
+    if ((r->IBSR & IBSR_SPC) && (bFM4_MFS2_I2C_IBSR_SPC == 0u))
+    {
+        r->IBSR &= (uint8_t)~IBSR_SPC;            // borrado por el alias de bit-band
+    }
+    if (!m->busy && (r->IBSR & IBSR_SPC))
+    {
+        return;
+    }
+
+    if ((r->IBCR & IBCR_MSS) && !(r->IBCR & IBCR_INT))
+    {
+        if (m->busy && !(r->IBCR & IBCR_ACKE))
+        {
+            m->aborts++;                          // abandono y nueva transacción
+            m->busy = 0;
+        }
+        if (m->busy && m->fault == FAULT_STALL && m->n == m->fault_at)
+        {
+            return;                               // SCL retenido por el esclavo
+        }
+        if (!m->busy)
+        {
+            m->busy = 1;                          // START
+            m->n = 0;
+            m->addressed = 0;
+        }
+        r->IBSR &= (uint8_t)~(IBSR_RACK | IBSR_AL);
+        i2c_fault_t fault = (m->n == m->fault_at) ? m->fault : FAULT_NONE;
+        if (fault != FAULT_NONE)
+        {
+            m->fault = FAULT_NONE;                // un solo fallo por prueba
+        }
+        if (fault == FAULT_BER || fault == FAULT_AL)
+        {
+            if (fault == FAULT_BER)
+            {
+                r->IBCR |= IBCR_BER | IBCR_INT;
+            }
+            else
+            {
+                r->IBSR |= IBSR_AL;
+                r->IBCR = (uint8_t)((r->IBCR & ~IBCR_MSS) | IBCR_INT);   // pasa a esclavo
+            }
+            m->busy = 0;
+            m->aborts++;
+            return;
+        }
+        uint8_t ack = (fault != FAULT_NACK) && wm8731_byte(m->n, (uint8_t)r->TDR);
+        m->n++;
+        if (!ack)
+        {
+            r->IBSR |= IBSR_RACK;
+        }
+        r->IBCR |= IBCR_INT;
+        m->now_us += I2C_MODEL_BYTE_US;
+    }
+    else if (m->busy && !(r->IBCR & IBCR_MSS))
+    {
+        m->busy = 0;
+        if (r->IBCR & IBCR_CNDE)
+        {
+            wm8731_stop();
+            m->frames++;
+            r->IBSR |= IBSR_SPC;
+            bFM4_MFS2_I2C_IBSR_SPC = 1u;
+        }
+        else
+        {
+            m->aborts++;                          // IBCR = 0: abandono
+        }
+    }
+}
+
+uint8_t i2c_model_irq(void)
+{
+    FM4_MFS_I2C_TypeDef *r = FM4_MFS2;
+    return (r->IBCR & IBCR_INTE) &&
+           ((r->IBCR & IBCR_INT) || ((r->IBSR & IBSR_SPC) && (r->IBCR & IBCR_CNDE)));
+}
+
+void i2c_model_run(uint32_t max_us)
+{
+    i2c_model_t *m = &g_i2c_model;
+    uint32_t end = m->now_us + max_us;
+
+    while (I2C_busy() && m->now_us < end)
+    {
+        i2c_model_step();
+        if (i2c_model_irq())
+        {
+            MFS2_TX_IRQHandler();
+        }
+        else if (m->alarm != 0 && m->alarm->pending && (int32_t)(m->now_us - m->alarm->deadline) >= 0)
+        {
+            m->alarm->pending = 0;
+            m->alarm->callback(m->alarm, m->alarm->arg);
+        }
+        else
+        {
+            m->now_us++;
+        }
+    }
+    i2c_model_step();                             // borra SPC tras la última
+}
@@ -0,0 +1,96 @@
+/**
+ * @file i2c_model.h
+ * @date :2026/04/15 17:05:12
+ * @brief Modelo de MFS2 en modo I2C con un WM8731 como esclavo, para las
+ *        pruebas en el host
+ *
+ * Registro a registro sobre FM4_MFS2 (mcu_mfs2), con el WM8731 en 0x1A
+ * (palabras de 16 bits: 7 bits de registro y 9 de dato):
+ * - IBCR.MSS = 1 con IBCR.INT = 0: transmite TDR, pone IBSR.RACK según el
+ *   ACK del esclavo y IBCR.INT. El byte lleva START si el bus está libre o
+ *   si IBCR.ACKE = 0: el driver escribe MSS sin ACKE solo al arrancar, y en
+ *   el host no se ve el IBCR = 0 intermedio de un abandono seguido de la
+ *   siguiente transacción.
+ * - IBCR.MSS = 0 con IBCR.CNDE y el bus ocupado: STOP, IBSR.SPC. El WM8731
+ *   escribe entonces las palabras completas; la escritura de R15 (reset)
+ *   devuelve R0-R9 a sus valores de reset.
+ * - IBCR.MSS = 0 sin CNDE, error de bus o pérdida de arbitraje: la trama se
+ *   abandona sin STOP y el esclavo la descarta.
+ * - Línea de interrupción: INTE y (INT o SPC con CNDE).
+ * Fallos inyectables (uno por prueba): NACK en un byte, error de bus,
+ * pérdida de arbitraje y bus bloqueado hasta que la prueba lo libera (vence
+ * el timeout de la alarma, aquí simulada con el tiempo del bus).
+ *
+ * También sustituye al Dual Timer (DTIM_AlarmStart() y compañía): cada
+ * i2c_start() del driver arma una alarma, así que alarm_starts cuenta los
+ * START pedidos, uno por trama.
+ *
+ * Los registros del WM8731 solo cambian por I2C: sobreviven a
+ * i2c_model_mcu_reset(), igual que el códec real sobrevive al reset del MCU.
+ */
+
+#ifndef _I2C_MODEL_H_
+#define _I2C_MODEL_H_
+
+#include <stdint.h>
+#include "HAL_FM4_dtimer.h"
+
+#define I2C_MODEL_WM8731_ADDR  0x1Au
+#define I2C_MODEL_BYTE_US      25u    /**< 9 bits a 400 kbit/s, redondeado */
+
+typedef enum { FAULT_NONE, FAULT_NACK, FAULT_BER, FAULT_AL, FAULT_STALL } i2c_fault_t;
+
+/**
+ * @brief Estado observable del modelo
+ */
+typedef struct {
+    uint32_t now_us;              /**< Tiempo del bus */
+    dtim_alarm_t *alarm;          /**< Última alarma armada */
+    uint32_t alarm_starts;        /**< Alarmas armadas (START pedidos) */
+    uint8_t busy;                 /**< START enviado, sin STOP */
+    uint8_t n;                    /**< Bytes transmitidos en la trama */
+    uint8_t addressed;            /**< El WM8731 ha reconocido su dirección */
+    uint8_t rx[8];                /**< Bytes de datos reconocidos por el esclavo */
+    uint8_t rx_n;
+    i2c_fault_t fault;            /**< Fallo a inyectar... */
+    uint8_t fault_at;             /**< ...en este byte de la trama (0 dirección) */
+    uint32_t frames;              /**< Tramas terminadas con STOP */
+    uint32_t aborts;              /**< Tramas abandonadas sin STOP */
+    uint16_t wm8731_reg[16];      /**< Registros del WM8731 */
+    uint32_t wm8731_writes;       /**< Palabras escritas en el WM8731 */
+    uint32_t wm8731_resets;       /**< Escrituras de R15 */
+} i2c_model_t;
+
+extern i2c_model_t g_i2c_model;
+
+/**
+ * @brief Bus libre, WM8731 con sus valores de reset y estadísticas a cero
+ *
+ * @param fault Fallo a inyectar
+ * @param at    Byte de la trama en que se inyecta (0 dirección)
+ */
+void i2c_model_reset(i2c_fault_t fault, uint8_t at);
+
+/**
+ * @brief Reset del MCU: MFS2 a cero y la trama en curso se abandona; el
+ *        WM8731 conserva sus registros
+ */
+void i2c_model_mcu_reset(void);
+
+/**
+ * @brief Avanza el periférico un paso según lo que ha escrito el driver
+ */
+void i2c_model_step(void);
+
+/**
+ * @brief Estado de la línea de interrupción de MFS2
+ */
+uint8_t i2c_model_irq(void);
+
+/**
+ * @brief Ejecuta el bus, la ISR de MFS2 y la alarma hasta que la cola del
+ *        driver queda vacía o pasa max_us
+ */
+void i2c_model_run(uint32_t max_us);
+
+#endif  /* _I2C_MODEL_H_ */
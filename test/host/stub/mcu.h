@@ -0,0 +1,160 @@
+/**
+ * @file mcu.h
+ * @date :2026/04/06 09:12:48
+ * @brief Sustituto de mcu.h para las pruebas en el host
+ *
+ * Periféricos del núcleo (SCB, DWT, CoreDebug, SysTick) como estructuras en
+ * RAM, y NVIC e intrínsecos CMSIS como funciones que registran su efecto
+ * (mcu_stub.c). Los intrínsecos SIMD, en C, para probar la versión
+ * __ARM_FEATURE_SIMD32 de fec.c. Los periféricos del dispositivo están en s6e2cc.h. La prueba
+ * lee y escribe los registros directamente.
+ */
+
+#ifndef _MCU_H_
+#define _MCU_H_
+
+#include <stdint.h>
+#include "s6e2cc.h"
+#include "system_s6e2cc.h"
+
+#define __NVIC_PRIO_BITS  4u
+
+typedef struct {
+    volatile uint32_t CPUID, ICSR, VTOR, AIRCR, SCR, CCR;
+    volatile uint8_t  SHP[12];
+    volatile uint32_t SHCSR, CFSR, HFSR, DFSR, MMFAR, BFAR, AFSR;
+} SCB_Type;
+
+typedef struct {
+    volatile uint32_t CTRL, CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DHCSR, DCRSR, DCRDR, DEMCR;
+} CoreDebug_Type;
+
+typedef struct {
+    volatile uint32_t CTRL, LOAD, VAL, CALIB;
+} SysTick_Type;
+
+extern SCB_Type mcu_scb;
+extern DWT_Type mcu_dwt;
+extern CoreDebug_Type mcu_coredebug;
+extern SysTick_Type mcu_systick;
+
+#define SCB        (&mcu_scb)
+#define DWT        (&mcu_dwt)
+#define CoreDebug  (&mcu_coredebug)
+#define SysTick    (&mcu_systick)
+
+#define SCB_ICSR_PENDSVSET_Msk       (1u << 28)
+#define SCB_ICSR_PENDSTSET_Msk       (1u << 26)
+#define SCB_SHCSR_USGFAULTENA_Msk    (1u << 18)
+#define SCB_SHCSR_BUSFAULTENA_Msk    (1u << 17)
+#define SCB_SHCSR_MEMFAULTENA_Msk    (1u << 16)
+#define CoreDebug_DEMCR_TRCENA_Msk   (1u << 24)
+#define DWT_CTRL_CYCCNTENA_Msk       (1u << 0)
+#define SysTick_CTRL_ENABLE_Msk      (1u << 0)
+#define SysTick_CTRL_TICKINT_Msk     (1u << 1)
+#define SysTick_CTRL_CLKSOURCE_Msk   (1u << 2)
+#define SysTick_CTRL_COUNTFLAG_Msk   (1u << 16)
+#define SysTick_LOAD_RELOAD_Msk      0xFFFFFFu
+#define CONTROL_SPSEL_Msk            (1u << 1)
+
+/** Estado de las interrupciones simuladas */
+extern uint32_t mcu_primask;
+extern uint8_t mcu_irq_enabled[MCU_STUB_IRQ_N];
+extern uint8_t mcu_irq_pending[MCU_STUB_IRQ_N];
+extern uint8_t mcu_system_reset;   /**< NVIC_SystemReset() llamado */
+extern void (*mcu_irq_hook)(void); /**< ISR simulada al (des)enmascarar */
+
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+uint32_t __get_IPSR(void);
+uint32_t __get_MSP(void);
+void __set_MSP(uint32_t msp);
+void __set_PSP(uint32_t psp);
+uint32_t __get_CONTROL(void);
+void __set_CONTROL(uint32_t control);
+void __ISB(void);
+void __DSB(void);
+void __NOP(void);
+void __WFI(void);
+
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+uint32_t NVIC_GetEnableIRQ(IRQn_Type irq);
+void NVIC_SetPendingIRQ(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+uint32_t NVIC_GetPendingIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+void NVIC_SystemReset(void);
+
+/**
+ * Intrínsecos SIMD de 8 bits del Cortex-M4 (versión C). __USUB8 deja los
+ * flags GE de cada byte en mcu_apsr_ge y __SEL los lee.
+ */
+extern uint32_t mcu_apsr_ge;
+
+static inline uint32_t __UQADD8(uint32_t a, uint32_t b)
+{
+    uint32_t r = 0;
+    for (uint32_t k = 0; k < 32u; k += 8u)
+    {
+        uint32_t s = ((a >> k) & 0xFFu) + ((b >> k) & 0xFFu);
+        r |= ((s > 0xFFu) ? 0xFFu : s) << k;
+    }
+    return r;
+}
+
+static inline uint32_t __UQSUB8(uint32_t a, uint32_t b)
+{
+    uint32_t r = 0;
+    for (uint32_t k = 0; k < 32u; k += 8u)
+    {
+        uint32_t x = (a >> k) & 0xFFu, y = (b >> k) & 0xFFu;
+        r |= ((x > y) ? x - y : 0u) << k;
+    }
+    return r;
+}
+
+static inline uint32_t __USUB8(uint32_t a, uint32_t b)
+{
+    uint32_t r = 0;
+    mcu_apsr_ge = 0;
+    for (uint32_t k = 0; k < 32u; k += 8u)
+    {
+        uint32_t x = (a >> k) & 0xFFu, y = (b >> k) & 0xFFu;
+        r |= ((x - y) & 0xFFu) << k;
+        mcu_apsr_ge |= ((x >= y) ? 1u : 0u) << (k / 8u);
+    }
+    return r;
+}
+
+static inline uint32_t __SEL(uint32_t a, uint32_t b)
+{
+    uint32_t r = 0;
+    for (uint32_t k = 0; k < 4u; k++)
+    {
+        r |= (((mcu_apsr_ge >> k) & 1u) ? a : b) & (0xFFu << (8u * k));
+    }
+    return r;
+}
+
+static inline uint32_t __UXTB16(uint32_t x)
+{
+    return x & 0x00FF00FFu;
+}
+
+static inline uint32_t __ROR(uint32_t x, uint32_t n)
+{
+    n &= 31u;
+    return (n == 0u) ? x : ((x >> n) | (x << (32u - n)));
+}
+
+#define __PKHBT(a, b, s)  (((uint32_t)(a) & 0x0000FFFFu) | (((uint32_t)(b) << (s)) & 0xFFFF0000u))
+#define __PKHTB(a, b, s)  (((uint32_t)(a) & 0xFFFF0000u) | (((uint32_t)(b) >> (s)) & 0x0000FFFFu))
+
+#endif  /* _MCU_H_ */
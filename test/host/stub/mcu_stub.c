@@ -0,0 +1,91 @@
+/**
+ * @file mcu_stub.c
+ * @date :2026/04/06 09:12:48
+ * @brief Registros del núcleo e intrínsecos CMSIS para las pruebas en el host
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+
+SCB_Type mcu_scb;
+DWT_Type mcu_dwt;
+CoreDebug_Type mcu_coredebug;
+SysTick_Type mcu_systick;
+uint32_t SystemCoreClock = 200000000u;
+
+uint32_t mcu_primask;
+uint8_t mcu_irq_enabled[MCU_STUB_IRQ_N];
+uint8_t mcu_irq_pending[MCU_STUB_IRQ_N];
+uint8_t mcu_system_reset;
+uint32_t mcu_apsr_ge;
+void (*mcu_irq_hook)(void);
+
+static uint32_t mcu_ipsr, mcu_msp, mcu_psp, mcu_control;
+
+/*
+ * mcu_irq_hook, si la prueba lo pone, hace de ISR: se ejecuta justo antes de
+ * enmascarar y justo después de desenmascarar, los dos puntos en que una
+ * interrupción puede colarse alrededor de una sección crítica.
+ */
+void __disable_irq(void)
+{
+    if ((mcu_primask == 0u) && (mcu_irq_hook != 0))
+    {
+        mcu_irq_hook();
+    }
+    mcu_primask = 1;
+}
+void __enable_irq(void)
+{
+    mcu_primask = 0;
+    if (mcu_irq_hook != 0)
+    {
+        mcu_irq_hook();
+    }
+}
+uint32_t __get_PRIMASK(void) { return mcu_primask; }
+void __set_PRIMASK(uint32_t primask)
+{
+    mcu_primask = primask;
+    if ((primask == 0u) && (mcu_irq_hook != 0))
+    {
+        mcu_irq_hook();
+    }
+}
+uint32_t __get_IPSR(void) { return mcu_ipsr; }
+uint32_t __get_MSP(void) { return mcu_msp; }
+void __set_MSP(uint32_t msp) { mcu_msp = msp; }
+void __set_PSP(uint32_t psp) { mcu_psp = psp; }
+uint32_t __get_CONTROL(void) { return mcu_control; }
+void __set_CONTROL(uint32_t control) { mcu_control = control; }
+void __ISB(void) {}
+void __DSB(void) {}
+void __NOP(void) {}
+void __WFI(void) {}
+
+void NVIC_EnableIRQ(IRQn_Type irq) { if (irq >= 0) mcu_irq_enabled[irq] = 1; }
+void NVIC_DisableIRQ(IRQn_Type irq) { if (irq >= 0) mcu_irq_enabled[irq] = 0; }
+uint32_t NVIC_GetEnableIRQ(IRQn_Type irq) { return (irq >= 0) ? mcu_irq_enabled[irq] : 0u; }
+void NVIC_SetPendingIRQ(IRQn_Type irq) { if (irq >= 0) mcu_irq_pending[irq] = 1; }
+void NVIC_ClearPendingIRQ(IRQn_Type irq) { if (irq >= 0) mcu_irq_pending[irq] = 0; }
+uint32_t NVIC_GetPendingIRQ(IRQn_Type irq) { return (irq >= 0) ? mcu_irq_pending[irq] : 0u; }
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { (void)irq; (void)priority; }
+void NVIC_SystemReset(void) { mcu_system_reset = 1; }
+
+FM4_MFS_I2C_TypeDef mcu_mfs2;
+FM4_GPIO_TypeDef mcu_gpio;
+FM4_EXTI_TypeDef mcu_exti;
+FM4_CRG_TypeDef mcu_crg;
+FM4_I2S_TypeDef mcu_i2s0;
+
+volatile uint32_t bFM4_MFS2_I2C_ISMK_EN, bFM4_MFS2_I2C_IBSR_SPC;
+volatile uint32_t bFM4_MFS2_I2C_SMR_RIE, bFM4_MFS2_I2C_SMR_TIE;
+volatile uint32_t bFM4_GPIO_EPFR07_SCK2B1, bFM4_GPIO_EPFR07_SOT2B1;
+volatile uint32_t bFM4_GPIO_PFR3_PA, bFM4_GPIO_PFR3_PB;
+volatile uint32_t bFM4_GPIO_ADE_AN08, bFM4_GPIO_ADE_AN10, bFM4_GPIO_ADE_AN18;
+volatile uint32_t bFM4_GPIO_PFR1_P8, bFM4_GPIO_PFR1_PA, bFM4_GPIO_PFRB_P2;
+volatile uint32_t bFM4_GPIO_PFR6_PE, bFM4_GPIO_PFR2_P0;
+volatile uint32_t bFM4_GPIO_PDOR1_P8, bFM4_GPIO_PDOR1_PA, bFM4_GPIO_PDORB_P2;
+volatile uint32_t bFM4_GPIO_PDOR6_PE, bFM4_GPIO_PDIR2_P0;
+volatile uint32_t bFM4_GPIO_DDR1_P8, bFM4_GPIO_DDR1_PA, bFM4_GPIO_DDRB_P2;
+volatile uint32_t bFM4_GPIO_DDR6_PE, bFM4_GPIO_DDR2_P0;
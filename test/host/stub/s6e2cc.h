@@ -0,0 +1,119 @@
+/**
+ * @file s6e2cc.h
+ * @date :2026/04/08 12:30:05
+ * @brief Sustituto de la cabecera del dispositivo para las pruebas en el host
+ *
+ * Solo los registros que usan los módulos probados, con los mismos nombres
+ * que la cabecera de Cypress. Los alias de bit-band son variables: el modelo
+ * de cada periférico (en la prueba) interpreta lo que escribe el driver.
+ */
+
+#ifndef _S6E2CC_H_
+#define _S6E2CC_H_
+
+#include <stdint.h>
+
+/** Números del stub: solo indexan mcu_irq_enabled/mcu_irq_pending */
+typedef enum {
+    NonMaskableInt_IRQn = -14,
+    HardFault_IRQn = -13,
+    PendSV_IRQn = -2,
+    SysTick_IRQn = -1,
+    EXINT5_IRQn = 8,
+    MFS2_TX_IRQn = 12,
+    MCU_STUB_IRQ_N = 128           /**< Interrupciones de periféricos 0..127 */
+} IRQn_Type;
+
+/** MFS en modo I2C */
+typedef struct {
+    volatile uint8_t SMR, SCR, IBCR, IBSR;
+    union {
+        volatile uint16_t RDR;
+        volatile uint16_t TDR;
+    };
+    volatile uint16_t BGR;
+    volatile uint8_t ISBA, ISMK;
+} FM4_MFS_I2C_TypeDef;
+
+/**
+ * GPIO (campos usados). HAL_FM4_gpio.c indexa DDRx, PDIRx y PDORx desde el
+ * registro del puerto 0, así que cada banco son 16 palabras seguidas.
+ */
+typedef struct {
+    struct { volatile uint32_t PA : 1; } PZR3_f;
+    volatile uint32_t EPFR06;
+    volatile uint32_t ADE;
+    volatile uint32_t DDR0, DDR1, DDR2, DDR3, DDR4, DDR5, DDR6, DDR7,
+                      DDR8, DDR9, DDRA, DDRB, DDRC, DDRD, DDRE, DDRF;
+    volatile uint32_t PDIR0, PDIR1, PDIR2, PDIR3, PDIR4, PDIR5, PDIR6, PDIR7,
+                      PDIR8, PDIR9, PDIRA, PDIRB, PDIRC, PDIRD, PDIRE, PDIRF;
+    volatile uint32_t PDOR0, PDOR1, PDOR2, PDOR3, PDOR4, PDOR5, PDOR6, PDOR7,
+                      PDOR8, PDOR9, PDORA, PDORB, PDORC, PDORD, PDORE, PDORF;
+} FM4_GPIO_TypeDef;
+
+/** Interrupciones externas */
+typedef struct {
+    volatile uint32_t ENIR, EIRR, EICL, ELVR;
+} FM4_EXTI_TypeDef;
+
+/** Hardware Watchdog (modelo en hwwdt_model.c) */
+typedef struct {
+    volatile uint32_t WDG_LDR, WDG_VLR, WDG_CTL, WDG_ICL, WDG_RIS, WDG_LCK;
+} FM4_HWWDT_TypeDef;
+
+/** Campos de RST_STR (manual del FM4: bit 2 reservado) */
+typedef struct {
+    volatile uint16_t PONR : 1;
+    volatile uint16_t INITX : 1;
+    uint16_t RESERVED0 : 1;
+    volatile uint16_t LVDH : 1;
+    volatile uint16_t SWDR : 1;
+    volatile uint16_t HWDR : 1;
+    volatile uint16_t CSVR : 1;
+    volatile uint16_t FCSR : 1;
+    volatile uint16_t SRST : 1;
+} stc_crg_rst_str_field_t;
+
+/** Reloj y reset (solo RST_STR) */
+typedef struct {
+    union {
+        volatile uint16_t RST_STR;
+        stc_crg_rst_str_field_t RST_STR_f;
+    };
+} FM4_CRG_TypeDef;
+
+/** I2S (campos que escribe FM4_WM8731.c) */
+typedef struct {
+    struct { volatile uint32_t RXENB : 1; volatile uint32_t TXENB : 1; } OPRREG_f;
+    struct { volatile uint32_t RXDIS : 1; volatile uint32_t TXDIS : 1; } CNTREG_f;
+    struct { volatile uint32_t RFTH : 4; volatile uint32_t TFTH : 4; } INTCNT_f;
+} FM4_I2S_TypeDef;
+
+extern FM4_MFS_I2C_TypeDef mcu_mfs2;
+extern FM4_GPIO_TypeDef mcu_gpio;
+extern FM4_EXTI_TypeDef mcu_exti;
+extern FM4_HWWDT_TypeDef mcu_hwwdt;
+extern FM4_CRG_TypeDef mcu_crg;
+extern FM4_I2S_TypeDef mcu_i2s0;
+
+#define FM4_MFS2   (&mcu_mfs2)
+#define FM4_GPIO   (&mcu_gpio)
+#define FM4_EXTI   (&mcu_exti)
+#define FM4_HWWDT  (&mcu_hwwdt)
+#define FM4_CRG    (&mcu_crg)
+#define FM4_I2S0   (&mcu_i2s0)
+
+/** Alias de bit-band */
+extern volatile uint32_t bFM4_MFS2_I2C_ISMK_EN, bFM4_MFS2_I2C_IBSR_SPC;
+extern volatile uint32_t bFM4_MFS2_I2C_SMR_RIE, bFM4_MFS2_I2C_SMR_TIE;
+extern volatile uint32_t bFM4_GPIO_EPFR07_SCK2B1, bFM4_GPIO_EPFR07_SOT2B1;
+extern volatile uint32_t bFM4_GPIO_PFR3_PA, bFM4_GPIO_PFR3_PB;
+extern volatile uint32_t bFM4_GPIO_ADE_AN08, bFM4_GPIO_ADE_AN10, bFM4_GPIO_ADE_AN18;
+extern volatile uint32_t bFM4_GPIO_PFR1_P8, bFM4_GPIO_PFR1_PA, bFM4_GPIO_PFRB_P2;
+extern volatile uint32_t bFM4_GPIO_PFR6_PE, bFM4_GPIO_PFR2_P0;
+extern volatile uint32_t bFM4_GPIO_PDOR1_P8, bFM4_GPIO_PDOR1_PA, bFM4_GPIO_PDORB_P2;
+extern volatile uint32_t bFM4_GPIO_PDOR6_PE, bFM4_GPIO_PDIR2_P0;
+extern volatile uint32_t bFM4_GPIO_DDR1_P8, bFM4_GPIO_DDR1_PA, bFM4_GPIO_DDRB_P2;
+extern volatile uint32_t bFM4_GPIO_DDR6_PE, bFM4_GPIO_DDR2_P0;
+
+#endif  /* _S6E2CC_H_ */
@@ -0,0 +1,43 @@
+/**
+ * @file test.h
+ * @date :2026/04/02 10:05:12
+ * @brief Comprobaciones de las pruebas en el host (test/host)
+ *
+ * Cada prueba es un programa independiente: compila el módulo bajo prueba
+ * tal cual, con gcc, y devuelve 0 si todas las comprobaciones se cumplen.
+ */
+
+#ifndef _TEST_H_
+#define _TEST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static int test_failures;
+
+/** Comprueba una condición; sigue con la prueba si falla */
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            printf("%s:%d: FALLO: %s\n", __FILE__, __LINE__, #cond);       \
+            test_failures++;                                               \
+        }                                                                  \
+    } while (0)
+
+/** Compara dos enteros y muestra ambos valores si difieren */
+#define CHECK_EQ(a, b)                                                     \
+    do {                                                                   \
+        long long _a = (long long)(a), _b = (long long)(b);                \
+        if (_a != _b) {                                                    \
+            printf("%s:%d: FALLO: %s == %s (%lld != %lld)\n",              \
+                   __FILE__, __LINE__, #a, #b, _a, _b);                    \
+            test_failures++;                                               \
+        }                                                                  \
+    } while (0)
+
+/** Resultado de la prueba (valor de retorno de main) */
+#define TEST_END()                                                         \
+    (printf("%s: %s\n", __FILE__, test_failures ? "FALLO" : "OK"),         \
+     test_failures ? EXIT_FAILURE : EXIT_SUCCESS)
+
+#endif  /* _TEST_H_ */
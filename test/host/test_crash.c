@@ -0,0 +1,311 @@
+/**
+ * @file test_crash.c
+ * @date :2026/04/09 10:48:12
+ * @brief Prueba en el host del registro post-mortem (src/crash.c) y de
+ *        tools/crash2txt.py
+ *
+ * - crash_save() con un marco de excepción en una pila simulada: campos,
+ *   recorrido de la pila (direcciones de retorno candidatas) y "el primer
+ *   fallo gana".
+ * - crash_boot_read(): devuelve el registro una sola vez y descarta los
+ *   registros con un bit cambiado o con basura (RAM tras el encendido).
+ * - tools/crash2txt.py sobre el volcado de g_crash_last en binario y en
+ *   Intel HEX (formato de SAVE de µVision): misma salida, causa, registros
+ *   de fallo, pila y traza; CRC incorrecto con un bit cambiado; rechazo de
+ *   basura y de un volcado incompleto.
+ *
+ * Los límites del fichero de distribución se definen aquí: dos regiones de
+ * código ficticias (solo se comparan direcciones) y la RAM de datos sobre
+ * ram[]. Se enlaza sin PIE para que las direcciones quepan en 32 bits.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "mcu.h"
+#include "crash.h"
+#include "circ_buf.h"
+#include "trace.h"
+#include "test.h"
+
+#define DUMP_BIN  "build/crash.bin"
+#define DUMP_HEX  "build/crash.hex"
+#define CRASH2TXT "python3 " TOOLS_DIR "/crash2txt.py "
+
+uint32_t ram[256];                 /**< RAM de datos: pilas */
+circ_buf_t g_tx_buffer, g_rx_buffer;
+
+__asm__(".globl \"Image$$ER_IROM1$$Base\", \"Image$$ER_IROM1$$Limit\"\n"
+        ".set \"Image$$ER_IROM1$$Base\", 0x00000400\n"
+        ".set \"Image$$ER_IROM1$$Limit\", 0x00010000\n"
+        ".globl \"Image$$ER_IROM2$$Base\", \"Image$$ER_IROM2$$Limit\"\n"
+        ".set \"Image$$ER_IROM2$$Base\", 0x00100000\n"
+        ".set \"Image$$ER_IROM2$$Limit\", 0x00108000\n"
+        ".globl \"Image$$RW_IRAM1$$Base\", \"Image$$RW_IRAM1$$ZI$$Limit\"\n"
+        ".set \"Image$$RW_IRAM1$$Base\", ram\n"
+        ".set \"Image$$RW_IRAM1$$ZI$$Limit\", ram + 1024\n");
+
+/* ---------------------------------------------------------- Volcados -- */
+
+static void dump_bin(const char *path, const void *p, size_t n)
+{
+    FILE *f = fopen(path, "wb");
+    CHECK(f != NULL);
+    if (f != NULL)
+    {
+        fwrite(p, 1, n, f);
+        fclose(f);
+    }
+}
+
+/**
+ * @brief Volcado en Intel HEX como el de µVision (registros de 16 bytes)
+ */
+static void dump_hex(const char *path, const void *p, size_t n, uint32_t addr)
+{
+    const uint8_t *b = (const uint8_t *)p;
+    FILE *f = fopen(path, "w");
+    CHECK(f != NULL);
+    if (f == NULL)
+    {
+        return;
+    }
+    uint8_t sum = (uint8_t)(2u + 4u + (addr >> 24) + (addr >> 16));
+    fprintf(f, ":02000004%04X%02X\n", (unsigned)(addr >> 16), (uint8_t)-sum);
+    for (size_t i = 0; i < n; i += 16u)
+    {
+        size_t len = (n - i < 16u) ? n - i : 16u;
+        uint16_t a = (uint16_t)(addr + i);
+        sum = (uint8_t)(len + (a >> 8) + a);
+        fprintf(f, ":%02X%04X00", (unsigned)len, a);
+        for (size_t k = 0; k < len; k++)
+        {
+            fprintf(f, "%02X", b[i + k]);
+            sum = (uint8_t)(sum + b[i + k]);
+        }
+        fprintf(f, "%02X\n", (uint8_t)-sum);
+    }
+    fprintf(f, ":00000001FF\n");
+    fclose(f);
+}
+
+/**
+ * @brief Ejecuta crash2txt.py; devuelve su estado y su salida (con stderr)
+ */
+static int crash2txt(const char *path, char *out, size_t size)
+{
+    char cmd[256];
+    snprintf(cmd, sizeof(cmd), CRASH2TXT "%s 2>&1", path);
+    FILE *p = popen(cmd, "r");
+    CHECK(p != NULL);
+    if (p == NULL)
+    {
+        return -1;
+    }
+    size_t n = fread(out, 1, size - 1u, p);
+    out[n] = '\0';
+    return pclose(p);
+}
+
+#define CHECK_HAS(text, s)                                                 \
+    do {                                                                   \
+        if (strstr((text), (s)) == NULL) {                                 \
+            printf("%s:%d: FALLO: falta \"%s\" en:\n%s\n",                 \
+                   __FILE__, __LINE__, (s), (text));                       \
+            test_failures++;                                               \
+        }                                                                  \
+    } while (0)
+
+/* -------------------------------------------------------------- Pruebas -- */
+
+static uint32_t *frame;
+
+/**
+ * @brief Fallo de bus simulado: pila, registros de fallo, buffers y traza
+ */
+static void fake_fault(void)
+{
+    memset(ram, 0, sizeof(ram));
+    frame = &ram[100];
+    static const uint32_t f[CRASH_FRAME_WORDS] = {
+        0x11111111u, 0x22222222u, 0x33333333u, 0x44444444u, 0xCCCCCCCCu,
+        0x00000A4Du,                             // LR
+        0x00001234u,                             // PC
+        0x01000200u,                             // xPSR con palabra de alineamiento
+    };
+    memcpy(frame, f, sizeof(f));
+    uint32_t *above = frame + CRASH_FRAME_WORDS + 1u;
+    above[0] = 0x00000501u;                      // código (IROM1)
+    above[1] = 0x00000500u;                      // sin bit Thumb
+    above[2] = 0x20001235u;                      // fuera del código
+    above[3] = 0x00100011u;                      // código (IROM2)
+    above[4] = 0x00108001u;                      // justo tras IROM2
+    for (uint32_t i = 0; i < CRASH_BT_N; i++)
+    {
+        above[10 + i] = 0x00002001u + 2u * i;
+    }
+
+    SCB->CFSR = (1u << 9) | (1u << 15);          // PRECISERR BFARVALID
+    SCB->HFSR = 1u << 30;                        // FORCED
+    SCB->BFAR = 0x40001234u;
+    SCB->MMFAR = 0xE000ED34u;
+    DWT->CYCCNT = 123456u;
+
+    memset(&g_tx_buffer, 0, sizeof(g_tx_buffer));
+    memset(&g_rx_buffer, 0, sizeof(g_rx_buffer));
+    g_tx_buffer.buffer[0] = -7;
+    g_tx_buffer.head = 3;
+    g_tx_buffer.tail = 1;
+    g_rx_buffer.buffer[7] = 1000;
+    g_rx_buffer.head = 5;
+
+    trace_init();
+    for (uint16_t i = 0; i < 20u; i++)
+    {
+        DWT->CYCCNT = 1000u + 10u * i;
+        trace(TRACE_TASK_BEGIN, i);
+    }
+    DWT->CYCCNT = 5000u;
+    trace(TRACE_BIT_VALUE, 1);
+}
+
+static void test_save(void)
+{
+    fake_fault();
+    memset(&g_crash, 0, sizeof(g_crash));
+    crash_save(CRASH_BUSFAULT, 7, frame, 0xFFFFFFFDu);
+    CHECK_EQ(mcu_primask, 1);
+
+    CHECK_EQ(g_crash.magic, CRASH_MAGIC);
+    CHECK_EQ(g_crash.reason, CRASH_BUSFAULT);
+    CHECK_EQ(g_crash.info, 7);
+    CHECK_EQ(g_crash.frame[CRASH_PC], 0x1234);
+    CHECK_EQ(g_crash.frame[CRASH_LR], 0xA4D);
+    CHECK_EQ(g_crash.sp, (uint32_t)(uintptr_t)frame);
+    CHECK_EQ(g_crash.cfsr, (1u << 9) | (1u << 15));
+    CHECK_EQ(g_crash.bfar, 0x40001234u);
+    CHECK_EQ(g_crash.tx.head, 3);
+    CHECK_EQ(g_crash.rx.buffer[7], 1000);
+
+    // Pila: solo valores impares dentro de IROM1/IROM2, en orden, como mucho CRASH_BT_N
+    CHECK_EQ(g_crash.nbt, CRASH_BT_N);
+    CHECK_EQ(g_crash.bt[0], 0x00000501u);
+    CHECK_EQ(g_crash.bt[1], 0x00100011u);
+    CHECK_EQ(g_crash.bt[2], 0x00002001u);
+    CHECK_EQ(g_crash.bt[CRASH_BT_N - 1u], 0x00002001u + 2u * (CRASH_BT_N - 3u));
+
+    // Últimos CRASH_TRACE_N eventos, del más antiguo al más reciente
+    CHECK_EQ(g_crash.ntrace, CRASH_TRACE_N);
+    CHECK_EQ(g_crash.trace[0].payload, 21u - CRASH_TRACE_N);
+    CHECK_EQ(g_crash.trace[CRASH_TRACE_N - 1u].id, TRACE_BIT_VALUE);
+
+    // Marco fuera de la RAM de datos: no se recorre la pila
+    crash_record_t first = g_crash;
+    g_crash.magic = 0;
+    static uint32_t outside[CRASH_FRAME_WORDS + CRASH_STACK_SCAN];
+    outside[CRASH_FRAME_WORDS] = 0x00000501u;
+    crash_save(CRASH_HARDFAULT, 0, outside, 0xFFFFFFF9u);
+    CHECK_EQ(g_crash.nbt, 0);
+
+    // El primer fallo gana: la NMI posterior no sobrescribe
+    g_crash = first;
+    crash_save(CRASH_HWWDT, 0, NULL, 0);
+    CHECK(memcmp(&g_crash, &first, sizeof(first)) == 0);
+}
+
+static void test_boot_read(void)
+{
+    const crash_record_t *r = crash_boot_read();
+    CHECK(r == &g_crash_last);
+    CHECK_EQ(g_crash.magic, 0);
+    CHECK(crash_boot_read() == NULL);          // notificado una sola vez
+    if (r != NULL)
+    {
+        CHECK_EQ(r->reason, CRASH_BUSFAULT);
+        CHECK_EQ(r->nbt, CRASH_BT_N);
+    }
+
+    // Un bit cambiado en cualquier campo invalida el registro
+    static const size_t bits[] = { 32, 8 * offsetof(crash_record_t, bt) + 3,
+                                   8 * offsetof(crash_record_t, trace) + 77,
+                                   8 * offsetof(crash_record_t, crc) + 31 };
+    for (uint32_t i = 0; i < sizeof(bits) / sizeof(bits[0]); i++)
+    {
+        g_crash = g_crash_last;
+        ((uint8_t *)&g_crash)[bits[i] / 8u] ^= (uint8_t)(1u << (bits[i] % 8u));
+        CHECK(crash_boot_read() == NULL);
+    }
+
+    // Basura tras el encendido, también con la marca correcta
+    uint32_t s = 0x2545F491u;
+    for (uint32_t k = 0; k < 100u; k++)
+    {
+        for (size_t i = 0; i < sizeof(g_crash); i++)
+        {
+            s ^= s << 13;
+            s ^= s >> 17;
+            s ^= s << 5;
+            ((uint8_t *)&g_crash)[i] = (uint8_t)s;
+        }
+        if (k & 1u)
+        {
+            g_crash.magic = CRASH_MAGIC;
+        }
+        CHECK(crash_boot_read() == NULL);
+        CHECK_EQ(g_crash.magic, 0);
+    }
+}
+
+static void test_crash2txt(void)
+{
+    static char out[4096], hex[4096];
+    crash_record_t r = g_crash_last;
+
+    dump_bin(DUMP_BIN, &r, sizeof(r));
+    CHECK_EQ(crash2txt(DUMP_BIN, out, sizeof(out)), 0);
+    CHECK_HAS(out, "Causa:   BUSFAULT (info 0x00000007)\n");
+    CHECK(strstr(out, "CRC incorrecto") == NULL);
+    CHECK_HAS(out, "CYCCNT:  5000\n");
+    CHECK_HAS(out, "(PSP, EXC_RETURN 0xFFFFFFFD)");
+    CHECK_HAS(out, "pc   0x00001234");
+    CHECK_HAS(out, "lr   0x00000A4D");
+    CHECK_HAS(out, "CFSR:    0x00008200  PRECISERR BFARVALID\n");
+    CHECK_HAS(out, "HFSR:    0x40000000  FORCED\n");
+    CHECK_HAS(out, "BFAR:    0x40001234\n");
+    CHECK(strstr(out, "MMFAR") == NULL);       // sin MMARVALID
+    CHECK_HAS(out, "  0x00000501\n  0x00100011\n  0x00002001\n");
+    CHECK_HAS(out, "TX:      head 3 tail 1  -7 0 0 0 0 0 0 0\n");
+    CHECK_HAS(out, "RX:      head 5 tail 0  0 0 0 0 0 0 0 1000\n");
+    CHECK_HAS(out, "           0  TASK_BEGIN     5\n");
+    CHECK_HAS(out, "        3950  BIT_VALUE      1\n");
+
+    // Intel HEX en la dirección de la RAM del FM4: misma salida
+    dump_hex(DUMP_HEX, &r, sizeof(r), 0x1FFF8A40u);
+    CHECK_EQ(crash2txt(DUMP_HEX, hex, sizeof(hex)), 0);
+    CHECK(strcmp(out, hex) == 0);
+
+    // Un bit cambiado en el volcado: se decodifica con aviso
+    ((uint8_t *)&r)[offsetof(crash_record_t, cyccnt)] ^= 0x10u;
+    dump_bin(DUMP_BIN, &r, sizeof(r));
+    CHECK_EQ(crash2txt(DUMP_BIN, out, sizeof(out)), 0);
+    CHECK_HAS(out, "** CRC incorrecto **");
+    CHECK_HAS(out, "CYCCNT:  5016\n");
+
+    // Basura y volcado incompleto: se rechazan
+    memset(&r, 0xA5, sizeof(r));
+    dump_bin(DUMP_BIN, &r, sizeof(r));
+    CHECK(crash2txt(DUMP_BIN, out, sizeof(out)) != 0);
+    CHECK_HAS(out, "registro no válido (magic 0xA5A5A5A5)");
+    dump_bin(DUMP_BIN, &g_crash_last, sizeof(r) - 4u);
+    CHECK(crash2txt(DUMP_BIN, out, sizeof(out)) != 0);
+    CHECK_HAS(out, "volcado incompleto");
+}
+
+int main(void)
+{
+    test_save();
+    test_boot_read();
+    test_crash2txt();
+
+    return TEST_END();
+}
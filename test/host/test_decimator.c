@@ -0,0 +1,268 @@
+/**
+ * @file test_decimator.c
+ * @date :2026/04/02 10:05:12
+ * @brief Prueba en el host de los decimadores (src/decimator.c)
+ *
+ * FIR polifásico:
+ * - Salida idéntica bit a bit a la convolución directa con los mismos
+ *   coeficientes, redondeo y saturación (referencia en 64 bits).
+ * - Respuesta: tono en banda de paso con rizado < 0.2 dB y tono que se
+ *   solapa al decimar atenuado más de 59 dB.
+ *
+ * CIC:
+ * - Salida idéntica bit a bit a la ventana triangular de 2M-1 muestras
+ *   (referencia en 64 bits, sin el desbordamiento de los integradores)
+ *   seguida de la misma normalización y compensación.
+ * - Respuesta: misma ganancia en marca y espacio (< 0.05 dB) y atenuación
+ *   de los tonos que se solapan al decimar.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include "decimator.h"
+#include "test.h"
+
+#define N_IN  (48000u)
+
+static int16_t x[N_IN];
+static int16_t y[N_IN];
+
+/**
+ * @brief Generador pseudoaleatorio reproducible (xorshift32)
+ */
+static uint32_t rnd(void)
+{
+    static uint32_t s = 0x12345678u;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+/**
+ * @brief Decima x[] completo, devuelve el número de salidas
+ */
+static uint32_t run(uint8_t factor, uint32_t n)
+{
+    decim_t d;
+    uint32_t m = 0;
+
+    CHECK_EQ(decim_init(&d, factor), 0);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (decim_process(&d, x[i], &y[m]))
+        {
+            m++;
+        }
+    }
+    return m;
+}
+
+/**
+ * @brief Salida m por convolución directa (y[m] = sum h[k] x[mM - k])
+ */
+static int16_t reference(const int16_t *h, uint32_t taps, uint8_t factor, uint32_t m)
+{
+    int64_t acc = 0;
+    for (uint32_t k = 0; k < taps; k++)
+    {
+        int64_t n = (int64_t)m * factor - k;
+        if (n >= 0)
+        {
+            acc += (int64_t)h[k] * x[n];
+        }
+    }
+    acc = (acc + (1 << 14)) >> 15;
+    if (acc > INT16_MAX)
+    {
+        acc = INT16_MAX;
+    }
+    else if (acc < INT16_MIN)
+    {
+        acc = INT16_MIN;
+    }
+    return (int16_t)acc;
+}
+
+static void test_bit_exact(uint8_t factor)
+{
+    decim_t d;
+    decim_init(&d, factor);
+    const int16_t *h = d.h;
+    uint32_t taps = (uint32_t)d.phases * factor;
+    int64_t dc = 0;
+
+    for (uint32_t k = 0; k < taps; k++)
+    {
+        dc += h[k];
+    }
+    CHECK(dc > 32000 && dc < 34000);          // ganancia en continua ~1
+
+    for (uint32_t i = 0; i < N_IN; i++)
+    {
+        x[i] = (int16_t)rnd();                // ruido a plena escala
+    }
+    uint32_t m = run(factor, N_IN);
+    CHECK_EQ(m, N_IN / factor);
+    uint32_t bad = 0;
+    for (uint32_t i = 0; i < m; i++)
+    {
+        bad += (y[i] != reference(h, taps, factor, i));
+    }
+    CHECK_EQ(bad, 0);
+}
+
+/**
+ * @brief Valor eficaz de la salida para un tono de entrada, en Q15
+ */
+static double tone_rms(uint8_t factor, double f_hz, double amp)
+{
+    for (uint32_t i = 0; i < N_IN; i++)
+    {
+        x[i] = (int16_t)lrint(amp * 32767.0 * sin(2.0 * M_PI * f_hz * i / 48000.0));
+    }
+    uint32_t m = run(factor, N_IN);
+    double s = 0.0;
+    uint32_t skip = 64;                       // transitorio del filtro
+    for (uint32_t i = skip; i < m; i++)
+    {
+        s += (double)y[i] * y[i];
+    }
+    return sqrt(s / (m - skip));
+}
+
+static void test_response(uint8_t factor, double f_pass, double f_alias)
+{
+    const double amp = 0.5;
+    const double rms_in = amp * 32767.0 / sqrt(2.0);
+
+    double pass_db = 20.0 * log10(tone_rms(factor, f_pass, amp) / rms_in);
+    CHECK(fabs(pass_db) < 0.2);
+
+    double stop = tone_rms(factor, f_alias, amp);
+    CHECK(stop < rms_in * pow(10.0, -59.0 / 20.0) + 1.0);   // +1 LSB de redondeo
+    printf("  M=%u: %.0f Hz %+.3f dB, %.0f Hz %.1f dB\n", factor, f_pass, pass_db,
+           f_alias, 20.0 * log10((stop > 0.0 ? stop : 1e-3) / rms_in));
+}
+
+/**
+ * @brief Decima x[] completo con el CIC, devuelve el número de salidas
+ */
+static uint32_t run_cic(uint8_t factor, uint32_t n)
+{
+    decim_cic_t d;
+    uint32_t m = 0;
+
+    CHECK_EQ(decim_cic_init(&d, factor), 0);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (decim_cic_process(&d, x[i], &y[m]))
+        {
+            m++;
+        }
+    }
+    return m;
+}
+
+/**
+ * @brief Salida de los peines, normalizada, para la salida m (m < 0: 0)
+ */
+static int32_t cic_ref_u(uint8_t factor, uint16_t gain, int64_t m)
+{
+    int64_t acc = 0;
+    int64_t n0 = m * factor + factor - 1;     // última entrada de la salida m
+    for (int64_t k = 0; k < 2 * factor - 1; k++)
+    {
+        int64_t w = (k < factor) ? k + 1 : 2 * factor - 1 - k;
+        if (n0 - k >= 0)
+        {
+            acc += w * x[n0 - k];
+        }
+    }
+    return (m < 0) ? 0 : (int32_t)((acc * gain + (1 << 15)) >> 16);
+}
+
+static void test_cic_bit_exact(uint8_t factor)
+{
+    decim_cic_t d;
+    decim_cic_init(&d, factor);
+    CHECK((uint32_t)d.gain * factor * factor > 65000u);   // ganancia ~1
+    CHECK((uint32_t)d.gain * factor * factor < 66000u);
+
+    for (uint32_t i = 0; i < N_IN; i++)
+    {
+        x[i] = (int16_t)rnd();                // los integradores desbordan
+    }
+    uint32_t m = run_cic(factor, N_IN);
+    CHECK_EQ(m, N_IN / factor);
+    uint32_t bad = 0;
+    for (uint32_t i = 0; i < m; i++)
+    {
+        int64_t acc = ((1 << 14) + 2 * d.comp_a) * (int64_t)cic_ref_u(factor, d.gain, (int64_t)i - 1)
+                    - (int64_t)d.comp_a * (cic_ref_u(factor, d.gain, i)
+                                           + cic_ref_u(factor, d.gain, (int64_t)i - 2));
+        acc = (acc + (1 << 13)) >> 14;
+        acc = (acc > INT16_MAX) ? INT16_MAX : (acc < INT16_MIN) ? INT16_MIN : acc;
+        bad += (y[i] != acc);
+    }
+    CHECK_EQ(bad, 0);
+}
+
+/**
+ * @brief Valor eficaz de la salida del CIC para un tono de entrada, en Q15
+ */
+static double cic_tone_rms(uint8_t factor, double f_hz, double amp)
+{
+    for (uint32_t i = 0; i < N_IN; i++)
+    {
+        x[i] = (int16_t)lrint(amp * 32767.0 * sin(2.0 * M_PI * f_hz * i / 48000.0));
+    }
+    uint32_t m = run_cic(factor, N_IN);
+    double s = 0.0;
+    uint32_t skip = 8;
+    for (uint32_t i = skip; i < m; i++)
+    {
+        s += (double)y[i] * y[i];
+    }
+    return sqrt(s / (m - skip));
+}
+
+static void test_cic_response(uint8_t factor, double f_alias, double min_db)
+{
+    const double amp = 0.5;
+    const double rms_in = amp * 32767.0 / sqrt(2.0);
+
+    double mark_db = 20.0 * log10(cic_tone_rms(factor, 1200.0, amp) / rms_in);
+    double space_db = 20.0 * log10(cic_tone_rms(factor, 2200.0, amp) / rms_in);
+    CHECK(fabs(mark_db - space_db) < 0.05);
+    CHECK(fabs(mark_db) < 0.5);
+
+    double alias_db = 20.0 * log10(cic_tone_rms(factor, f_alias, amp) / rms_in);
+    CHECK(alias_db < -min_db);
+    printf("  CIC M=%u: 1200 Hz %+.3f dB, 2200 Hz %+.3f dB, %.0f Hz %.1f dB\n",
+           factor, mark_db, space_db, f_alias, alias_db);
+}
+
+int main(void)
+{
+    decim_t d;
+    CHECK_EQ(decim_init(&d, 3), -1);
+    decim_cic_t c;
+    CHECK_EQ(decim_cic_init(&c, 5), -1);
+
+    test_bit_exact(4);
+    test_bit_exact(6);
+
+    test_response(4, 1000.0, 10000.0);       // 10 kHz -> 2 kHz a 12 kHz
+    test_response(6, 1000.0, 7000.0);        // 7 kHz -> 1 kHz a 8 kHz
+    test_response(6, 2600.0, 5400.0);        // bordes de las bandas
+
+    test_cic_bit_exact(4);
+    test_cic_bit_exact(6);
+
+    test_cic_response(4, 10000.0, 25.0);     // 10 kHz -> 2 kHz a 12 kHz
+    test_cic_response(6, 7000.0, 30.0);      // 7 kHz -> 1 kHz a 8 kHz
+    test_cic_response(6, 5400.0, 12.0);      // 5.4 kHz -> 2.6 kHz a 8 kHz
+
+    return TEST_END();
+}
@@ -0,0 +1,110 @@
+/**
+ * @file test_dsp_params.c
+ * @date :2026/04/15 09:40:12
+ * @brief Prueba en el host de la tabla de parámetros DSP (src/dsp_params.c)
+ *
+ * Para cada frecuencia FS_xxx_HZ de HAL_FM4_i2s.h:
+ * - Los campos siguen las fórmulas de dsp_params.c y el filtro tiene
+ *   ganancia en continua ~1 (Q30) y polos dentro del círculo unidad.
+ * - Cambio de frecuencia: los mismos consumidores (fsk_link_tx_t,
+ *   fsk_demod_t, fsk_link_rx_t) se reinicializan con el conjunto de esa
+ *   frecuencia, toman sus campos (retardo, coeficientes, incrementos de
+ *   fase, muestras por bit) y una trama pasa en lazo a esa frecuencia.
+ * - Frecuencia no soportada: NULL, y los consumidores la rechazan.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "HAL_FM4_i2s.h"
+#include "dsp_params.h"
+#include "fsk_demod.h"
+#include "fsk_link.h"
+#include "test.h"
+
+static const uint8_t msg[] = "SEMP 30319";
+#define MSG_LEN  (sizeof(msg) - 1u)
+
+/** Orden distinto al de la tabla: cada paso es un cambio de frecuencia */
+static const uint8_t rates[] = {
+    FS_48000_HZ, FS_8000_HZ, FS_96000_HZ, FS_16000_HZ, FS_32000_HZ, FS_24000_HZ, FS_48000_HZ
+};
+
+static fsk_link_tx_t tx;
+static fsk_link_rx_t rx;
+static fsk_demod_t demod;
+
+static void test_fields(const dsp_params_t *p)
+{
+    CHECK_EQ(p->delay, (uint16_t)lrint(22.0 * p->fs_hz / 48000.0));
+    CHECK_EQ(p->phaseinc_mark, (uint16_t)lrint(FSK_MARK_HZ * 65536.0 / p->fs_hz));
+    CHECK_EQ(p->phaseinc_space, (uint16_t)lrint(FSK_SPACE_HZ * 65536.0 / p->fs_hz));
+    CHECK_EQ(p->samples_bit_q8, (uint32_t)lrint(256.0 * p->fs_hz / FSK_BAUD));
+
+    // Elíptico de orden par: ganancia en continua = -1 dB de rizado
+    double dc = (double)(p->b[0] + p->b[1] + p->b[2]) /
+                ((double)(1 << 30) + p->a[0] + p->a[1]);
+    CHECK(fabs(dc - pow(10.0, -1.0 / 20.0)) < 0.01);
+    CHECK(fabs((double)p->a[1]) < (double)(1 << 30));          // |polos| < 1
+}
+
+/**
+ * @brief Reinicializa los consumidores con p y pasa una trama en lazo
+ */
+static void test_switch(const dsp_params_t *p)
+{
+    CHECK_EQ(fsk_link_tx_init(&tx, FEC_HAMMING74, p), 0);
+    CHECK_EQ(fsk_demod_init(&demod, p), 0);
+    CHECK_EQ(fsk_link_rx_init(&rx, FEC_HAMMING74, MSG_LEN, p), 0);
+
+    CHECK_EQ(tx.phaseinc[1], p->phaseinc_mark);
+    CHECK_EQ(tx.phaseinc[0], p->phaseinc_space);
+    CHECK_EQ(tx.bit_q8, p->samples_bit_q8);
+    CHECK_EQ(rx.bit_q8, p->samples_bit_q8);
+    CHECK_EQ(demod.delay, p->delay);
+    CHECK(memcmp(demod.b, p->b, sizeof(demod.b)) == 0);
+    CHECK(memcmp(demod.a, p->a, sizeof(demod.a)) == 0);
+
+    // 100 ms de reposo (transitorio del filtro) y la trama
+    uint32_t frames = 0;
+    for (uint32_t i = 0; i < p->fs_hz / 10u; i++)
+    {
+        frames += fsk_link_rx_bit(&rx, fsk_demod_process(&demod, fsk_link_tx_sample(&tx) / 2));
+    }
+    CHECK_EQ(fsk_link_send(&tx, msg, MSG_LEN), 0);
+    uint32_t guard = p->fs_hz;
+    do
+    {
+        frames += fsk_link_rx_bit(&rx, fsk_demod_process(&demod, fsk_link_tx_sample(&tx) / 2));
+    } while (fsk_link_tx_busy(&tx) && (--guard != 0u));
+    CHECK(guard != 0u);
+    CHECK_EQ(frames, 1);
+    CHECK(memcmp(rx.frame, msg, MSG_LEN) == 0);
+    CHECK_EQ(rx.corrected, 0);
+    CHECK_EQ(rx.framing_errors, 0);
+}
+
+int main(void)
+{
+    for (uint32_t i = 0; i < sizeof(rates); i++)
+    {
+        const dsp_params_t *p = dsp_params_get(rates[i]);
+        CHECK(p != NULL);
+        if (p == NULL)
+        {
+            continue;
+        }
+        CHECK_EQ(p->fs_code, rates[i]);
+        test_fields(p);
+        test_switch(p);
+    }
+
+    // Frecuencia no soportada
+    const dsp_params_t *p = dsp_params_get(0xFF);
+    CHECK(p == NULL);
+    CHECK_EQ(fsk_demod_init(&demod, p), -1);
+    CHECK_EQ(fsk_link_tx_init(&tx, FEC_NONE, p), -1);
+    CHECK_EQ(fsk_link_rx_init(&rx, FEC_NONE, MSG_LEN, p), -1);
+
+    return TEST_END();
+}
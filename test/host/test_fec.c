@@ -0,0 +1,250 @@
+/**
+ * @file test_fec.c
+ * @date :2026/04/14 10:21:37
+ * @brief Prueba en el host de la corrección de errores (src/fec.c)
+ *
+ * - Hamming(7,4): ida y vuelta de los 16 nibbles y los 256 bytes, y
+ *   corrección de cualquier error de 1 bit por palabra.
+ * - Convolucional + Viterbi: ida y vuelta de tramas de 1 a
+ *   FEC_CONV_MAX_BYTES bytes, corrección de ráfagas de FEC_TEST_BURST
+ *   símbolos en cualquier posición y de errores aislados separados, y
+ *   decodificación símbolo a símbolo (fec_viterbi_step()) idéntica a la de
+ *   la trama entera.
+ * - ACS y renormalización escalar y SIMD (fec_scalar.c, fec_simd.c con
+ *   intrínsecos en C) idénticos entre sí y a la referencia (fórmulas de
+ *   fec.c) con métricas aleatorias, saturación incluida, y decodificación
+ *   SIMD idéntica a la escalar con símbolos con ruido.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "fec.h"
+#include "fec_acs.h"
+#include "test.h"
+
+/** Ráfaga de símbolos consecutivos que debe corregir el Viterbi */
+#define FEC_TEST_BURST  4u
+
+static uint8_t sym[FEC_CONV_SYMBOLS(FEC_CONV_MAX_BYTES)];
+static uint8_t data[FEC_CONV_MAX_BYTES];
+static uint8_t out[FEC_CONV_MAX_BYTES];
+
+/**
+ * @brief Generador pseudoaleatorio reproducible (xorshift32)
+ */
+static uint32_t rnd(void)
+{
+    static uint32_t s = 0x12345678u;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+static void random_data(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        data[i] = (uint8_t)rnd();
+    }
+}
+
+static void test_hamming(void)
+{
+    uint32_t bad = 0;
+
+    for (uint8_t v = 0; v < 16u; v++)
+    {
+        uint8_t code = fec_hamming74_encode(v);
+        uint8_t nib = 0xFF;
+        bad += (fec_hamming74_decode(code, &nib) != 0u) || (nib != v);
+        for (uint8_t k = 0; k < 7u; k++)
+        {
+            nib = 0xFF;
+            bad += (fec_hamming74_decode(code ^ (uint8_t)(1u << k), &nib) != 1u) || (nib != v);
+        }
+    }
+    CHECK_EQ(bad, 0);
+
+    bad = 0;
+    for (uint32_t v = 0; v < 256u; v++)
+    {
+        uint8_t s[14], b = 0;
+        fec_hamming_encode_byte((uint8_t)v, s);
+        bad += (fec_hamming_decode_byte(s, &b) != 0u) || (b != v);
+
+        // Un error en cada palabra de código
+        s[rnd() % 7u] ^= 1u;
+        s[7u + rnd() % 7u] ^= 1u;
+        bad += (fec_hamming_decode_byte(s, &b) != 2u) || (b != v);
+    }
+    CHECK_EQ(bad, 0);
+}
+
+static void test_conv_roundtrip(void)
+{
+    uint32_t bad = 0;
+
+    for (uint32_t n = 1; n <= FEC_CONV_MAX_BYTES; n++)
+    {
+        random_data(n);
+        uint32_t ns = fec_conv_encode(data, n, sym);
+        bad += (ns != FEC_CONV_SYMBOLS(n));
+        bad += (fec_viterbi_decode(sym, n, out) != 0);
+        bad += (memcmp(out, data, n) != 0);
+    }
+    CHECK_EQ(bad, 0);
+
+    CHECK_EQ(fec_conv_encode(data, FEC_CONV_MAX_BYTES + 1u, sym), 0);
+    CHECK_EQ(fec_viterbi_decode(sym, FEC_CONV_MAX_BYTES + 1u, out), -1);
+}
+
+static void test_conv_burst(void)
+{
+    const uint32_t n = 10;
+    uint32_t ns = FEC_CONV_SYMBOLS(n);
+    uint32_t bad = 0;
+
+    random_data(n);
+    for (uint32_t pos = 0; pos + FEC_TEST_BURST <= ns; pos++)
+    {
+        fec_conv_encode(data, n, sym);
+        for (uint32_t k = 0; k < FEC_TEST_BURST; k++)
+        {
+            sym[pos + k] ^= 1u;
+        }
+        bad += (fec_viterbi_decode(sym, n, out) != (int32_t)FEC_TEST_BURST);
+        bad += (memcmp(out, data, n) != 0);
+    }
+    CHECK_EQ(bad, 0);
+
+    // Errores aislados cada 20 símbolos: uno por cada longitud de restricción
+    fec_conv_encode(data, n, sym);
+    uint32_t flips = 0;
+    for (uint32_t pos = 5; pos < ns; pos += 20u)
+    {
+        sym[pos] ^= 1u;
+        flips++;
+    }
+    CHECK_EQ(fec_viterbi_decode(sym, n, out), flips);
+    CHECK(memcmp(out, data, n) == 0);
+}
+
+static void test_conv_stream(void)
+{
+    const uint32_t n = 12;
+    uint32_t ns = FEC_CONV_SYMBOLS(n);
+
+    random_data(n);
+    fec_conv_encode(data, n, sym);
+    for (uint32_t i = 0; i < ns; i++)
+    {
+        sym[i] ^= ((rnd() % 100u) < 3u) ? 1u : 0u;   // 3 % de errores
+    }
+    uint8_t whole[FEC_CONV_MAX_BYTES];
+    int32_t m = fec_viterbi_decode(sym, n, whole);
+
+    fec_viterbi_start();
+    for (uint32_t t = 0; t < ns / 2u; t++)
+    {
+        CHECK_EQ(fec_viterbi_step(sym[2u * t], sym[2u * t + 1u]), 0);
+    }
+    CHECK_EQ(fec_viterbi_finish(n + 1u, out), -1);   // pasos de otra longitud
+    CHECK_EQ(fec_viterbi_finish(n, out), m);
+    CHECK(memcmp(out, whole, n) == 0);
+}
+
+/**
+ * @brief ACS de referencia, byte a byte con las fórmulas de fec.c
+ */
+static void acs_reference(const uint8_t *old, uint8_t *new, const uint8_t *bm, uint32_t *dec)
+{
+    for (uint32_t j = 0; j < FEC_CONV_STATES / 2u; j++)
+    {
+        uint32_t m = bm[j], a = old[j], b = old[j + FEC_CONV_STATES / 2u];
+        uint32_t x0 = a + m, y0 = b + 2u - m, x1 = a + 2u - m, y1 = b + m;
+        x0 = (x0 > 255u) ? 255u : x0;
+        y0 = (y0 > 255u) ? 255u : y0;
+        x1 = (x1 > 255u) ? 255u : x1;
+        y1 = (y1 > 255u) ? 255u : y1;
+        new[2u * j] = (uint8_t)((x0 >= y0) ? y0 : x0);
+        new[2u * j + 1u] = (uint8_t)((x1 >= y1) ? y1 : x1);
+        dec[(2u * j) >> 5] |= ((x0 >= y0) ? 1u : 0u) << ((2u * j) & 31u);
+        dec[(2u * j) >> 5] |= ((x1 >= y1) ? 1u : 0u) << ((2u * j + 1u) & 31u);
+    }
+}
+
+static void test_simd_acs(void)
+{
+    union { uint8_t u8[FEC_CONV_STATES]; uint32_t u32[FEC_CONV_STATES / 4u]; } old, n_ref, n_sc, n_simd;
+    union { uint8_t u8[FEC_CONV_STATES / 2u]; uint32_t u32[FEC_CONV_STATES / 8u]; } bm;
+    uint32_t bad = 0;
+
+    for (uint32_t it = 0; it < 20000u; it++)
+    {
+        // Métricas pequeñas, cercanas a la saturación o mezcladas
+        uint32_t range = (it % 3u == 0u) ? 40u : 256u;
+        uint32_t base = (it % 3u == 1u) ? 200u : 0u;
+        for (uint32_t i = 0; i < FEC_CONV_STATES; i++)
+        {
+            uint32_t v = base + rnd() % range;
+            old.u8[i] = (uint8_t)((v > 255u) ? 255u : v);
+        }
+        for (uint32_t j = 0; j < FEC_CONV_STATES / 2u; j++)
+        {
+            bm.u8[j] = (uint8_t)(rnd() % 3u);
+        }
+        uint32_t d_ref[2] = { 0, 0 }, d_sc[2] = { 0, 0 }, d_simd[2] = { 0, 0 };
+        acs_reference(old.u8, n_ref.u8, bm.u8, d_ref);
+        fec_scalar_acs(old.u32, n_sc.u32, bm.u32, d_sc);
+        fec_simd_acs(old.u32, n_simd.u32, bm.u32, d_simd);
+        bad += (memcmp(n_ref.u8, n_sc.u8, FEC_CONV_STATES) != 0);
+        bad += (memcmp(n_ref.u8, n_simd.u8, FEC_CONV_STATES) != 0);
+        bad += (d_ref[0] != d_sc[0]) || (d_ref[1] != d_sc[1]);
+        bad += (d_ref[0] != d_simd[0]) || (d_ref[1] != d_simd[1]);
+
+        // Renormalización: resta el mínimo
+        uint8_t min = 255;
+        for (uint32_t i = 0; i < FEC_CONV_STATES; i++)
+        {
+            min = (n_ref.u8[i] < min) ? n_ref.u8[i] : min;
+        }
+        bad += (fec_scalar_renorm(n_sc.u32) != min);
+        bad += (fec_simd_renorm(n_simd.u32) != min);
+        for (uint32_t i = 0; i < FEC_CONV_STATES; i++)
+        {
+            bad += (n_sc.u8[i] != (uint8_t)(n_ref.u8[i] - min));
+            bad += (n_simd.u8[i] != (uint8_t)(n_ref.u8[i] - min));
+        }
+    }
+    CHECK_EQ(bad, 0);
+
+    // Trama completa con ruido: misma salida y métrica que la escalar
+    bad = 0;
+    for (uint32_t it = 0; it < 200u; it++)
+    {
+        uint32_t n = 1u + rnd() % FEC_CONV_MAX_BYTES;
+        uint8_t o_simd[FEC_CONV_MAX_BYTES];
+        random_data(n);
+        fec_conv_encode(data, n, sym);
+        for (uint32_t i = 0; i < FEC_CONV_SYMBOLS(n); i++)
+        {
+            sym[i] ^= ((rnd() % 100u) < 8u) ? 1u : 0u;
+        }
+        int32_t m = fec_viterbi_decode(sym, n, out);
+        bad += (fec_simd_viterbi_decode(sym, n, o_simd) != m);
+        bad += (memcmp(out, o_simd, n) != 0);
+    }
+    CHECK_EQ(bad, 0);
+}
+
+int main(void)
+{
+    test_hamming();
+    test_conv_roundtrip();
+    test_conv_burst();
+    test_conv_stream();
+    test_simd_acs();
+
+    return TEST_END();
+}
@@ -0,0 +1,232 @@
+/**
+ * @file test_fsk_demod.c
+ * @date :2026/04/13 09:12:44
+ * @brief Prueba en el host del receptor FSK decimado (src/fsk_demod.c)
+ *
+ * Compara, sobre la misma señal, los dos receptores posibles:
+ * - 48 kHz: fsk_demod_process() en cada muestra con los parámetros de 48 kHz
+ *   (el algoritmo de lab5(), que solo existe compilado para ARM).
+ * - Decimado: decim_cic_process() (M = 6) y fsk_demod_process() a 8 kHz,
+ *   como task_audio_rx.
+ *
+ * Señal: bits aleatorios en FSK Bell 202 de fase continua (amplitud 0.5) más
+ * ruido blanco gaussiano en toda la banda (SNR = potencia de la portadora /
+ * potencia del ruido en 0-24 kHz). Cada bit se decide con la salida del
+ * demodulador en el instante de muestreo que deja más margen con la señal
+ * limpia (centro de la ventana sin errores), calibrado para cada receptor.
+ *
+ * Comprueba:
+ * - BER del decimado <= BER a 48 kHz + 0.002 en cada SNR.
+ * - BER < 1e-3 en ambos a partir de 3 dB, y 0 sin ruido.
+ *
+ * Muestra además el tiempo por muestra de 48 kHz de cada receptor (mínimo
+ * de varias repeticiones). Es tiempo del host (gcc -O2, x86), solo
+ * orientativo: en el PC los productos de 64 bits del demodulador cuestan
+ * poco y las dos sumas del CIC dependen de la escritura anterior en memoria,
+ * así que las dos cifras salen parecidas. Los ciclos en la placa son
+ * wcet y busy de la tarea audio_rx (task_stats[] de main.c, scheduler.h).
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <time.h>
+#include "HAL_FM4_i2s.h"
+#include "decimator.h"
+#include "dsp_params.h"
+#include "fsk_demod.h"
+#include "test.h"
+
+#define FS           48000u
+#define SPB          40u               /**< Muestras por bit a 48 kHz (1200 baud) */
+#define N_BITS       20000u
+#define N_IN         (N_BITS * SPB)
+#define SKIP_BITS    16u               /**< Transitorio del filtro */
+#define N_REPS       9u                /**< Repeticiones de la medida de tiempo */
+
+static int16_t x[N_IN];
+static uint8_t tx_bits[N_BITS];
+static uint8_t rx[N_IN];               /**< Bit demodulado en cada salida */
+
+/**
+ * @brief Generador pseudoaleatorio reproducible (xorshift32)
+ */
+static uint32_t rnd(void)
+{
+    static uint32_t s = 0x12345678u;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+static double urand(void)
+{
+    return (rnd() + 0.5) / 4294967296.0;
+}
+
+/**
+ * @brief Genera la señal FSK con ruido (snr_db = INFINITY: sin ruido)
+ */
+static void gen(double snr_db)
+{
+    const double amp = 0.5 * 32767.0;
+    const double sd = isinf(snr_db) ? 0.0 : sqrt(amp * amp / 2.0 / pow(10.0, snr_db / 10.0));
+    double ph = 0.0;
+
+    for (uint32_t b = 0; b < N_BITS; b++)
+    {
+        tx_bits[b] = (b < SKIP_BITS) ? 1u : (uint8_t)(rnd() & 1u);
+        double f = tx_bits[b] ? 1200.0 : 2200.0;
+        for (uint32_t k = 0; k < SPB; k++)
+        {
+            ph += 2.0 * M_PI * f / FS;
+            double v = amp * sin(ph);
+            if (sd > 0.0)
+            {
+                v += sd * sqrt(-2.0 * log(urand())) * cos(2.0 * M_PI * urand());
+            }
+            v = (v > 32767.0) ? 32767.0 : (v < -32768.0) ? -32768.0 : v;
+            x[b * SPB + k] = (int16_t)lrint(v);
+        }
+    }
+}
+
+/**
+ * @brief Receptor a 48 kHz, devuelve el número de salidas
+ */
+static uint32_t run_48k(void)
+{
+    fsk_demod_t d;
+    CHECK_EQ(fsk_demod_init(&d, dsp_params_get(FS_48000_HZ)), 0);
+    for (uint32_t i = 0; i < N_IN; i++)
+    {
+        rx[i] = fsk_demod_process(&d, x[i]);
+    }
+    return N_IN;
+}
+
+/**
+ * @brief Receptor decimado (task_audio_rx), devuelve el número de salidas
+ */
+static uint32_t run_decim(void)
+{
+    decim_cic_t c;
+    fsk_demod_t d;
+    uint32_t m = 0;
+    int16_t y;
+
+    CHECK_EQ(decim_cic_init(&c, 6), 0);
+    CHECK_EQ(fsk_demod_init(&d, dsp_params_get(FS_8000_HZ)), 0);
+    for (uint32_t i = 0; i < N_IN; i++)
+    {
+        if (decim_cic_process(&c, x[i], &y))
+        {
+            rx[m++] = fsk_demod_process(&d, y);
+        }
+    }
+    return m;
+}
+
+typedef struct {
+    const char *name;
+    uint32_t (*run)(void);
+    uint32_t ratio;                    /**< Muestras de 48 kHz por salida */
+    int32_t offset;                    /**< Instante de decisión (salidas) */
+} rx_path_t;
+
+/**
+ * @brief Bits erróneos decidiendo en el centro del bit + offset
+ */
+static uint32_t errors(const rx_path_t *p, uint32_t n_out, int32_t offset)
+{
+    uint32_t e = 0;
+    for (uint32_t b = SKIP_BITS; b < N_BITS - 4u; b++)
+    {
+        int64_t i = (int64_t)((b * SPB + SPB / 2u) / p->ratio) + offset;
+        if ((i >= 0) && (i < (int64_t)n_out))
+        {
+            e += (rx[i] != tx_bits[b]);
+        }
+    }
+    return e;
+}
+
+/**
+ * @brief Calibra el instante de decisión con la señal limpia
+ */
+static void calibrate(rx_path_t *p)
+{
+    int32_t lo = -1, hi = -1;
+    gen(INFINITY);
+    uint32_t n = p->run();
+    for (int32_t o = 0; o < (int32_t)(2u * SPB / p->ratio); o++)
+    {
+        if (errors(p, n, o) == 0u)
+        {
+            if (lo < 0)
+            {
+                lo = o;
+            }
+            hi = o;
+        }
+    }
+    CHECK(lo >= 0);                    // sin ruido, sin errores
+    p->offset = (lo + hi) / 2;
+}
+
+static double ber(rx_path_t *p)
+{
+    uint32_t n = p->run();
+    return (double)errors(p, n, p->offset) / (N_BITS - 4u - SKIP_BITS);
+}
+
+/**
+ * @brief Tiempo por muestra de 48 kHz (ns), mínimo de N_REPS pasadas
+ */
+static double ns_per_sample(rx_path_t *p)
+{
+    double best = INFINITY;
+    for (uint32_t r = 0; r < N_REPS; r++)
+    {
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        p->run();
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / N_IN;
+        best = (ns < best) ? ns : best;
+    }
+    return best;
+}
+
+int main(void)
+{
+    fsk_demod_t d;
+    CHECK_EQ(fsk_demod_init(&d, NULL), -1);
+
+    rx_path_t p48 = { "48 kHz", run_48k, 1u, 0 };
+    rx_path_t pdec = { "CIC + 8 kHz", run_decim, 6u, 0 };
+    calibrate(&p48);
+    calibrate(&pdec);
+
+    printf("  SNR (dB)   BER 48 kHz   BER decimado\n");
+    for (double snr = -3.0; snr <= 6.0; snr += 1.5)
+    {
+        gen(snr);
+        double b48 = ber(&p48);
+        double bdec = ber(&pdec);
+        printf("  %+5.1f      %.5f      %.5f\n", snr, b48, bdec);
+        CHECK(bdec <= b48 + 0.002);
+        if (snr >= 3.0)
+        {
+            CHECK(b48 < 1e-3);
+            CHECK(bdec < 1e-3);
+        }
+    }
+
+    double t48 = ns_per_sample(&p48);
+    double tdec = ns_per_sample(&pdec);
+    printf("  %s: %.2f ns/muestra, %s: %.2f ns/muestra (host)\n",
+           p48.name, t48, pdec.name, tdec);
+
+    return TEST_END();
+}
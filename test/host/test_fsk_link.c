@@ -0,0 +1,253 @@
+/**
+ * @file test_fsk_link.c
+ * @date :2026/04/14 10:21:37
+ * @brief Prueba en el host del enlace de datos con FEC (src/fsk_link.c)
+ *
+ * Cadena completa de main.c: fsk_link_tx_sample() a 48 kHz (DDS de
+ * stub/dds_stub.c) -> decim_cic_process() -> fsk_demod_process() a 8 kHz
+ * -> fsk_link_rx_bit(). Comprueba, en los tres modos fec_mode_t:
+ * - Tramas recibidas idénticas a las enviadas, sin errores de trama, también
+ *   si el envío llega a mitad de un bit de reposo.
+ * - Errores de símbolo inyectados en el transmisor (1 por palabra Hamming,
+ *   ráfaga de 4 en el convolucional): corregidos con FEC, no sin ella.
+ * - Con ruido (0 dB), Hamming y convolucional reciben bastantes más tramas
+ *   correctas que sin codificar.
+ * - Resincronización: un carácter suelto antes de la trama se descarta
+ *   tras el reposo y la trama siguiente llega bien.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "HAL_FM4_i2s.h"
+#include "decimator.h"
+#include "dsp_params.h"
+#include "fsk_demod.h"
+#include "fsk_link.h"
+#include "test.h"
+
+static const uint8_t msg[] = "SEMP 30319";
+#define MSG_LEN  (sizeof(msg) - 1u)
+
+static fsk_link_tx_t tx;
+static fsk_link_rx_t rx;
+static decim_cic_t cic;
+static fsk_demod_t demod;
+static double noise_sd;                /**< Ruido del canal (0: sin ruido) */
+
+/**
+ * @brief Generador pseudoaleatorio reproducible (xorshift32)
+ */
+static uint32_t rnd(void)
+{
+    static uint32_t s = 0x12345678u;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+static double gauss(void)
+{
+    double u1 = (rnd() + 0.5) / 4294967296.0;
+    double u2 = (rnd() + 0.5) / 4294967296.0;
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/**
+ * @brief Una muestra de 48 kHz por el canal; devuelve 1 si llega una trama
+ */
+static uint8_t channel_sample(void)
+{
+    double v = 0.5 * fsk_link_tx_sample(&tx);
+    if (noise_sd > 0.0)
+    {
+        v += noise_sd * gauss();
+    }
+    v = (v > 32767.0) ? 32767.0 : (v < -32768.0) ? -32768.0 : v;
+
+    int16_t y;
+    if (decim_cic_process(&cic, (int16_t)lrint(v), &y))
+    {
+        return fsk_link_rx_bit(&rx, fsk_demod_process(&demod, y));
+    }
+    return 0;
+}
+
+/**
+ * @brief Inicializa la cadena y la deja 100 ms en reposo (transitorio)
+ */
+static void link_init(fec_mode_t mode, double snr_db)
+{
+    CHECK_EQ(fsk_link_tx_init(&tx, mode, dsp_params_get(FS_48000_HZ)), 0);
+    CHECK_EQ(fsk_link_rx_init(&rx, mode, MSG_LEN, dsp_params_get(FS_8000_HZ)), 0);
+    decim_cic_init(&cic, 6);
+    fsk_demod_init(&demod, dsp_params_get(FS_8000_HZ));
+    noise_sd = isinf(snr_db) ? 0.0 : sqrt(16383.5 * 16383.5 / 2.0 / pow(10.0, snr_db / 10.0));
+    for (uint32_t i = 0; i < 4800u; i++)
+    {
+        channel_sample();
+    }
+}
+
+/**
+ * @brief Transmite hasta que el transmisor queda libre
+ * @return Tramas recibidas durante la transmisión
+ */
+static uint32_t run_until_idle(void)
+{
+    uint32_t frames = 0;
+    uint32_t guard = 48000u * 2u;
+    do
+    {
+        frames += channel_sample();
+    } while (fsk_link_tx_busy(&tx) && (--guard != 0u));
+    CHECK(guard != 0u);
+    return frames;
+}
+
+static void test_loopback(fec_mode_t mode)
+{
+    link_init(mode, INFINITY);
+    for (uint32_t k = 0; k < 3u; k++)
+    {
+        for (uint32_t i = 0; i < 13u * k; i++)   // envío a mitad de un bit de reposo
+        {
+            channel_sample();
+        }
+        CHECK_EQ(fsk_link_send(&tx, msg, MSG_LEN), 0);
+        CHECK_EQ(fsk_link_send(&tx, msg, MSG_LEN), -1);   // ocupado
+        CHECK_EQ(run_until_idle(), 1);
+        CHECK(memcmp(rx.frame, msg, MSG_LEN) == 0);
+    }
+    CHECK_EQ(rx.frames, 3);
+    CHECK_EQ(rx.corrected, 0);
+    CHECK_EQ(rx.framing_errors, 0);
+    CHECK_EQ(rx.dropped, 0);
+}
+
+/**
+ * @brief Inyecta errores de símbolo tras codificar
+ * @return 1 si la trama recibida es correcta
+ */
+static uint8_t test_injected(fec_mode_t mode)
+{
+    link_init(mode, INFINITY);
+    CHECK_EQ(fsk_link_send(&tx, msg, MSG_LEN), 0);
+    if (mode == FEC_CONV_K7)
+    {
+        for (uint16_t i = 40; i < 44u; i++)   // ráfaga de 4 símbolos
+        {
+            tx.sym[i] ^= 1u;
+        }
+    }
+    else
+    {
+        for (uint16_t i = 3; i < tx.nsym; i += 7u)   // 1 por palabra Hamming
+        {
+            tx.sym[i] ^= 1u;
+        }
+    }
+    CHECK_EQ(run_until_idle(), 1);
+    return (memcmp(rx.frame, msg, MSG_LEN) == 0) ? 1u : 0u;
+}
+
+/**
+ * @brief Tramas correctas de n enviadas con ruido (SNR en toda la banda)
+ */
+static uint32_t frames_ok(fec_mode_t mode, double snr_db, uint32_t n)
+{
+    uint32_t ok = 0;
+    link_init(mode, snr_db);
+    for (uint32_t k = 0; k < n; k++)
+    {
+        uint32_t before = rx.frames;
+        CHECK_EQ(fsk_link_send(&tx, msg, MSG_LEN), 0);
+        run_until_idle();
+        ok += (rx.frames == before + 1u) && (memcmp(rx.frame, msg, MSG_LEN) == 0);
+    }
+    return ok;
+}
+
+/**
+ * @brief Bits de línea directamente al receptor, a 8 kHz
+ */
+static void rx_line(uint8_t level, uint32_t bits)
+{
+    static uint32_t t_q8;
+    uint32_t bit_q8 = dsp_params_get(FS_8000_HZ)->samples_bit_q8;
+    for (uint32_t b = 0; b < bits; b++)
+    {
+        for (t_q8 += bit_q8; t_q8 >= 256u; t_q8 -= 256u)
+        {
+            fsk_link_rx_bit(&rx, level);
+        }
+    }
+}
+
+static void rx_char(uint8_t c)
+{
+    rx_line(0, 1);
+    for (uint8_t k = 0; k < 8u; k++)
+    {
+        rx_line((c >> k) & 1u, 1);
+    }
+    rx_line(1, 1);
+}
+
+static void test_resync(void)
+{
+    CHECK_EQ(fsk_link_rx_init(&rx, FEC_NONE, MSG_LEN, dsp_params_get(FS_8000_HZ)), 0);
+    rx_line(1, 20);
+    rx_char('x');                              // carácter suelto
+    rx_line(1, FSK_LINK_GAP_BITS / 2u + 2u);   // reposo: descarta
+    CHECK_EQ(rx.dropped, 1);
+    for (uint32_t i = 0; i < MSG_LEN; i++)
+    {
+        rx_char(msg[i]);
+    }
+    rx_line(1, 4);
+    CHECK_EQ(rx.frames, 1);
+    CHECK(memcmp(rx.frame, msg, MSG_LEN) == 0);
+
+    // Sin reposo suficiente no hay descarte
+    rx_char('x');
+    rx_line(1, FSK_LINK_GAP_BITS / 2u - 2u);
+    CHECK_EQ(rx.dropped, 1);
+}
+
+int main(void)
+{
+    // Parámetros
+    CHECK_EQ(fsk_link_tx_init(&tx, FEC_NONE, NULL), -1);
+    CHECK_EQ(fsk_link_tx_init(&tx, (fec_mode_t)7, dsp_params_get(FS_48000_HZ)), -1);
+    CHECK_EQ(fsk_link_rx_init(&rx, FEC_NONE, 0, dsp_params_get(FS_8000_HZ)), -1);
+    CHECK_EQ(fsk_link_rx_init(&rx, FEC_NONE, FSK_LINK_MAX_BYTES + 1u, dsp_params_get(FS_8000_HZ)), -1);
+    CHECK_EQ(fsk_link_tx_init(&tx, FEC_NONE, dsp_params_get(FS_48000_HZ)), 0);
+    CHECK_EQ(fsk_link_send(&tx, msg, 0), -1);
+    CHECK_EQ(fsk_link_send(&tx, msg, FSK_LINK_MAX_BYTES + 1u), -1);
+
+    test_loopback(FEC_NONE);
+    test_loopback(FEC_HAMMING74);
+    test_loopback(FEC_CONV_K7);
+
+    CHECK_EQ(test_injected(FEC_NONE), 0);
+    CHECK_EQ(test_injected(FEC_HAMMING74), 1);
+    CHECK_EQ(rx.corrected, 2u * MSG_LEN);
+    CHECK_EQ(test_injected(FEC_CONV_K7), 1);
+    CHECK_EQ(rx.corrected, 4);
+
+    const double snr = 0.0;
+    const uint32_t n = 60;
+    uint32_t ok_none = frames_ok(FEC_NONE, snr, n);
+    uint32_t ok_ham = frames_ok(FEC_HAMMING74, snr, n);
+    uint32_t ok_conv = frames_ok(FEC_CONV_K7, snr, n);
+    printf("  SNR %+.1f dB: tramas correctas %u/%u sin FEC, %u Hamming, %u convolucional\n",
+           snr, ok_none, n, ok_ham, ok_conv);
+    CHECK(ok_ham >= ok_none + n / 6u);
+    CHECK(ok_conv >= ok_none + n / 6u);
+
+    test_resync();
+
+    return TEST_END();
+}
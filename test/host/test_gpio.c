@@ -0,0 +1,266 @@
+/**
+ * @file test_gpio.c
+ * @date :2026/04/15 11:02:37
+ * @brief Prueba en el host de las escrituras por puerto y los grupos de pines
+ *        (hal/src/HAL_FM4_gpio.c) y de LedRGB() (bsp/src/FM4_leds_sw.c)
+ *
+ * Registros DDRx/PDIRx/PDORx en RAM (stub/s6e2cc.h). La ISR se simula con
+ * mcu_irq_hook de stub/mcu_stub.c: __disable_irq() la ejecuta justo antes de
+ * enmascarar y __set_PRIMASK(0) justo después, que es donde una interrupción
+ * real puede entrar alrededor de la lectura-modificación-escritura.
+ *
+ * Comprueba:
+ * - GPIO_GroupInit(): puertos, máscaras y bit de cada pin con pines de
+ *   varios puertos en cualquier orden; -1 con demasiados pines o puertos.
+ * - GPIO_GroupWrite()/GPIO_GroupRead(): bit i <-> canal i, sin tocar los
+ *   demás pines de los puertos.
+ * - GPIO_PortWriteMasked() con una ISR que escribe otro pin del mismo
+ *   puerto en los dos puntos de entrada: no se pierde ninguna escritura y
+ *   la RMW queda entera dentro de la sección crítica.
+ * - LedRGB(): una escritura de PDORx por puerto (P1 azul y rojo, PB verde),
+ *   con los dos pines de P1 cambiando en la misma escritura.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "mcu.h"
+#include "HAL_FM4_gpio.h"
+#include "FM4_leds_sw.h"
+#include "test.h"
+
+#define ISR_PIN  (1u << 0xF)           /**< Pin de P1 que escribe la ISR */
+
+static volatile uint32_t * const pdor = &mcu_gpio.PDOR0;
+static volatile uint32_t * const pdir = &mcu_gpio.PDIR0;
+
+/* --------------------------------------------------------- ISR simulada -- */
+
+static uint32_t isr_calls;
+static uint32_t isr_bad;               /**< ISR ejecutada en mitad de la RMW */
+static uint32_t isr_before;            /**< PDOR1 esperado al enmascarar */
+static uint32_t isr_after;             /**< PDOR1 esperado al desenmascarar */
+
+/**
+ * @brief ISR que conmuta ISR_PIN de P1 y comprueba en qué punto entra
+ */
+static void isr_toggle(void)
+{
+    if (mcu_primask != 0u)
+    {
+        isr_bad++;
+        return;
+    }
+    uint32_t v = mcu_gpio.PDOR1 & ~ISR_PIN;
+    if (isr_calls == 0u)
+    {
+        isr_bad += (v != isr_before);  // aún no se ha escrito nada
+    }
+    else
+    {
+        isr_bad += (v != isr_after);   // la escritura ya está completa
+    }
+    mcu_gpio.PDOR1 ^= ISR_PIN;
+    isr_calls++;
+}
+
+/* ---------------------------------------------- Registro de escrituras -- */
+
+static uint32_t snap[16];
+static uint8_t inside;                 /**< Entre __disable_irq y __set_PRIMASK */
+static uint32_t stores;                /**< Secciones críticas (RMW de PDOR) */
+static uint32_t store_ports[8];        /**< Puertos cambiados en cada una */
+
+/**
+ * @brief Al enmascarar, nada; al desenmascarar cuenta la RMW y anota qué
+ *        puertos ha cambiado
+ */
+static void isr_record(void)
+{
+    inside = !inside;
+    if (inside)
+    {
+        return;
+    }
+    uint32_t ports = 0;
+    for (uint32_t k = 0; k < 16u; k++)
+    {
+        if (pdor[k] != snap[k])
+        {
+            ports |= 1u << k;
+            snap[k] = pdor[k];
+        }
+    }
+    if (stores < 8u)
+    {
+        store_ports[stores] = ports;
+    }
+    stores++;
+}
+
+static void record_start(void)
+{
+    for (uint32_t k = 0; k < 16u; k++)
+    {
+        snap[k] = pdor[k];
+    }
+    stores = 0;
+    inside = 0;
+    memset(store_ports, 0, sizeof(store_ports));
+    mcu_irq_hook = isr_record;
+}
+
+/* -------------------------------------------------------------- Pruebas -- */
+
+static void test_group_init(void)
+{
+    static const GpioChannel_t ch[] = { P7D, P18, PB2, P1A, P3A, P7C };
+    GpioGroup_t g;
+
+    CHECK_EQ(GPIO_GroupInit(&g, ch, sizeof(ch) / sizeof(ch[0])), 0);
+    CHECK_EQ(g.n, 6);
+    CHECK_EQ(g.nports, 4);
+    CHECK(g.port[0] == 0x7 && g.port[1] == 0x1 && g.port[2] == 0xB && g.port[3] == 0x3);
+    CHECK_EQ(g.mask[0], (1u << 0xD) | (1u << 0xC));
+    CHECK_EQ(g.mask[1], (1u << 0x8) | (1u << 0xA));
+    CHECK_EQ(g.mask[2], 1u << 0x2);
+    CHECK_EQ(g.mask[3], 1u << 0xA);
+    static const uint8_t pin_port[] = { 0, 1, 2, 1, 3, 0 };
+    static const uint8_t pin_bit[] = { 0xD, 0x8, 0x2, 0xA, 0xA, 0xC };
+    CHECK(memcmp(g.pin_port, pin_port, sizeof(pin_port)) == 0);
+    CHECK(memcmp(g.pin_bit, pin_bit, sizeof(pin_bit)) == 0);
+
+    // Límites
+    static const GpioChannel_t five[] = { P18, P3A, P7D, PB2, P20 };
+    CHECK_EQ(GPIO_GroupInit(&g, five, 5), -1);
+    CHECK_EQ(GPIO_GroupInit(&g, five, 4), 0);
+    GpioChannel_t many[GPIO_GROUP_MAX_PINS + 1u];
+    for (uint32_t i = 0; i <= GPIO_GROUP_MAX_PINS; i++)
+    {
+        many[i] = (GpioChannel_t)(0x10u + (i & 0xFu));
+    }
+    CHECK_EQ(GPIO_GroupInit(&g, many, GPIO_GROUP_MAX_PINS), 0);
+    CHECK_EQ(g.nports, 1);
+    CHECK_EQ(g.mask[0], 0xFFFF);
+    CHECK_EQ(GPIO_GroupInit(&g, many, GPIO_GROUP_MAX_PINS + 1u), -1);
+}
+
+static void test_group_rw(void)
+{
+    static const GpioChannel_t ch[] = { P7D, P18, PB2, P1A, P3A, P7C };
+    GpioGroup_t g;
+    uint32_t bad = 0;
+
+    CHECK_EQ(GPIO_GroupInit(&g, ch, 6), 0);
+    for (uint16_t v = 0; v < 64u; v++)
+    {
+        // Los demás pines de los puertos, a un patrón fijo
+        mcu_gpio.PDOR1 = 0x5A5Au;
+        mcu_gpio.PDOR3 = 0xA5A5u;
+        mcu_gpio.PDOR7 = 0x0F0Fu;
+        mcu_gpio.PDORB = 0xF0F0u;
+        GPIO_GroupWrite(&g, v);
+        bad += ((mcu_gpio.PDOR7 >> 0xD) & 1u) != ((v >> 0) & 1u);
+        bad += ((mcu_gpio.PDOR1 >> 0x8) & 1u) != ((v >> 1) & 1u);
+        bad += ((mcu_gpio.PDORB >> 0x2) & 1u) != ((v >> 2) & 1u);
+        bad += ((mcu_gpio.PDOR1 >> 0xA) & 1u) != ((v >> 3) & 1u);
+        bad += ((mcu_gpio.PDOR3 >> 0xA) & 1u) != ((v >> 4) & 1u);
+        bad += ((mcu_gpio.PDOR7 >> 0xC) & 1u) != ((v >> 5) & 1u);
+        bad += (mcu_gpio.PDOR1 & ~0x0500u) != (0x5A5Au & ~0x0500u);
+        bad += (mcu_gpio.PDOR3 & ~0x0400u) != (0xA5A5u & ~0x0400u);
+        bad += (mcu_gpio.PDOR7 & ~0x3000u) != (0x0F0Fu & ~0x3000u);
+        bad += (mcu_gpio.PDORB & ~0x0004u) != (0xF0F0u & ~0x0004u);
+
+        // Lectura: PDIR con los mismos bits que PDOR
+        for (uint32_t k = 0; k < 16u; k++)
+        {
+            pdir[k] = pdor[k];
+        }
+        bad += (GPIO_GroupRead(&g) != v);
+    }
+    CHECK_EQ(bad, 0);
+    CHECK_EQ(mcu_primask, 0);
+}
+
+static void test_masked_race(void)
+{
+    uint32_t bad = 0;
+
+    for (uint32_t v = 0; v < 256u; v++)
+    {
+        uint16_t mask = (uint16_t)(0x00F0u | (v << 8)) & (uint16_t)~ISR_PIN;
+        uint16_t value = (uint16_t)(v * 0x0101u);
+        uint32_t old = 0x1234u ^ v;
+
+        mcu_gpio.PDOR1 = old;
+        isr_calls = 0;
+        isr_bad = 0;
+        isr_before = old & ~ISR_PIN;
+        isr_after = ((old & ~(uint32_t)mask) | (value & mask)) & ~ISR_PIN;
+        mcu_irq_hook = isr_toggle;
+        GPIO_PortWriteMasked(1, mask, value);
+        mcu_irq_hook = 0;
+
+        // La ISR ha entrado dos veces (antes y después): ISR_PIN vuelve a su
+        // valor y el resto es el de la escritura
+        bad += (isr_calls != 2u) || (isr_bad != 0u);
+        bad += (mcu_gpio.PDOR1 != (isr_after | (old & ISR_PIN)));
+    }
+    CHECK_EQ(bad, 0);
+    CHECK_EQ(mcu_primask, 0);
+
+    // Llamada con las interrupciones ya enmascaradas: las deja enmascaradas
+    __disable_irq();
+    GPIO_PortWriteMasked(1, 0x0001u, 0x0001u);
+    CHECK_EQ(mcu_primask, 1);
+    __set_PRIMASK(0);
+}
+
+static void test_led_rgb(void)
+{
+    memset(&mcu_gpio, 0, sizeof(mcu_gpio));
+    mcu_gpio.PDOR1 = 0x8001u;          // otros pines de P1 y PB, intactos
+    mcu_gpio.PDORB = 0x8001u;
+    LedsSwInit();
+    CHECK_EQ(mcu_gpio.PDOR1 & 0x0500u, 0x0500u);   // apagados (nivel alto)
+    CHECK_EQ(mcu_gpio.PDORB & 0x0004u, 0x0004u);
+
+    static const struct { rgb_color_t c; uint32_t p1; uint32_t pb; } cases[] = {
+        { MAGENTA, 0x0000u, 0x0004u },  // azul y rojo: los dos pines de P1
+        { GREEN,   0x0500u, 0x0000u },
+        { WHITE,   0x0000u, 0x0000u },
+        { OFF,     0x0500u, 0x0004u },
+    };
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        record_start();
+        LedRGB(cases[i].c);
+        mcu_irq_hook = 0;
+        CHECK_EQ(mcu_gpio.PDOR1 & 0x0500u, cases[i].p1);
+        CHECK_EQ(mcu_gpio.PDORB & 0x0004u, cases[i].pb);
+        CHECK_EQ(mcu_gpio.PDOR1 & ~0x0500u, 0x8001u);
+        CHECK_EQ(mcu_gpio.PDORB & ~0x0004u, 0x8001u);
+
+        // Una RMW por puerto; ningún puerto cambia en dos, así que azul y
+        // rojo (P1) cambian en la misma escritura
+        CHECK_EQ(stores, 2);
+        uint32_t changed = 0;
+        for (uint32_t k = 0; k < 2u; k++)
+        {
+            CHECK((store_ports[k] & ~((1u << 0x1) | (1u << 0xB))) == 0u);
+            CHECK((store_ports[k] & changed) == 0u);
+            CHECK(store_ports[k] != ((1u << 0x1) | (1u << 0xB)));
+            changed |= store_ports[k];
+        }
+    }
+    CHECK_EQ(mcu_primask, 0);
+}
+
+int main(void)
+{
+    test_group_init();
+    test_group_rw();
+    test_masked_race();
+    test_led_rgb();
+
+    return TEST_END();
+}
@@ -0,0 +1,389 @@
+/**
+ * @file test_hwwdt.c
+ * @date :2026/04/09 16:22:05
+ * @brief Prueba en el host del HWWDT (hal/src/HAL_FM4_hwwdt.c y src/wdt_sup.c)
+ *
+ * Recorre los escenarios de test/test_hwwdt.c contra el modelo de registros
+ * de stub/hwwdt_model.c: arranque (SystemInit() para el watchdog), operación
+ * normal con wdt_sup_poll() en el bucle principal, bloqueo (pulsación larga
+ * de SW2) con NMI y reset, y segundo arranque tras el reset.
+ *
+ * El tiempo avanza de 1 en 1 us. CLKLC se simula a clklc_hz (100 kHz
+ * nominal) con un acumulador de fase, SysTick_GetTick() cuenta ms y
+ * DWT->CYCCNT ciclos de SystemCoreClock. Con wdogload = 1000 la NMI debe
+ * llegar exactamente 1000 ciclos de CLKLC tras el último feed y el reset
+ * 2000 ciclos tras él.
+ *
+ * Comprueba también la telemetría de holgura (HWWDT_GetMinRemaining()) y el
+ * periodo calibrado de main.c (HWWDT_US_TO_LOAD()) con CLKLC en los extremos
+ * de su tolerancia, y HWWDT_IsRunning(), que deciden las ISR de fallo y de
+ * NMI (isr.c) para resetear con NVIC_SystemReset() si el HWWDT no lo hará.
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+#include "HAL_FM4_hwwdt.h"
+#include "HAL_SysTick.h"
+#include "wdt_sup.h"
+#include "hwwdt_model.h"
+#include "test.h"
+
+#define LOAD      HWWDT_MS_TO_TICKS(10u)      /**< WDOG_LOAD de main.c */
+
+/* ------------------------------------------------------- Base de tiempos -- */
+
+static uint64_t now_us;
+static uint32_t clklc_hz = __CLKLC;
+static uint32_t clklc_acc;            /**< Fase de CLKLC (Hz * us) */
+static uint32_t nmi_seen;             /**< NMI ya atendidas por nmi_handler() */
+static uint8_t nmi_int;               /**< HWWDT_GetIntStatus() en la NMI */
+static uint32_t nmi_late;             /**< wdt_sup_late() en la NMI */
+static uint64_t nmi_us, reset_us;
+
+uint64_t SysTick_GetTick(void)
+{
+    return now_us / 1000u;
+}
+
+/**
+ * @brief NMI_Handler_C() de isr.c, sin crash_save()
+ */
+static void nmi_handler(void)
+{
+    nmi_int = HWWDT_GetIntStatus();
+    nmi_late = wdt_sup_late();
+    nmi_us = now_us;
+}
+
+/**
+ * @brief Avanza 1 us: CLKLC, NMI y reset del modelo
+ *
+ * @return 0 tras el reset por el HWWDT
+ */
+static uint8_t step(void)
+{
+    if (g_hwwdt_model.reset)
+    {
+        return 0;
+    }
+    now_us++;
+    DWT->CYCCNT = (uint32_t)(now_us * (SystemCoreClock / 1000000u));
+    clklc_acc += clklc_hz;
+    while (clklc_acc >= 1000000u)
+    {
+        clklc_acc -= 1000000u;
+        hwwdt_model_tick();
+    }
+    if (g_hwwdt_model.reset)
+    {
+        reset_us = now_us;
+        return 0;
+    }
+    if (g_hwwdt_model.nmis != nmi_seen)
+    {
+        nmi_seen = g_hwwdt_model.nmis;
+        nmi_handler();
+    }
+    return 1;
+}
+
+/* ----------------------------------------------------------- Aplicación -- */
+
+static const wdt_sup_task_t tasks[] = {
+    { "bucle", 5u },
+};
+static wdt_sup_stats_t stats[1];
+
+/**
+ * @brief Reset del MCU y SystemInit(): el HWWDT arranca en marcha y se para
+ */
+static void boot(void)
+{
+    hwwdt_model_reset();
+    now_us = 0;
+    DWT->CYCCNT = 0;
+    clklc_acc = 0;
+    nmi_seen = 0;
+    nmi_int = 0;
+    nmi_late = 0;
+    nmi_us = 0;
+    reset_us = 0;
+    FM4_HWWDT->WDG_LCK = HWWDT_REG_UNLOCK_key1;      // system_s6e2cc.c
+    FM4_HWWDT->WDG_LCK = HWWDT_REG_UNLOCK_key2;
+    FM4_HWWDT->WDG_CTL = 0u;
+    hwwdt_model_sync();
+}
+
+/**
+ * @brief Arranque de main.c: HWWDT y supervisor
+ */
+static void start(uint32_t load, uint8_t resen)
+{
+    HWWDT_Init(load, resen);
+    HWWDT_Start();
+    wdt_sup_init(tasks, stats, 1);
+}
+
+/**
+ * @brief Bucle principal durante us: señal de vida cada ms y wdt_sup_poll()
+ *
+ * @param checkin 0: la tarea vigilada deja de dar señales de vida
+ */
+static void run(uint32_t us, uint8_t checkin)
+{
+    for (uint32_t i = 0; i < us && step(); i++)
+    {
+        if (checkin && now_us % 1000u == 0u)
+        {
+            wdt_sup_checkin(0);
+        }
+        wdt_sup_poll();
+    }
+}
+
+/**
+ * @brief Bucle infinito de test_hwwdt.c (LED amarillo): sin feeds
+ */
+static void hang(uint32_t us)
+{
+    for (uint32_t i = 0; i < us && step(); i++)
+    {
+    }
+}
+
+/* -------------------------------------------------------------- Pruebas -- */
+
+static void test_boot(void)
+{
+    hwwdt_model_reset();
+    CHECK_EQ(FM4_HWWDT->WDG_CTL, 3);          // en marcha tras el reset
+    boot();
+    CHECK_EQ(FM4_HWWDT->WDG_CTL, 0);
+    CHECK_EQ(g_hwwdt_model.lock_errors, 0);
+
+    // Parpadeo rojo de 3 s sin feeds: el HWWDT está parado
+    hang(3000000u);
+    CHECK_EQ(g_hwwdt_model.nmis, 0);
+    CHECK_EQ(g_hwwdt_model.reset, 0);
+    CHECK_EQ(FM4_HWWDT->WDG_VLR, 0xFFFF);
+
+    start(LOAD, 1);
+    hwwdt_model_sync();
+    CHECK_EQ(LOAD, 1000);
+    CHECK_EQ(FM4_HWWDT->WDG_LDR, LOAD);
+    CHECK_EQ(FM4_HWWDT->WDG_CTL, 3);          // INTEN | RESEN
+    CHECK_EQ(HWWDT_ReadWdgValue(), LOAD);
+    CHECK_EQ(HWWDT_GetIntStatus(), 0);
+    CHECK_EQ(g_hwwdt_model.lock_errors, 0);
+
+    HWWDT_Start();                             // ya en marcha: no recarga
+    hang(100u);
+    hwwdt_model_sync();
+    CHECK_EQ(HWWDT_ReadWdgValue(), LOAD - 10u);
+}
+
+static void test_normal(void)
+{
+    // Operación normal (verde): un feed por ms durante 2 s
+    run(2000000u, 1);
+    CHECK_EQ(g_hwwdt_model.nmis, 0);
+    CHECK_EQ(g_hwwdt_model.reset, 0);
+    CHECK_EQ(g_hwwdt_model.feeds, 2000);
+    CHECK_EQ(g_hwwdt_model.lock_errors, 0);
+    CHECK_EQ(wdt_sup_late(), 0);
+}
+
+static void test_hang(void)
+{
+    // Pulsación larga: el bucle se bloquea y nadie alimenta el HWWDT
+    uint64_t feed_us = now_us - now_us % 1000u;
+    uint64_t feed = g_hwwdt_model.feed_tick;
+    hang(100000u);
+    CHECK_EQ(g_hwwdt_model.nmis, 1);
+    CHECK_EQ(g_hwwdt_model.nmi_tick - feed, LOAD);
+    CHECK_EQ(nmi_us - feed_us, 10000);
+    CHECK_EQ(nmi_int, 1);
+    CHECK_EQ(nmi_late, 0);                     // el bucle entero, no una tarea
+    CHECK_EQ(g_hwwdt_model.reset, 1);
+    CHECK_EQ(g_hwwdt_model.reset_tick - feed, 2u * LOAD);
+    CHECK_EQ(reset_us - feed_us, 20000);
+
+    // Segundo arranque tras el reset: vuelve a la operación normal
+    boot();
+    start(LOAD, 1);
+    run(100000u, 1);
+    CHECK_EQ(g_hwwdt_model.nmis, 0);
+    CHECK_EQ(g_hwwdt_model.reset, 0);
+}
+
+static void test_task_late(void)
+{
+    // La tarea deja de dar señales de vida con el bucle en marcha: el
+    // supervisor sigue alimentando hasta agotar su ventana (5 ms)
+    uint64_t checkin_us = now_us - now_us % 1000u;
+    run(100000u, 0);
+    CHECK_EQ(g_hwwdt_model.nmis, 1);
+    CHECK_EQ(g_hwwdt_model.feed_tick * 10u, checkin_us + 5000u);
+    CHECK_EQ(nmi_us - checkin_us, 5000u + 10000u);
+    CHECK_EQ(nmi_int, 1);
+    CHECK_EQ(nmi_late, 1u << 0);
+    CHECK_EQ(reset_us - checkin_us, 5000u + 20000u);
+}
+
+static void test_late_feed(void)
+{
+    // Feed entre la NMI y el reset: borra WDG_RIS y evita el reset
+    boot();
+    start(LOAD, 1);
+    run(10000u, 1);
+    hwwdt_model_sync();                        // feed de t = 10 ms
+    uint64_t feed = g_hwwdt_model.feed_tick;
+    hang(15000u);
+    CHECK_EQ(g_hwwdt_model.nmis, 1);
+    CHECK_EQ(HWWDT_GetIntStatus(), 1);
+    HWWDT_Feed(WDT_SUP_PATTERN, (uint8_t)~WDT_SUP_PATTERN);
+    hang(10u);
+    CHECK_EQ(HWWDT_GetIntStatus(), 0);
+    CHECK_EQ(g_hwwdt_model.feed_tick - feed, 1500);
+    hang(9990u);                               // 1000 ciclos tras el feed
+    CHECK_EQ(g_hwwdt_model.nmis, 2);
+    CHECK_EQ(g_hwwdt_model.nmi_tick - g_hwwdt_model.feed_tick, LOAD);
+    CHECK_EQ(g_hwwdt_model.reset, 0);
+    hang(10000u);
+    CHECK_EQ(g_hwwdt_model.reset, 1);
+    CHECK_EQ(g_hwwdt_model.reset_tick - g_hwwdt_model.feed_tick, 2u * LOAD);
+}
+
+/**
+ * @brief Feeds cada ms con un parón de stall_us en el bucle principal
+ */
+static void jitter(uint32_t stall_us)
+{
+    run(100000u, 1);                           // acaba con un feed
+    hang(stall_us - 1u);                       // el primer paso de run() lo completa
+    wdt_sup_checkin(0);                        // la tarea vuelve con el bucle
+    run(100000u, 1);
+}
+
+static void test_margin(void)
+{
+    // Sin feeds la holgura es el periodo completo
+    boot();
+    start(LOAD, 1);
+    CHECK_EQ(HWWDT_GetMinRemaining(), LOAD);
+    HWWDT_ClearMinRemaining();
+    CHECK_EQ(HWWDT_GetMinRemaining(), UINT32_MAX);
+
+    // Un feed por ms: quedan 900 ciclos en cada uno
+    run(100000u, 1);
+    CHECK_EQ(HWWDT_GetMinRemaining(), LOAD - 100u);
+
+    // Un parón de 7,3 ms: quedan 270 ciclos, sin NMI
+    boot();
+    start(LOAD, 1);
+    jitter(7300u);
+    CHECK_EQ(HWWDT_GetMinRemaining(), LOAD - 730u);
+    CHECK_EQ(wdt_sup_max_feed_us(), 7300);
+    CHECK_EQ(g_hwwdt_model.nmis, 0);
+    CHECK_EQ(wdt_sup_late(), 0);
+
+    // Periodo calibrado (WDOG_CALIBRATE) con un 50 % de margen: con CLKLC
+    // un 50 % rápido el peor intervalo gasta 1095 ciclos de 1643 y la
+    // holgura sigue siendo al menos el 50 % de lo gastado
+    uint32_t load = HWWDT_US_TO_LOAD(wdt_sup_max_feed_us(), 50u);
+    CHECK_EQ(load, 1643);
+    static const uint32_t hz[] = { __CLKLC, __CLKLC * 3u / 2u, __CLKLC / 2u };
+    static const uint32_t used[] = { 730u, 1095u, 365u };
+    for (uint32_t i = 0; i < 3u; i++)
+    {
+        clklc_hz = hz[i];
+        boot();
+        start(load, 1);
+        jitter(7300u);
+        CHECK_EQ(g_hwwdt_model.nmis, 0);
+        CHECK_EQ(HWWDT_GetMinRemaining(), load - used[i]);
+        CHECK(HWWDT_GetMinRemaining() * 100u >= 50u * used[i]);
+    }
+
+    // Un parón de 22 ms con CLKLC rápido: más de 2 x 1643 ciclos, reset
+    clklc_hz = __CLKLC * 3u / 2u;
+    boot();
+    start(load, 1);
+    jitter(22000u);
+    CHECK_EQ(g_hwwdt_model.nmis, 1);
+    CHECK_EQ(g_hwwdt_model.reset, 1);
+    clklc_hz = __CLKLC;
+}
+
+static void test_no_reset(void)
+{
+    // RESEN = 0: solo NMI, el contador sigue recargando
+    boot();
+    start(LOAD, 0);
+    CHECK_EQ(FM4_HWWDT->WDG_CTL, 1);
+    hang(100000u);
+    CHECK_EQ(g_hwwdt_model.nmis, 1);
+    CHECK_EQ(HWWDT_GetIntStatus(), 1);
+    CHECK_EQ(g_hwwdt_model.reset, 0);
+}
+
+static void test_running(void)
+{
+    // Lo que consultan las ISR de fallo y de NMI antes de esperar el reset
+    hwwdt_model_reset();
+    CHECK_EQ(HWWDT_IsRunning(), 1);            // tras el reset del MCU
+    boot();
+    CHECK_EQ(HWWDT_IsRunning(), 0);            // SystemInit() lo para
+    HWWDT_Init(LOAD, 1);
+    hwwdt_model_sync();
+    CHECK_EQ(HWWDT_IsRunning(), 0);            // configurado, sin arrancar
+    HWWDT_Start();
+    hwwdt_model_sync();
+    CHECK_EQ(HWWDT_IsRunning(), 1);
+    HWWDT_Init(LOAD, 0);
+    HWWDT_Start();
+    hwwdt_model_sync();
+    CHECK_EQ(HWWDT_IsRunning(), 0);            // sin RESEN no hay reset
+}
+
+static void test_lock(void)
+{
+    boot();
+    start(LOAD, 1);
+    hwwdt_model_sync();
+
+    // Escrituras sin desbloquear: se ignoran
+    FM4_HWWDT->WDG_LDR = 5u;
+    hwwdt_model_sync();
+    CHECK_EQ(FM4_HWWDT->WDG_LDR, LOAD);
+    FM4_HWWDT->WDG_LCK = HWWDT_REG_UNLOCK_key1;     // CTL exige key1 y key2
+    FM4_HWWDT->WDG_CTL = 0u;
+    hwwdt_model_sync();
+    CHECK_EQ(FM4_HWWDT->WDG_CTL, 3);
+    FM4_HWWDT->WDG_ICL = 0u;
+    hwwdt_model_sync();
+    CHECK_EQ(g_hwwdt_model.feeds, 0);
+    CHECK_EQ(g_hwwdt_model.lock_errors, 3);
+    CHECK_EQ(FM4_HWWDT->WDG_LCK, 1);
+
+    // Un feed tras la escritura fallida sigue funcionando
+    HWWDT_Feed(WDT_SUP_PATTERN, (uint8_t)~WDT_SUP_PATTERN);
+    hwwdt_model_sync();
+    CHECK_EQ(g_hwwdt_model.feeds, 1);
+    CHECK_EQ(g_hwwdt_model.lock_errors, 3);
+}
+
+int main(void)
+{
+    test_boot();
+    test_normal();
+    test_hang();
+    test_task_late();
+    test_late_feed();
+    test_margin();
+    test_no_reset();
+    test_running();
+    test_lock();
+
+    return TEST_END();
+}
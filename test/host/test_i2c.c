@@ -0,0 +1,276 @@
+/**
+ * @file test_i2c.c
+ * @date :2026/04/08 12:30:05
+ * @brief Prueba en el host de la máquina de estados I2C (hal/src/HAL_FM4_i2c.c)
+ *
+ * Modelo de MFS2 y del WM8731 en stub/i2c_model.c: tramas con STOP o
+ * abandonadas, fallos inyectables (NACK, error de bus, pérdida de
+ * arbitraje, bus bloqueado) y alarma de timeout con el tiempo del bus.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "mcu.h"
+#include "HAL_FM4_i2c.h"
+#include "i2c_model.h"
+#include "test.h"
+
+#define WM8731_ADDR  I2C_MODEL_WM8731_ADDR
+
+// Bits de IBCR/IBSR (hal/src/HAL_FM4_i2c.c)
+#define IBCR_MSS   0x80u
+#define IBCR_INTE  0x04u
+#define IBCR_INT   0x01u
+#define IBSR_SPC   0x02u
+
+void MFS2_TX_IRQHandler(void);
+
+/* -------------------------------------------------------------- Pruebas -- */
+
+static uint32_t done_n;
+static i2c_xfer_t *done[8];
+static uint32_t done_us[8];
+
+static void on_done(i2c_xfer_t *x, void *arg)
+{
+    (void)arg;
+    if (done_n < 8u)
+    {
+        done[done_n] = x;
+        done_us[done_n] = g_i2c_model.now_us;
+    }
+    done_n++;
+}
+
+static void xfer(i2c_xfer_t *x, uint8_t address, const uint8_t *tx, uint8_t len)
+{
+    memset(x, 0, sizeof(*x));
+    x->address = address;
+    x->tx = tx;
+    x->len = len;
+    x->callback = on_done;
+}
+
+static void reset(i2c_fault_t fault, uint8_t at)
+{
+    i2c_model_reset(fault, at);
+    done_n = 0;
+}
+
+/**
+ * @brief Comprueba que el periférico queda libre y sin interrupción
+ */
+static void check_idle(void)
+{
+    CHECK(!I2C_busy());
+    CHECK(!g_i2c_model.busy);
+    CHECK(!i2c_model_irq());
+    CHECK((FM4_MFS2->IBSR & IBSR_SPC) == 0u);
+    CHECK(g_i2c_model.alarm == 0 || !g_i2c_model.alarm->pending);
+}
+
+static void test_init(void)
+{
+    I2C_init();
+    CHECK_EQ(FM4_MFS2->BGR, 249);                 // 400 kbit/s a 100 MHz
+    CHECK(FM4_MFS2->SMR & 0x80u);                 // modo 4 (I2C)
+    CHECK_EQ(FM4_GPIO->PZR3_f.PA, 1);             // SDA pseudo open-drain
+    CHECK_EQ(bFM4_GPIO_EPFR07_SCK2B1 & bFM4_GPIO_EPFR07_SOT2B1, 1);
+    CHECK(mcu_irq_enabled[MFS2_TX_IRQn]);
+    CHECK(!I2C_busy());
+}
+
+static void test_ok_and_queue(void)
+{
+    static const uint8_t a[] = { 0x12, 0x01 };              // R9 = 0x001 (activo)
+    static const uint8_t b[] = { 0x0D, 0x53 };              // R6 = 0x153
+    static const uint8_t c[] = { 0x08, 0x12, 0x0A, 0x00 };  // R4 y R5 en una trama
+    i2c_xfer_t xa, xb, xc;
+
+    reset(FAULT_NONE, 0);
+    xfer(&xa, WM8731_ADDR, a, sizeof(a));
+    xfer(&xb, WM8731_ADDR, b, sizeof(b));
+    xfer(&xc, WM8731_ADDR, c, sizeof(c));
+    CHECK_EQ(I2C_submit(&xa), 0);
+    CHECK_EQ(I2C_submit(&xb), 0);
+    CHECK_EQ(I2C_submit(&xc), 0);
+    CHECK_EQ(I2C_submit(&xb), -1);                // ya pendiente
+    CHECK(g_i2c_model.n == 0 && (FM4_MFS2->IBCR & IBCR_MSS));   // primera ya arrancada
+
+    i2c_model_run(10000);
+    CHECK_EQ(xa.status, I2C_OK);
+    CHECK_EQ(xb.status, I2C_OK);
+    CHECK_EQ(xc.status, I2C_OK);
+    CHECK(done_n == 3 && done[0] == &xa && done[1] == &xb && done[2] == &xc);
+    CHECK_EQ(g_i2c_model.frames, 3);
+    CHECK_EQ(g_i2c_model.aborts, 0);
+    CHECK_EQ(g_i2c_model.alarm_starts, 3);
+    CHECK_EQ(g_i2c_model.wm8731_writes, 4);
+    CHECK_EQ(g_i2c_model.wm8731_reg[9], 0x001);
+    CHECK_EQ(g_i2c_model.wm8731_reg[6], 0x153);
+    CHECK_EQ(g_i2c_model.wm8731_reg[4], 0x012);
+    CHECK_EQ(g_i2c_model.wm8731_reg[5], 0x000);
+    CHECK_EQ(mcu_primask, 0);
+    check_idle();
+}
+
+static void test_nack(void)
+{
+    static const uint8_t d[] = { 0x0D, 0x53 };
+    i2c_xfer_t x, y;
+
+    // Dirección equivocada: NACK en la dirección, STOP y la siguiente sigue
+    reset(FAULT_NONE, 0);
+    xfer(&x, 0x1B, d, sizeof(d));
+    xfer(&y, WM8731_ADDR, d, sizeof(d));
+    I2C_submit(&x);
+    I2C_submit(&y);
+    i2c_model_run(10000);
+    CHECK_EQ(x.status, I2C_ERR_NACK);
+    CHECK_EQ(y.status, I2C_OK);
+    CHECK_EQ(g_i2c_model.frames, 2);                      // con STOP, no abandono
+    CHECK_EQ(g_i2c_model.wm8731_writes, 1);
+    check_idle();
+
+    // NACK en el primer byte de datos: no transmite más y no hay escritura
+    reset(FAULT_NACK, 1);
+    xfer(&x, WM8731_ADDR, d, sizeof(d));
+    I2C_submit(&x);
+    i2c_model_run(10000);
+    CHECK_EQ(x.status, I2C_ERR_NACK);
+    CHECK_EQ(g_i2c_model.n, 2);
+    CHECK_EQ(g_i2c_model.frames, 1);
+    CHECK_EQ(g_i2c_model.wm8731_writes, 0);
+    check_idle();
+}
+
+static void test_bus_errors(void)
+{
+    static const uint8_t d[] = { 0x0D, 0x53 };
+    i2c_xfer_t x, y;
+
+    // Error de bus en un byte de datos: aborta sin STOP, la cola continúa
+    reset(FAULT_BER, 1);
+    xfer(&x, WM8731_ADDR, d, sizeof(d));
+    xfer(&y, WM8731_ADDR, d, sizeof(d));
+    I2C_submit(&x);
+    I2C_submit(&y);
+    i2c_model_run(10000);
+    CHECK_EQ(x.status, I2C_ERR_BUS);
+    CHECK_EQ(y.status, I2C_OK);
+    CHECK_EQ(g_i2c_model.aborts, 1);
+    CHECK_EQ(g_i2c_model.frames, 1);
+    CHECK_EQ(g_i2c_model.wm8731_writes, 1);
+    check_idle();
+
+    // Pérdida de arbitraje en la dirección
+    reset(FAULT_AL, 0);
+    xfer(&x, WM8731_ADDR, d, sizeof(d));
+    I2C_submit(&x);
+    i2c_model_run(10000);
+    CHECK_EQ(x.status, I2C_ERR_BUS);
+    CHECK_EQ(FM4_MFS2->IBCR, 0);
+    CHECK_EQ(g_i2c_model.wm8731_writes, 0);
+    check_idle();
+}
+
+static void test_timeout(void)
+{
+    static const uint8_t d[] = { 0x0D, 0x53 };
+    i2c_xfer_t x, y;
+
+    // Esclavo que retiene SCL en el segundo byte: vence la alarma
+    reset(FAULT_STALL, 2);
+    xfer(&x, WM8731_ADDR, d, sizeof(d));
+    xfer(&y, WM8731_ADDR, d, sizeof(d));
+    uint32_t t0 = g_i2c_model.now_us;
+    I2C_submit(&x);
+    I2C_submit(&y);
+    while (done_n == 0u && g_i2c_model.now_us - t0 < 10000u)
+    {
+        i2c_model_run(1);
+    }
+    CHECK_EQ(x.status, I2C_ERR_TIMEOUT);
+    CHECK_EQ(done_us[0] - t0, I2C_TIMEOUT_BASE_US + I2C_TIMEOUT_BYTE_US * 3u);
+    CHECK_EQ(y.status, I2C_PENDING);              // arrancada tras el abandono
+    g_i2c_model.fault = FAULT_NONE;
+    i2c_model_run(10000);
+    CHECK_EQ(g_i2c_model.aborts, 1);
+    CHECK_EQ(y.status, I2C_OK);
+    CHECK_EQ(g_i2c_model.wm8731_writes, 1);
+    check_idle();
+}
+
+static i2c_xfer_t resubmit_y;
+static const uint8_t resubmit_d[] = { 0x0D, 0x53 };
+
+/**
+ * @brief Callback que encola otra transacción con la cola ya vacía
+ */
+static void on_done_resubmit(i2c_xfer_t *x, void *arg)
+{
+    on_done(x, arg);
+    if (done_n == 1u)
+    {
+        xfer(&resubmit_y, WM8731_ADDR, resubmit_d, sizeof(resubmit_d));
+        CHECK_EQ(I2C_submit(&resubmit_y), 0);     // arranca desde el callback
+        CHECK_EQ(g_i2c_model.alarm_starts, 2);
+    }
+}
+
+static void test_resubmit(void)
+{
+    i2c_xfer_t x;
+
+    reset(FAULT_NONE, 0);
+    xfer(&x, WM8731_ADDR, resubmit_d, sizeof(resubmit_d));
+    x.callback = on_done_resubmit;
+    I2C_submit(&x);
+    i2c_model_run(10000);
+    CHECK_EQ(x.status, I2C_OK);
+    CHECK_EQ(resubmit_y.status, I2C_OK);
+    CHECK(done_n == 2 && done[1] == &resubmit_y);
+    CHECK_EQ(g_i2c_model.alarm_starts, 2);                    // un START por trama
+    CHECK_EQ(g_i2c_model.frames, 2);
+    CHECK_EQ(g_i2c_model.aborts, 0);
+    CHECK_EQ(g_i2c_model.wm8731_writes, 2);
+    check_idle();
+
+    // Con otra en cola: encola detrás de ella, que arranca una sola vez
+    i2c_xfer_t a, b;
+    reset(FAULT_NONE, 0);
+    xfer(&a, WM8731_ADDR, resubmit_d, sizeof(resubmit_d));
+    xfer(&b, WM8731_ADDR, resubmit_d, sizeof(resubmit_d));
+    a.callback = on_done_resubmit;
+    I2C_submit(&a);
+    I2C_submit(&b);
+    i2c_model_run(10000);
+    CHECK(done_n == 3 && done[1] == &b && done[2] == &resubmit_y);
+    CHECK_EQ(g_i2c_model.alarm_starts, 3);
+    CHECK_EQ(g_i2c_model.frames, 3);
+    CHECK_EQ(g_i2c_model.aborts, 0);
+    check_idle();
+}
+
+static void test_spurious(void)
+{
+    reset(FAULT_NONE, 0);
+    FM4_MFS2->IBCR = IBCR_INTE | IBCR_INT;        // interrupción sin transacción
+    MFS2_TX_IRQHandler();
+    CHECK_EQ(FM4_MFS2->IBCR, 0);
+    CHECK_EQ(bFM4_MFS2_I2C_IBSR_SPC, 0);
+    check_idle();
+}
+
+int main(void)
+{
+    test_init();
+    test_ok_and_queue();
+    test_nack();
+    test_bus_errors();
+    test_timeout();
+    test_resubmit();
+    test_spurious();
+
+    return TEST_END();
+}
@@ -0,0 +1,191 @@
+/**
+ * @file test_kernel.c
+ * @date :2026/04/06 09:12:48
+ * @brief Prueba en el host del ejecutivo expulsivo (src/kernel.c)
+ *
+ * - Análisis de tiempo de respuesta: valores exactos con interferencia y
+ *   periodos/plazos de decenas de segundos (más de 2^32 ciclos a 200 MHz).
+ * - Expulsión: el hilo que elige kernel_switch() tras kernel_tick() y
+ *   kernel_signal() es siempre el listo más prioritario, y una activación
+ *   periódica que llega con la anterior en curso cuenta como plazo perdido.
+ *
+ * Los hilos no se ejecutan (PendSV_Handler es ensamblador del Cortex-M4):
+ * la prueba hace de PendSV llamando a kernel_switch() y marca el estado que
+ * dejaría cada hilo.
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+#include "kernel.h"
+#include "trace.h"
+#include "test.h"
+
+#define CYC_MS  200000u                     /**< Ciclos por ms a 200 MHz */
+
+/** Cambio de hilo de kernel.c (lo llama PendSV_Handler) */
+uint32_t *kernel_switch(uint32_t *sp);
+
+static void nop(void)
+{
+}
+
+KERNEL_STACK(stack_a, 64);
+KERNEL_STACK(stack_b, 64);
+KERNEL_STACK(stack_c, 64);
+
+/**
+ * @brief Último hilo registrado en la traza por kernel_switch()
+ */
+static uint16_t last_thread(void)
+{
+    trace_event_t e;
+    CHECK_EQ(trace_last(&e, 1), 1);
+    CHECK_EQ(e.id, TRACE_THREAD_VALUE);
+    return e.payload;
+}
+
+/**
+ * @brief PendSV: cambia de hilo si el planificador lo ha pedido
+ *
+ * @return Índice del hilo entrante (0xFFFF tarea de fondo), 0xFFFE sin cambio
+ */
+static uint16_t pendsv(kernel_task_t *tcb)
+{
+    static uint32_t idle_frame[32];
+    if ((SCB->ICSR & SCB_ICSR_PENDSVSET_Msk) == 0u)
+    {
+        return 0xFFFEu;
+    }
+    SCB->ICSR = 0;
+    uint32_t *sp = kernel_switch(idle_frame);
+    uint16_t t = last_thread();
+    if (t != 0xFFFFu)
+    {
+        CHECK(sp == tcb[t].sp);
+    }
+    return t;
+}
+
+static void test_init(void)
+{
+    static const kernel_task_cfg_t bad[] = {
+        { "bad", 1, 0, 0, nop, stack_a, 16 },
+    };
+    kernel_task_t tcb[KERNEL_MAX_TASKS + 1];
+
+    CHECK_EQ(kernel_init(bad, tcb, KERNEL_MAX_TASKS + 1), -1);
+    CHECK_EQ(kernel_init(bad, tcb, 1), -1);          // pila demasiado pequeña
+}
+
+static void test_preemption(void)
+{
+    static const kernel_task_cfg_t cfg[] = {
+        //  nombre  periodo sep.  plazo
+        { "audio",     0,    83,   83,  nop, stack_a, sizeof(stack_a) },
+        { "control",   1,     0,    0,  nop, stack_b, sizeof(stack_b) },
+    };
+    static kernel_task_t tcb[2];
+
+    CHECK_EQ(kernel_init(cfg, tcb, 2), 0);
+
+    // Marco inicial: xPSR con bit T y EXC_RETURN a PSP sin FPU
+    CHECK_EQ(tcb[0].sp[16], 0x01000000u);
+    CHECK_EQ(tcb[0].sp[8], 0xFFFFFFFDu);
+    CHECK((uint8_t *)tcb[0].sp >= (uint8_t *)stack_a);
+
+    kernel_start();
+    SCB->ICSR = 0;
+
+    // Tick 1: se activa control y expulsa a la tarea de fondo
+    kernel_tick();
+    CHECK_EQ(pendsv(tcb), 1);
+    tcb[1].pending--;                                // el hilo empieza la activación
+    tcb[1].active = 1;
+
+    // Evento de I2S: audio expulsa a control
+    kernel_signal(&tcb[0]);
+    CHECK_EQ(pendsv(tcb), 0);
+    tcb[0].pending--;
+    tcb[0].active = 1;
+
+    // Más eventos durante la activación: se agrupan, sin cambio de hilo
+    kernel_signal(&tcb[0]);
+    kernel_signal(&tcb[0]);
+    CHECK_EQ(pendsv(tcb), 0xFFFEu);
+    CHECK_EQ(tcb[0].pending, 1);
+    CHECK_EQ(tcb[0].misses, 0);
+
+    // Audio termina sus activaciones; tick 2 con control aún en curso
+    tcb[0].pending = 0;
+    tcb[0].active = 0;
+    kernel_tick();
+    CHECK_EQ(tcb[1].misses, 1);                      // activación solapada
+    CHECK_EQ(tcb[1].pending, 1);
+    CHECK_EQ(pendsv(tcb), 1);                        // vuelve control
+    CHECK_EQ(mcu_primask, 0);
+}
+
+static void test_rta(void)
+{
+    static const kernel_task_cfg_t cfg[] = {
+        //  nombre  periodo sep.  plazo
+        { "t1",        1,     0,    0,  nop, stack_a, sizeof(stack_a) },
+        { "t2",        5,     0,    0,  nop, stack_b, sizeof(stack_b) },
+        { "t3",    30000,     0,    0,  nop, stack_c, sizeof(stack_c) },
+    };
+    static kernel_task_t tcb[3];
+
+    CHECK_EQ(kernel_init(cfg, tcb, 3), 0);
+    tcb[0].wcet = CYC_MS / 5u;                       // 0.2 ms
+    tcb[1].wcet = CYC_MS;                            // 1 ms
+    tcb[2].wcet = 2u * CYC_MS;                       // 2 ms
+    CHECK_EQ(kernel_rta(), 0);
+    CHECK_EQ(tcb[0].rta, 40000u);
+    CHECK_EQ(tcb[1].rta, 280000u);                   // 1 + 2 x 0.2 ms
+    CHECK_EQ(tcb[2].rta, 760000u);                   // 2 + 4 x 0.2 + 1 ms
+
+    // t2 sin margen: 4.4 ms de cómputo más 5 activaciones de t1 > 5 ms
+    tcb[1].wcet = 22u * CYC_MS / 5u;
+    CHECK_EQ(kernel_rta(), 2);
+}
+
+static void test_rta_long(void)
+{
+    static const kernel_task_cfg_t cfg[] = {
+        //  nombre  periodo  sep.       plazo
+        { "slow",   30000,    0,            0,  nop, stack_a, sizeof(stack_a) },
+        { "slower", 60000,    0,            0,  nop, stack_b, sizeof(stack_b) },
+        { "event",      0,    0,     25000000u, nop, stack_c, sizeof(stack_c) },
+    };
+    static kernel_task_t tcb[3];
+
+    // Periodos de 30 s y 60 s: 6e9 y 1.2e10 ciclos, no caben en 32 bits
+    CHECK_EQ(kernel_init(cfg, tcb, 2), 0);
+    tcb[0].wcet = 5000u * CYC_MS;                    // 5 s
+    tcb[1].wcet = 10000u * CYC_MS;                   // 10 s
+    CHECK_EQ(kernel_rta(), 0);
+    CHECK_EQ(tcb[0].rta, 1000000000u);
+    CHECK_EQ(tcb[1].rta, 3000000000u);               // 10 s + 5 s
+
+    // Plazo de 25 s por evento, tras 15 s de interferencia
+    CHECK_EQ(kernel_init(cfg, tcb, 3), 0);
+    tcb[0].wcet = 5000u * CYC_MS;
+    tcb[1].wcet = 10000u * CYC_MS;
+    tcb[2].wcet = 9000u * CYC_MS;                    // 9 + 15 s = 24 s
+    CHECK_EQ(kernel_rta(), 0);
+    CHECK_EQ(tcb[2].rta, UINT32_MAX);                // 4.8e9 ciclos, saturado
+
+    tcb[2].wcet = 11000u * CYC_MS;                   // 11 + 15 s = 26 s > 25 s
+    CHECK_EQ(kernel_rta(), 3);
+}
+
+int main(void)
+{
+    trace_init();
+    test_init();
+    test_preemption();
+    test_rta();
+    test_rta_long();
+
+    return TEST_END();
+}
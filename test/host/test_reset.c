@@ -0,0 +1,61 @@
+/**
+ * @file test_reset.c
+ * @date :2026/04/15 16:20:51
+ * @brief Prueba en el host de la causa del reset (hal/src/HAL_FM4_reset.c)
+ *
+ * RST_STR con los bits del manual del FM4 (stub/s6e2cc.h): cada fuente por
+ * separado y las combinaciones de un encendido (PONR + INITX) y de una
+ * caída de tensión. La prueba incluye el .c para volver a leer el registro
+ * en cada caso (el driver lo lee una sola vez).
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+#include "../../hal/src/HAL_FM4_reset.c"
+#include "test.h"
+
+/**
+ * @brief Reset simulado: RST_STR = reg, el driver aún no lo ha leído
+ */
+static rst_cause_t cause(uint16_t reg)
+{
+    mcu_crg.RST_STR = reg;
+    rst_read = 0;
+    return RST_GetCause();
+}
+
+int main(void)
+{
+    // Una fuente: la posición de RST_STR es la de RST_FLAG_x
+    static const struct { uint8_t bit; uint16_t flag; rst_cause_t cause; } src[] = {
+        { 0, RST_FLAG_PONR,  RST_POWER_ON },
+        { 1, RST_FLAG_INITX, RST_EXTERNAL },
+        { 3, RST_FLAG_LVDH,  RST_POWER_ON },
+        { 4, RST_FLAG_SWDR,  RST_WATCHDOG },
+        { 5, RST_FLAG_HWDR,  RST_WATCHDOG },
+        { 6, RST_FLAG_CSVR,  RST_OTHER },
+        { 7, RST_FLAG_FCSR,  RST_OTHER },
+        { 8, RST_FLAG_SRST,  RST_SOFTWARE },
+    };
+    for (uint32_t i = 0; i < sizeof(src) / sizeof(src[0]); i++)
+    {
+        CHECK_EQ(cause((uint16_t)(1u << src[i].bit)), src[i].cause);
+        CHECK_EQ(RST_GetFlags(), src[i].flag);
+    }
+
+    // Bit 2 reservado: no es baja tensión
+    CHECK_EQ(cause(1u << 2), RST_OTHER);
+    CHECK_EQ(RST_GetFlags(), 0);
+
+    // Encendido y caída de tensión activan también INITX
+    CHECK_EQ(cause((1u << 0) | (1u << 1)), RST_POWER_ON);
+    CHECK_EQ(cause((1u << 3) | (1u << 1)), RST_POWER_ON);
+    CHECK_EQ(cause((1u << 5) | (1u << 1)), RST_WATCHDOG);
+
+    // Una sola lectura: cambios posteriores del registro no cuentan
+    CHECK_EQ(cause(1u << 5), RST_WATCHDOG);
+    mcu_crg.RST_STR = 1u << 0;
+    CHECK_EQ(RST_GetCause(), RST_WATCHDOG);
+
+    return TEST_END();
+}
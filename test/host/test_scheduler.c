@@ -0,0 +1,218 @@
+/**
+ * @file test_scheduler.c
+ * @date :2026/04/15 18:32:10
+ * @brief Prueba en el host del planificador cooperativo (src/scheduler.c)
+ *
+ * Tiempo simulado en ciclos de 200 MHz: SysTick_GetTick() y
+ * SysTick_GetCycles() son stubs sobre el mismo contador que DWT->CYCCNT
+ * (los 32 bits bajos). Cada tarea avanza el tiempo lo que dura su ejecución
+ * y el bucle principal añade IDLE_CYC entre pasadas.
+ *
+ * Comprueba:
+ * - Contabilidad: ejecuciones, WCET, ciclos ocupados y utilización exacta
+ *   sobre la ventana, también con CYCCNT desbordando en mitad de ella.
+ * - Plazos: una tarea periódica que arranca tarde dentro de su periodo
+ *   pierde el plazo por los ciclos desde la activación, no por ms enteros;
+ *   exceso de presupuesto.
+ * - Pasada lenta: las activaciones saltadas cuentan como plazos perdidos,
+ *   la tarea se ejecuta una sola vez al recuperarse (sin ráfaga) y la tarea
+ *   de fondo pierde su plazo de intervalo.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "mcu.h"
+#include "scheduler.h"
+#include "HAL_SysTick.h"
+#include "test.h"
+
+#define CYC_US   200u                       /**< Ciclos por us a 200 MHz */
+#define CYC_MS   200000u                    /**< Ciclos por ms (tick) */
+#define IDLE_CYC (10u * CYC_US)             /**< Resto del bucle por pasada */
+
+/* ------------------------------------------------------ Tiempo simulado -- */
+
+static uint64_t cyc;
+
+static void advance(uint64_t c)
+{
+    cyc += c;
+    DWT->CYCCNT = (uint32_t)cyc;
+}
+
+static void set_time(uint64_t c)
+{
+    cyc = c;
+    DWT->CYCCNT = (uint32_t)cyc;
+}
+
+uint64_t SysTick_GetTick(void)
+{
+    return cyc / CYC_MS;
+}
+
+uint64_t SysTick_GetCycles(void)
+{
+    return cyc;
+}
+
+/* -------------------------------------------------------------- Tareas -- */
+
+static uint32_t exec_a, exec_b, exec_c;    /**< Duración de cada tarea (ciclos) */
+
+static void task_a(void) { advance(exec_a); }
+static void task_b(void) { advance(exec_b); }
+static void task_c(void) { advance(exec_c); }
+
+static sched_stats_t st[3];
+
+/**
+ * @brief Pasadas del bucle principal hasta el instante end
+ * @return Ciclo de inicio de la última pasada
+ */
+static uint64_t loop_until(uint64_t end)
+{
+    uint64_t last = cyc;
+    while (cyc < end)
+    {
+        last = cyc;
+        sched_run();
+        advance(IDLE_CYC);
+    }
+    return last;
+}
+
+/* -------------------------------------------------------------- Pruebas -- */
+
+static void test_accounting(void)
+{
+    static const sched_task_t tasks[] = {
+        { "a", 1, 0, 60, 0, task_a },       // 50 us cada ms: 5 %
+        { "b", 4, 1, 0, 0, task_b },        // 200 us cada 4 ms: 5 %
+        { "c", 0, 0, 0, 2000, task_c },     // fondo
+    };
+    exec_a = 50u * CYC_US;
+    exec_b = 200u * CYC_US;
+    exec_c = 10u * CYC_US;
+
+    // Ventana de 1 s con CYCCNT desbordando a los 50 ms
+    uint64_t c0 = ((1ull << 32) / CYC_MS - 50u) * CYC_MS;
+    set_time(c0);
+    sched_init(tasks, st, 3);
+    uint64_t last = loop_until(c0 + 1000u * CYC_MS);
+    uint64_t window = last - c0;
+
+    CHECK_EQ(st[0].runs, 1000);
+    CHECK_EQ(st[1].runs, 250);
+    CHECK_EQ(st[0].wcet, exec_a);
+    CHECK_EQ(st[1].wcet, exec_b);
+    CHECK_EQ(st[2].wcet, exec_c);
+    CHECK_EQ(st[0].busy, 1000ull * exec_a);
+    CHECK_EQ(st[1].busy, 250ull * exec_b);
+    CHECK_EQ(st[2].busy, (uint64_t)st[2].runs * exec_c);
+    CHECK_EQ(sched_utilization(0), (uint32_t)(st[0].busy * 10000u / window));
+    CHECK_EQ(sched_utilization(1), (uint32_t)(st[1].busy * 10000u / window));
+    CHECK_EQ(sched_utilization(2), (uint32_t)(st[2].busy * 10000u / window));
+    CHECK(abs((int)sched_utilization(0) - 500) <= 1);
+    CHECK(abs((int)sched_utilization(1) - 500) <= 1);
+    CHECK_EQ(sched_utilization_periodic(), sched_utilization(0) + sched_utilization(1));
+    CHECK_EQ(sched_utilization(3), 0);
+
+    // Cada pasada es ocupado + IDLE_CYC: el resto de la ventana, inactivo
+    uint64_t busy = st[0].busy + st[1].busy + st[2].busy;
+    CHECK(busy < window && window - busy <= (uint64_t)st[2].runs * IDLE_CYC);
+    CHECK(window - busy + exec_c + IDLE_CYC >= (uint64_t)st[2].runs * IDLE_CYC);
+
+    for (uint32_t i = 0; i < 3u; i++)
+    {
+        CHECK_EQ(st[i].misses, 0);
+        CHECK_EQ(st[i].overruns, 0);
+    }
+
+    sched_stats_reset();
+    CHECK(st[0].runs == 0 && st[0].busy == 0 && st[0].wcet == 0);
+    CHECK_EQ(sched_utilization(0), 0);
+}
+
+static void test_late_start(void)
+{
+    static const sched_task_t tasks[] = {
+        { "a", 1, 0, 60, 300, task_a },     // plazo 300 us, presupuesto 60 us
+        { "c", 0, 0, 0, 0, task_c },
+    };
+    exec_a = 50u * CYC_US;
+    exec_c = 10u * CYC_US;
+    uint64_t c0 = 1000u * CYC_MS;
+    set_time(c0);
+    sched_init(tasks, st, 2);
+
+    sched_run();                            // a en t = 0
+    set_time(c0 + 800u * CYC_US);
+    exec_c = 500u * CYC_US;                 // c de 0.8 a 1.3 ms
+    sched_run();
+    CHECK_EQ(st[0].runs, 1);
+    exec_c = 10u * CYC_US;
+    sched_run();                            // a arranca 300 us tarde: 350 > 300
+    CHECK_EQ(st[0].runs, 2);
+    CHECK_EQ(st[0].misses, 1);
+
+    set_time(c0 + 2200u * CYC_US);          // 200 + 50 us: en plazo
+    sched_run();
+    CHECK_EQ(st[0].runs, 3);
+    CHECK_EQ(st[0].misses, 1);
+
+    // Exceso de presupuesto
+    CHECK_EQ(st[0].overruns, 0);
+    exec_a = 70u * CYC_US;
+    set_time(c0 + 3000u * CYC_US);
+    sched_run();
+    CHECK_EQ(st[0].overruns, 1);
+    CHECK_EQ(st[0].wcet, exec_a);
+    CHECK_EQ(st[0].misses, 1);
+    CHECK_EQ(st[1].misses, 0);              // fondo sin plazo
+}
+
+static void test_slow_pass(void)
+{
+    static const sched_task_t tasks[] = {
+        { "a", 1, 0, 0, 0, task_a },
+        { "c", 0, 0, 0, 2000, task_c },     // intervalo máximo 2 ms
+    };
+    exec_a = 50u * CYC_US;
+    exec_c = 10u * CYC_US;
+    uint64_t c0 = 5000u * CYC_MS;
+    set_time(c0);
+    sched_init(tasks, st, 2);
+
+    sched_run();                            // a en t = 0
+    set_time(c0 + 500u * CYC_US);
+    exec_c = 5300u * CYC_US;                // c de 0.5 a 5.8 ms
+    sched_run();
+    CHECK_EQ(st[0].runs, 1);
+    exec_c = 10u * CYC_US;
+
+    // t = 5.8 ms: activaciones 1..4 saltadas, la 5 se ejecuta en plazo
+    sched_run();
+    CHECK_EQ(st[0].runs, 2);
+    CHECK_EQ(st[0].misses, 4);
+    CHECK_EQ(st[0].next_release, (uint32_t)(c0 / CYC_MS) + 6u);
+    CHECK_EQ(st[1].misses, 1);              // 5.35 ms entre ejecuciones de c
+    CHECK_EQ(st[1].wcet, 5300u * CYC_US);
+
+    // Sin ráfaga: una ejecución por activación a partir de aquí
+    sched_run();
+    CHECK_EQ(st[0].runs, 2);
+    loop_until(c0 + 10u * CYC_MS);
+    CHECK_EQ(st[0].runs, 6);
+    CHECK_EQ(st[0].misses, 4);
+    CHECK_EQ(st[1].misses, 1);
+}
+
+int main(void)
+{
+    test_accounting();
+    test_late_start();
+    test_slow_pass();
+
+    return TEST_END();
+}
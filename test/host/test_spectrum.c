@@ -0,0 +1,191 @@
+/**
+ * @file test_spectrum.c
+ * @date :2026/04/02 11:40:26
+ * @brief Prueba en el host del monitor de espectro (src/spectrum.c)
+ *
+ * Compara la potencia por bin de la FFT radix-4 en Q15 con una DFT en doble
+ * precisión de la misma señal con ventana de Hann, escalada igual (X[k]/N,
+ * |X|^2 en Q30):
+ * - Los bins de los tonos coinciden y su potencia difiere menos de 0.5 dB.
+ * - En el resto de bins |X[k]| difiere menos de 5 LSB: el redondeo de las 4
+ *   etapas aporta ~2 LSB y la media de potencias anula |X| < 2.8 LSB
+ *   (p >> SPECTRUM_AVG_SHIFT).
+ * También comprueba el descarte de bloques y los bins del informe, que
+ * quedan en 1..SPECTRUM_N/2-1 aunque el tono caiga en el bin 0 o por encima
+ * de fs/2.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include "dsp_params.h"
+#include "spectrum.h"
+#include "test.h"
+
+#define FS_HZ  8000u
+
+static int16_t x[SPECTRUM_N];
+static double ref[SPECTRUM_N / 2 + 1];
+
+/**
+ * @brief Potencia por bin de la DFT de x[] con ventana de Hann (doble precisión)
+ */
+static void dft_power(void)
+{
+    for (uint32_t k = 0; k <= SPECTRUM_N / 2u; k++)
+    {
+        double re = 0.0, im = 0.0;
+        for (uint32_t n = 0; n < SPECTRUM_N; n++)
+        {
+            double w = 0.5 * (1.0 - cos(2.0 * M_PI * n / SPECTRUM_N));
+            double a = 2.0 * M_PI * k * n / SPECTRUM_N;
+            re += x[n] * w * cos(a);
+            im -= x[n] * w * sin(a);
+        }
+        re /= SPECTRUM_N;
+        im /= SPECTRUM_N;
+        ref[k] = re * re + im * im;
+    }
+}
+
+/**
+ * @brief Entrega un bloque y ejecuta el análisis completo
+ */
+static void analyse_block(void)
+{
+    for (uint32_t n = 0; n < SPECTRUM_N; n++)
+    {
+        spectrum_push(x[n]);
+    }
+    uint32_t steps = 0;
+    while (spectrum_run())
+    {
+        steps++;
+    }
+    CHECK_EQ(steps, 1u + SPECTRUM_STAGES + 1u);   // ventana, etapas, potencias
+}
+
+/**
+ * @brief Bin de máxima potencia en [lo, hi)
+ */
+static uint32_t peak(uint32_t lo, uint32_t hi, uint8_t fixed)
+{
+    uint32_t best = lo;
+    for (uint32_t k = lo; k < hi; k++)
+    {
+        double p = fixed ? spectrum_power((uint16_t)k) : ref[k];
+        double pb = fixed ? spectrum_power((uint16_t)best) : ref[best];
+        if (p > pb)
+        {
+            best = k;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Compara un bloque con la referencia
+ *
+ * El primer bloque deja avg_power = p >> SPECTRUM_AVG_SHIFT.
+ */
+static void compare(double a1, double f1, double a2, double f2, double noise)
+{
+    uint32_t seed = 1;
+    for (uint32_t n = 0; n < SPECTRUM_N; n++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        double r = ((double)(seed >> 16) / 32768.0 - 1.0) * noise;
+        double v = a1 * sin(2.0 * M_PI * f1 * n / FS_HZ) + a2 * sin(2.0 * M_PI * f2 * n / FS_HZ) + r;
+        x[n] = (int16_t)lrint(v * 32767.0);
+    }
+    spectrum_init(FS_HZ);
+    analyse_block();
+    dft_power();
+
+    const double scale = 1u << SPECTRUM_AVG_SHIFT;
+    double max_abs = 0.0;
+    for (uint32_t k = 0; k <= SPECTRUM_N / 2u; k++)
+    {
+        double got = spectrum_power((uint16_t)k) * scale;
+        double err = fabs(sqrt(got) - sqrt(ref[k]));   // |X[k]| en LSB
+        if (ref[k] > 1e4)                       // bins de los tonos
+        {
+            CHECK(fabs(10.0 * log10((got + 1.0) / ref[k])) < 0.5);
+        }
+        else if (err > max_abs)
+        {
+            max_abs = err;
+        }
+    }
+    CHECK(max_abs < 5.0);
+
+    uint32_t split = (uint32_t)((f1 + f2) / 2.0 * SPECTRUM_N / FS_HZ);
+    CHECK_EQ(peak(1, split, 1), peak(1, split, 0));
+    CHECK_EQ(peak(split, SPECTRUM_N / 2u, 1), peak(split, SPECTRUM_N / 2u, 0));
+    printf("  %.0f/%.0f Hz: picos %u/%u, error fuera de los tonos %.2f LSB\n", f1, f2,
+           peak(1, split, 1), peak(split, SPECTRUM_N / 2u, 1), max_abs);
+}
+
+int main(void)
+{
+    spectrum_report_t r;
+
+    // Tonos FSK en el centro de un bin y entre bins, con y sin ruido
+    compare(0.4, 1250.0, 0.4, 2187.5, 0.0);    // bins 40 y 70 exactos
+    compare(0.4, FSK_MARK_HZ, 0.4, FSK_SPACE_HZ, 0.0);
+    compare(0.3, FSK_MARK_HZ, 0.1, FSK_SPACE_HZ, 0.05);
+    compare(0.9, 500.0, 0.05, 3000.0, 0.0);    // margen dinámico
+
+    // Bins del informe y SNR alta con tonos limpios
+    spectrum_init(FS_HZ);
+    for (uint32_t n = 0; n < SPECTRUM_N; n++)
+    {
+        x[n] = (int16_t)lrint(16000.0 * (sin(2.0 * M_PI * FSK_MARK_HZ * n / FS_HZ) +
+                                         sin(2.0 * M_PI * FSK_SPACE_HZ * n / FS_HZ)) / 2.0);
+    }
+    for (uint32_t b = 0; b < 16; b++)
+    {
+        analyse_block();
+    }
+    spectrum_get_report(&r);
+    CHECK_EQ(r.bin_mark, 38);                   // 1200 * 256 / 8000 = 38.4
+    CHECK_EQ(r.bin_space, 70);                  // 2200 * 256 / 8000 = 70.4
+    CHECK_EQ(r.blocks, 16);
+    CHECK_EQ(r.dropped, 0);
+    CHECK(r.snr_mark > 300 && r.snr_space > 300);
+
+    // Bloque completo mientras el anterior sigue pendiente: se descarta
+    for (uint32_t n = 0; n < 2u * SPECTRUM_N; n++)
+    {
+        spectrum_push(0);
+    }
+    while (spectrum_run())
+    {
+    }
+    spectrum_get_report(&r);
+    CHECK_EQ(r.dropped, 1);
+    CHECK_EQ(r.blocks, 17);
+
+    // Tonos en el bin 0 (fs muy alta) y por encima de fs/2: bins del borde,
+    // el lóbulo de 3 bins queda dentro de la tabla
+    static const struct { uint32_t fs; uint16_t mark; uint16_t space; } edge[] = {
+        { 1000000u, 1u, 1u },
+        { 4000u, 77u, SPECTRUM_N / 2u - 1u },       // 2200 Hz > fs/2
+        { 2000u, SPECTRUM_N / 2u - 1u, SPECTRUM_N / 2u - 1u },
+        { 0u, SPECTRUM_N / 2u - 1u, SPECTRUM_N / 2u - 1u },
+    };
+    for (uint32_t i = 0; i < sizeof(edge) / sizeof(edge[0]); i++)
+    {
+        spectrum_init(edge[i].fs);
+        for (uint32_t n = 0; n < SPECTRUM_N; n++)
+        {
+            x[n] = (int16_t)lrint(16000.0 * cos(M_PI * n));    // tono en fs/2
+        }
+        analyse_block();
+        spectrum_get_report(&r);
+        CHECK_EQ(r.bin_mark, edge[i].mark);
+        CHECK_EQ(r.bin_space, edge[i].space);
+        CHECK_EQ(r.blocks, 1);
+    }
+
+    return TEST_END();
+}
@@ -0,0 +1,290 @@
+/**
+ * @file test_sw2.c
+ * @date :2026/04/08 17:05:41
+ * @brief Prueba en el host del pulsador SW2 por interrupción (bsp/src/FM4_sw2.c)
+ *
+ * Inyecta flancos en P20 a través de un modelo de EXTI: un flanco solo
+ * genera la interrupción si coincide con la sensibilidad de ELVR para el
+ * canal 5 (10 subida, 11 bajada) y ENIR lo habilita, como en el FM4, que no
+ * detecta ambos flancos a la vez. La base de tiempos y la alarma del Dual
+ * Timer son simuladas (100 ticks por us con SystemCoreClock = 200 MHz).
+ *
+ * Comprueba la duración exacta de cada pulsación (desde el primer flanco de
+ * la ráfaga de pulsar hasta el primero de la de soltar) con y sin rebotes,
+ * el rearme cuando el nivel cambia mientras se reprograma ELVR, el cruce de
+ * la base de tiempos por 2^32, el umbral de pulsación larga y la cola llena.
+ *
+ * No comprueba la asignación P20 -> INT05_0 del silicio: solo que el driver
+ * selecciona EINT05S = 00 en EPFR06 (ver FM4_sw2.c).
+ */
+
+#include <stdint.h>
+#include "mcu.h"
+#include "FM4_sw2.h"
+#include "HAL_FM4_dtimer.h"
+#include "test.h"
+
+#define CH        5u
+#define US        DTIM_TICKS_US
+#define MS        (1000u * DTIM_TICKS_US)
+
+void EXINT5_IRQHandler(void);
+
+/* ------------------------------------------------------ DTIM y P20/EXTI -- */
+
+static uint32_t now;                  /**< Base de tiempos (ticks) */
+static dtim_alarm_t *alarm;
+static uint8_t pressed;               /**< Nivel de SW2 (1 pulsado: P20 a 0) */
+static uint8_t flip_on_read;          /**< Cambia el nivel tras la siguiente lectura */
+static uint32_t irqs;                 /**< Interrupciones atendidas */
+static uint32_t stuck;                /**< Peticiones que la ISR no ha borrado */
+
+uint32_t DTIM_GetTicks(void)
+{
+    return now;
+}
+
+int8_t DTIM_AlarmStart(dtim_alarm_t * const a, uint32_t us, dtim_cb_t callback, void *arg)
+{
+    a->deadline = now + us * DTIM_TICKS_US;
+    a->callback = callback;
+    a->arg = arg;
+    a->pending = 1;
+    alarm = a;
+    return 0;
+}
+
+uint8_t Sw2Read(void)
+{
+    uint8_t level = pressed;
+    if (flip_on_read)
+    {
+        flip_on_read = 0;
+        pressed ^= 1u;                 // el flanco llega sin interrupción
+    }
+    return level;
+}
+
+/**
+ * @brief Avanza la base de tiempos, venciendo la alarma si toca
+ */
+static void advance(uint32_t ticks)
+{
+    uint32_t end = now + ticks;
+    while (alarm != 0 && alarm->pending && (int32_t)(alarm->deadline - end) <= 0)
+    {
+        now = alarm->deadline;
+        alarm->pending = 0;
+        alarm->callback(alarm, alarm->arg);
+    }
+    now = end;
+}
+
+/**
+ * @brief Cambia el nivel de P20 y genera INT05 si el flanco coincide con ELVR
+ */
+static void pin(uint8_t level)
+{
+    if (level == pressed)
+    {
+        return;
+    }
+    pressed = level;
+    uint32_t sense = (FM4_EXTI->ELVR >> (2u * CH)) & 3u;
+    uint32_t edge = pressed ? 3u : 2u;   // pulsar: P20 baja
+    if ((FM4_EXTI->ENIR & (1u << CH)) && sense == edge)
+    {
+        FM4_EXTI->EIRR |= 1u << CH;
+        FM4_EXTI->EICL = 0xFFFFFFFFu;
+        EXINT5_IRQHandler();
+        irqs++;
+        if (FM4_EXTI->EICL & (1u << CH))
+        {
+            stuck++;
+        }
+        FM4_EXTI->EIRR &= ~(1u << CH);
+    }
+}
+
+/**
+ * @brief Rebotes: n flancos alternos separados step ticks, acaba en level
+ */
+static void bounce(uint8_t level, uint32_t n, uint32_t step)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        pin((uint8_t)(level ^ ((n - 1u - i) & 1u)));
+        advance(step);
+    }
+}
+
+static uint32_t sense(void)
+{
+    return (FM4_EXTI->ELVR >> (2u * CH)) & 3u;
+}
+
+static void settle(void)
+{
+    advance(SW2_DEBOUNCE_US * US + 1u);
+}
+
+/**
+ * @brief Pulsación limpia de d ticks, con la alarma ya vencida
+ */
+static void press(uint32_t d)
+{
+    pin(1);
+    advance(d);
+    pin(0);
+    settle();
+}
+
+static void expect(sw2_event_type_t type, uint32_t press_us)
+{
+    sw2_event_t ev;
+    CHECK_EQ(Sw2GetEvent(&ev), 1);
+    CHECK_EQ(ev.type, type);
+    CHECK_EQ(ev.press_us, press_us);
+}
+
+static void expect_none(void)
+{
+    sw2_event_t ev;
+    CHECK_EQ(Sw2GetEvent(&ev), 0);
+}
+
+/* -------------------------------------------------------------- Pruebas -- */
+
+static void test_init(void)
+{
+    FM4_GPIO->EPFR06 = 0xFFFFFFFFu;
+    FM4_EXTI->ELVR = 0xFFFFFFFFu;
+    pressed = 0;
+    Sw2IrqInit();
+    CHECK_EQ(FM4_GPIO->EPFR06, 0xFFFFF3FFu);   // EINT05S = 00, resto intacto
+    CHECK_EQ(sense(), 3);                      // suelto: espera la bajada
+    CHECK_EQ(FM4_EXTI->ELVR | (3u << (2u * CH)), 0xFFFFFFFFu);
+    CHECK(FM4_EXTI->ENIR & (1u << CH));
+    CHECK(mcu_irq_enabled[EXINT5_IRQn]);
+    expect_none();
+}
+
+static void test_clean(void)
+{
+    press(100u * MS);
+    expect(SW2_SHORT, 100000u);
+    expect_none();
+    CHECK_EQ(sense(), 3);
+
+    // Umbral de pulsación larga, al microsegundo
+    press(SW2_LONG_MS * MS - US);
+    expect(SW2_SHORT, SW2_LONG_MS * 1000u - 1u);
+    press(SW2_LONG_MS * MS);
+    expect(SW2_LONG, SW2_LONG_MS * 1000u);
+}
+
+static void test_bounce(void)
+{
+    uint32_t t0 = now;
+
+    // 5 flancos al pulsar y 7 al soltar, 300 us entre ellos
+    bounce(1, 5, 300u * US);
+    settle();
+    expect_none();                             // pulsar no genera evento
+    CHECK_EQ(sense(), 2);                      // pulsado: espera la subida
+    uint32_t t1 = t0 + 250u * MS;
+    advance(t1 - now);
+    bounce(0, 7, 300u * US);
+    settle();
+    expect(SW2_LONG, 250000u);
+    CHECK_EQ(sense(), 3);
+
+    // Rebotes más largos que SW2_DEBOUNCE_US en total: cada flanco rearma
+    // la alarma, así que la ráfaga de pulsar empieza en el primero
+    t0 = now;
+    bounce(1, 3, 15u * MS);
+    advance(t0 + 130u * MS - now);
+    pin(0);
+    settle();
+    expect(SW2_SHORT, 130000u);
+
+    // Parásito sin cambio neto de nivel
+    uint32_t before = irqs;
+    bounce(0, 4, 500u * US);
+    settle();
+    CHECK(irqs > before);
+    expect_none();
+    CHECK_EQ(sense(), 3);
+    CHECK_EQ(stuck, 0);
+}
+
+static void test_rearm_race(void)
+{
+    // Se suelta justo cuando el manejador diferido lee el nivel estable:
+    // no hay interrupción, y sw2_settled() debe abrir otra ráfaga
+    uint32_t t0 = now;
+    pin(1);
+    flip_on_read = 1;
+    settle();
+    CHECK_EQ(pressed, 0);
+    expect_none();
+    settle();
+    expect(SW2_SHORT, SW2_DEBOUNCE_US);        // hasta la lectura de la carrera
+    CHECK(now - t0 > 2u * SW2_DEBOUNCE_US * US);
+    CHECK_EQ(sense(), 3);
+
+    press(30u * MS);                           // la captura sigue funcionando
+    expect(SW2_SHORT, 30000u);
+}
+
+static void test_wrap(void)
+{
+    advance(0u - now - 50u * MS);              // 50 ms antes de 2^32
+    press(120u * MS);
+    CHECK(now < 100u * MS);
+    expect(SW2_SHORT, 120000u);
+}
+
+static void test_queue_full(void)
+{
+    for (uint32_t i = 0; i < SW2_QUEUE_SIZE + 2u; i++)
+    {
+        press((30u + i) * MS);
+    }
+    for (uint32_t i = 0; i < SW2_QUEUE_SIZE - 1u; i++)
+    {
+        expect(SW2_SHORT, (30u + i) * 1000u);  // los más antiguos, en orden
+    }
+    expect_none();
+
+    // Pulsación más corta que el rebote: una sola ráfaga sin cambio neto
+    press(SW2_DEBOUNCE_US * US / 2u);
+    expect_none();
+}
+
+static void test_classify(void)
+{
+    sw2_fsm_t fsm = { 100u, 0, 0 };
+    sw2_event_t ev = { SW2_NONE, 0 };
+
+    CHECK_EQ(sw2_classify(&fsm, 1000u, 0, &ev), SW2_NONE);      // sin cambio
+    CHECK_EQ(sw2_classify(&fsm, 0xFFFFFF00u, 1, &ev), SW2_NONE);
+    CHECK_EQ(sw2_classify(&fsm, 0xFFFFFF00u, 1, &ev), SW2_NONE);
+    CHECK_EQ(sw2_classify(&fsm, 0xFFFFFF00u + 100u * 199999u, 0, &ev), SW2_SHORT);
+    CHECK_EQ(ev.press_us, 199999u);
+    CHECK_EQ(sw2_classify(&fsm, 5u, 0, &ev), SW2_NONE);
+}
+
+int main(void)
+{
+    CHECK_EQ(DTIM_TICKS_US, 100);
+    test_init();
+    test_clean();
+    test_bounce();
+    test_rearm_race();
+    test_wrap();
+    test_queue_full();
+    test_classify();
+
+    return TEST_END();
+}
@@ -0,0 +1,214 @@
+/**
+ * @file test_timer_wheel.c
+ * @date :2026/04/07 16:20:33
+ * @brief Prueba en el host de la rueda de temporizadores (src/timer_wheel.c)
+ *
+ * Avanza la rueda tick a tick y comprueba el tick exacto de cada
+ * vencimiento:
+ * - Temporizador arrancado entre timer_wheel_init() y el primer
+ *   timer_wheel_run(): vence en now + delay, no un tick antes.
+ * - Un disparo y periódicos en los cuatro niveles (cascada), plazos fuera
+ *   de alcance, cancelación, rearranque desde el callback y llamante
+ *   retrasado varios ticks.
+ */
+
+#include <stdint.h>
+#include "timer_wheel.h"
+#include "test.h"
+
+#define N_RANDOM  2000u
+
+typedef struct {
+    sw_timer_t t;
+    uint64_t first;          /**< Primer vencimiento esperado */
+    uint64_t due;            /**< Siguiente vencimiento esperado */
+    uint32_t fired;          /**< Vencimientos */
+    uint32_t bad;            /**< Vencimientos fuera de su tick */
+} probe_t;
+
+static uint64_t tick;        /**< Tick que está procesando timer_wheel_run() */
+
+static void on_fire(sw_timer_t *t, void *arg)
+{
+    probe_t *p = (probe_t *)arg;
+    (void)t;
+    p->fired++;
+    if (tick != p->due)
+    {
+        printf("  vence en %llu, esperado %llu\n", (unsigned long long)tick,
+               (unsigned long long)p->due);
+        p->bad++;
+    }
+    p->due += p->t.period;
+}
+
+static void probe_start(probe_t *p, uint32_t delay, uint32_t period)
+{
+    sw_timer_init(&p->t, on_fire, p);
+    sw_timer_start(&p->t, delay, period);
+    p->first = tick + ((delay != 0u) ? delay : 1u);
+    p->due = p->first;
+    p->fired = 0;
+    p->bad = 0;
+}
+
+/**
+ * @brief Avanza tick a tick hasta end (incluido)
+ */
+static void run_to(uint64_t end)
+{
+    while (tick < end)
+    {
+        tick++;
+        timer_wheel_run(tick);
+    }
+}
+
+static uint32_t rnd(void)
+{
+    static uint32_t s = 0x9E3779B9u;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+/**
+ * @brief Regresión: arranque antes del primer timer_wheel_run()
+ */
+static void test_start_after_init(void)
+{
+    probe_t a, b, c;
+
+    tick = 1000;
+    timer_wheel_init(tick);
+    probe_start(&a, 1, 0);
+    probe_start(&b, 10, 0);
+    probe_start(&c, 0, 0);                     // 0 -> siguiente tick
+
+    timer_wheel_run(tick);                     // mismo tick: nada vence
+    CHECK_EQ(a.fired + b.fired + c.fired, 0);
+    run_to(1001);
+    CHECK_EQ(a.fired, 1);
+    CHECK_EQ(c.fired, 1);
+    run_to(1009);
+    CHECK_EQ(b.fired, 0);
+    run_to(1010);
+    CHECK_EQ(b.fired, 1);
+    CHECK_EQ(a.bad + b.bad + c.bad, 0);
+}
+
+static void test_random(void)
+{
+    static probe_t p[N_RANDOM];
+    uint32_t bad = 0, fired = 0, expected = 0;
+
+    tick = 0xFFFFFF00u;                        // cruza vueltas de todos los niveles
+    timer_wheel_init(tick);
+    for (uint32_t i = 0; i < N_RANDOM; i++)
+    {
+        uint32_t level = rnd() % 4u;           // retardos en los 4 niveles
+        uint32_t delay = 1u + rnd() % (1u << (6u * (level + 1u)));
+        if (delay > 300000u)
+        {
+            delay = 1u + delay % 300000u;
+        }
+        uint32_t period = (i % 4u == 0u) ? 1u + rnd() % 5000u : 0u;
+        probe_start(&p[i], delay, period);
+    }
+    uint64_t end = tick + 300000u;
+    run_to(end);
+    for (uint32_t i = 0; i < N_RANDOM; i++)
+    {
+        uint32_t period = p[i].t.period;
+        bad += p[i].bad;
+        fired += p[i].fired;
+        expected += (period != 0u) ? (uint32_t)((end - p[i].first) / period) + 1u : 1u;
+        CHECK((period != 0u) == (sw_timer_is_active(&p[i].t) != 0u));
+        sw_timer_cancel(&p[i].t);
+    }
+    CHECK_EQ(bad, 0);
+    CHECK_EQ(fired, expected);
+}
+
+static void test_long_and_cancel(void)
+{
+    probe_t far, gone;
+
+    tick = 5;
+    timer_wheel_init(tick);
+    probe_start(&far, (1u << 24) + 1000u, 0);  // más allá del alcance directo
+    probe_start(&gone, 500, 0);
+    run_to(400);
+    sw_timer_cancel(&gone.t);
+    CHECK(!sw_timer_is_active(&gone.t));
+    run_to(far.due - 1u);
+    CHECK_EQ(far.fired, 0);
+    CHECK_EQ(gone.fired, 0);
+    run_to(far.due);
+    CHECK_EQ(far.fired, 1);
+    CHECK_EQ(far.bad, 0);
+}
+
+static probe_t chain;
+static sw_timer_t *order_seen[3];
+static uint8_t order_n;
+
+static void on_chain(sw_timer_t *t, void *arg)
+{
+    on_fire(t, arg);
+    if (chain.fired < 3u)
+    {
+        sw_timer_start(t, 7, 0);               // relativo al tick que vence
+        chain.due = tick + 7u;
+    }
+}
+
+static void on_order(sw_timer_t *t, void *arg)
+{
+    (void)arg;
+    if (order_n < 3u)
+    {
+        order_seen[order_n] = t;
+    }
+    order_n++;
+}
+
+static void test_restart_and_late(void)
+{
+    sw_timer_t late[3];
+
+    tick = 0;
+    timer_wheel_init(tick);
+    sw_timer_init(&chain.t, on_chain, &chain);
+    sw_timer_start(&chain.t, 3, 0);
+    chain.due = 3;
+    run_to(100);
+    CHECK_EQ(chain.fired, 3);                  // 3, 10, 17
+    CHECK_EQ(chain.bad, 0);
+
+    // Llamante retrasado: una sola llamada procesa los ticks en orden
+    for (uint8_t i = 0; i < 3u; i++)
+    {
+        sw_timer_init(&late[i], on_order, NULL);
+    }
+    sw_timer_start(&late[0], 30, 0);
+    sw_timer_start(&late[1], 20, 0);
+    sw_timer_start(&late[2], 10, 0);
+    order_n = 0;
+    timer_wheel_run(tick + 29u);
+    CHECK_EQ(order_n, 2);                      // +30 todavía no
+    timer_wheel_run(tick + 100u);
+    CHECK_EQ(order_n, 3);
+    CHECK(order_seen[0] == &late[2] && order_seen[1] == &late[1] && order_seen[2] == &late[0]);
+}
+
+int main(void)
+{
+    test_start_after_init();
+    test_random();
+    test_long_and_cancel();
+    test_restart_and_late();
+
+    return TEST_END();
+}
@@ -0,0 +1,230 @@
+/**
+ * @file test_wm8731.c
+ * @date :2026/04/15 17:40:26
+ * @brief Prueba en el host del arranque en caliente del códec
+ *        (FM4_WM8731_init_warm() de bsp/src/FM4_WM8731.c)
+ *
+ * El driver habla con el WM8731 de stub/i2c_model.c por el driver I2C real.
+ * Un reset del MCU se simula con mcu_reset(): borra el .bss del driver y
+ * MFS2 y abandona la trama en curso, pero conserva wm8731_sig (.bss.noinit)
+ * y los registros del códec. La prueba incluye el .c para acceder a
+ * wm8731_sig.
+ *
+ * FM4_WM8731_sync() espera en un bucle que no mueve el bus en el host: la
+ * prueba ejecuta antes el bus con i2c_model_run() (codec_sync()).
+ *
+ * Comprueba:
+ * - Arranque en frío (firma con basura): init_warm() devuelve 0, resetea y
+ *   programa el códec, y el sync deja una firma válida.
+ * - Firma que coincide: init_warm() devuelve 1 sin ninguna trama I2C ni
+ *   START, y configura el I2S.
+ * - Firma de otra configuración, o con un bit cambiado en la marca, los
+ *   registros o el CRC: vuelve al arranque en frío.
+ * - Reset a mitad de un flush (cambio de ganancia o arranque en frío): la
+ *   firma queda invalidada aunque el códec tenga la configuración pedida.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "mcu.h"
+#include "../../bsp/src/FM4_WM8731.c"
+#include "i2c_model.h"
+#include "test.h"
+
+/** Configuración de main.c y otra que solo cambia la ganancia de salida */
+#define CFG_A  FS_48000_HZ, WM8731_LINE_IN, WM8731_HP_OUT_GAIN_0_DB, WM8731_LINE_IN_GAIN_0_DB
+#define CFG_B  FS_48000_HZ, WM8731_LINE_IN, WM8731_HP_OUT_ATTEN_6_DB, WM8731_LINE_IN_GAIN_0_DB
+
+/* ----------------------------------------------------------------- I2S -- */
+
+static int i2s_fs = -1;                /**< Última frecuencia de I2S_init() */
+
+void I2S_init(char fs)
+{
+    i2s_fs = fs;
+}
+
+uint32_t I2S_rx(void)
+{
+    return 0;
+}
+
+void I2S_tx(uint32_t c)
+{
+    (void)c;
+}
+
+/* ------------------------------------------------------------- Soporte -- */
+
+/**
+ * @brief Reset del MCU: todo salvo .bss.noinit y el códec
+ */
+static void mcu_reset(void)
+{
+    i2c_model_mcu_reset();
+    memset(wm8731_shadow, 0, sizeof(wm8731_shadow));
+    wm8731_dirty = 0;
+    wm8731_error = 0;
+    memset(wm8731_xfer, 0, sizeof(wm8731_xfer));
+    memset(wm8731_buf, 0, sizeof(wm8731_buf));
+    memset(&wm8731_reset_xfer, 0, sizeof(wm8731_reset_xfer));
+    memset(&mcu_i2s0, 0, sizeof(mcu_i2s0));
+    i2s_fs = -1;
+}
+
+static int8_t codec_sync(void)
+{
+    i2c_model_run(100000);
+    return FM4_WM8731_sync();
+}
+
+/**
+ * @brief 1 si los registros R0-R9 del códec son los de la copia en sombra
+ */
+static uint8_t codec_matches(void)
+{
+    for (uint8_t i = 0; i < WM8731_NUM_REGS; i++)
+    {
+        if (g_i2c_model.wm8731_reg[i] != FM4_WM8731_get_reg(i))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void check_i2s(void)
+{
+    CHECK_EQ(i2s_fs, FS_48000_HZ);
+    CHECK(mcu_i2s0.OPRREG_f.RXENB && mcu_i2s0.OPRREG_f.TXENB);
+    CHECK(!mcu_i2s0.CNTREG_f.RXDIS && !mcu_i2s0.CNTREG_f.TXDIS);
+}
+
+/**
+ * @brief Reset y arranque con cfg que debe volver al arranque en frío
+ */
+#define CHECK_COLD(...)                                          \
+    do {                                                         \
+        uint32_t resets_ = g_i2c_model.wm8731_resets;            \
+        CHECK_EQ(FM4_WM8731_init_warm(__VA_ARGS__), 0);          \
+        check_i2s();                                             \
+        CHECK_EQ(codec_sync(), 0);                               \
+        CHECK_EQ(g_i2c_model.wm8731_resets, resets_ + 1u);       \
+        CHECK(codec_matches());                                  \
+        CHECK_EQ(wm8731_sig.magic, WM8731_SIG_MAGIC);            \
+    } while (0)
+
+/* -------------------------------------------------------------- Pruebas -- */
+
+static void test_cold(void)
+{
+    i2c_model_reset(FAULT_NONE, 0);
+    g_i2c_model.wm8731_reg[WM8731_HP_OUT_LEFT] = 0x1FF;   // el códec tampoco está en reset
+    memset(&wm8731_sig, 0xA5, sizeof(wm8731_sig));        // RAM sin inicializar
+    mcu_reset();
+    uint32_t t0 = g_i2c_model.now_us;
+    CHECK_COLD(CFG_A);
+    printf("  arranque en frío: %u tramas I2C, %u us de bus (modelo a 400 kbit/s)\n",
+           g_i2c_model.frames, g_i2c_model.now_us - t0);
+    CHECK_EQ(g_i2c_model.aborts, 0);
+    CHECK_EQ(FM4_WM8731_get_reg(WM8731_HP_OUT_LEFT), WM8731_HP_OUT_GAIN_0_DB);
+}
+
+static void test_warm(void)
+{
+    uint32_t frames = g_i2c_model.frames;
+    uint32_t starts = g_i2c_model.alarm_starts;
+
+    mcu_reset();
+    CHECK_EQ(FM4_WM8731_init_warm(CFG_A), 1);
+    check_i2s();
+    CHECK(!FM4_WM8731_busy());
+    CHECK_EQ(codec_sync(), 0);
+    CHECK_EQ(g_i2c_model.frames, frames);         // ninguna trama I2C
+    CHECK_EQ(g_i2c_model.alarm_starts, starts);
+    CHECK(codec_matches());
+    CHECK_EQ(wm8731_sig.magic, WM8731_SIG_MAGIC);
+    CHECK_EQ(mcu_primask, 0);
+}
+
+static void test_mismatch(void)
+{
+    // Firma válida de CFG_A, arranque con CFG_B
+    mcu_reset();
+    CHECK_COLD(CFG_B);
+    CHECK_EQ(g_i2c_model.wm8731_reg[WM8731_HP_OUT_LEFT], WM8731_HP_OUT_ATTEN_6_DB);
+
+    mcu_reset();
+    CHECK_EQ(FM4_WM8731_init_warm(CFG_B), 1);
+    mcu_reset();
+    CHECK_COLD(CFG_A);
+}
+
+static void test_corrupt(void)
+{
+    uint8_t *const bits[] = {
+        (uint8_t *)&wm8731_sig.magic,
+        (uint8_t *)&wm8731_sig.regs[WM8731_SAMPLING_RATE] + 1,
+        (uint8_t *)&wm8731_sig.crc + 3,
+    };
+    for (uint32_t i = 0; i < sizeof(bits) / sizeof(bits[0]); i++)
+    {
+        mcu_reset();
+        *bits[i] ^= 0x10u;
+        CHECK_COLD(CFG_A);
+    }
+
+    // Registros de otra configuración con su CRC: válida, pero no coincide
+    wm8731_sig.regs[WM8731_CONTROL] = 0;
+    wm8731_sig.crc = CRC32_Calc((const uint8_t *)wm8731_sig.regs, sizeof(wm8731_sig.regs));
+    mcu_reset();
+    CHECK_COLD(CFG_A);
+}
+
+static void test_reset_mid_sync(void)
+{
+    // Cambio de ganancia en curso: el reset llega en la segunda trama
+    mcu_reset();
+    CHECK_EQ(FM4_WM8731_init_warm(CFG_A), 1);
+    FM4_WM8731_set_hp_out_gain(WM8731_HP_OUT_ATTEN_6_DB);
+    CHECK(wm8731_sig.magic != WM8731_SIG_MAGIC);
+    uint32_t frames = g_i2c_model.frames;
+    uint32_t aborts = g_i2c_model.aborts;
+    while (g_i2c_model.frames == frames)
+    {
+        i2c_model_run(1);
+    }
+    i2c_model_run(I2C_MODEL_BYTE_US);
+    CHECK(FM4_WM8731_busy());
+    mcu_reset();
+    CHECK_EQ(g_i2c_model.aborts, aborts + 1u);    // segunda trama a medias
+    CHECK(g_i2c_model.wm8731_reg[WM8731_HP_OUT_LEFT] != WM8731_HP_OUT_GAIN_0_DB);
+    CHECK_COLD(CFG_A);
+
+    // Reset antes de que salga ninguna trama: el códec aún tiene CFG_A,
+    // pero la firma ya no lo garantiza
+    FM4_WM8731_set_hp_out_gain(WM8731_HP_OUT_ATTEN_6_DB);
+    mcu_reset();
+    CHECK_COLD(CFG_A);
+
+    // Reset a mitad del arranque en frío
+    mcu_reset();
+    CHECK_EQ(FM4_WM8731_init_warm(CFG_B), 0);
+    i2c_model_run(I2C_MODEL_BYTE_US * 8u);
+    CHECK(FM4_WM8731_busy());
+    mcu_reset();
+    CHECK_COLD(CFG_B);
+    mcu_reset();
+    CHECK_EQ(FM4_WM8731_init_warm(CFG_B), 1);
+}
+
+int main(void)
+{
+    test_cold();
+    test_warm();
+    test_mismatch();
+    test_corrupt();
+    test_reset_mid_sync();
+
+    return TEST_END();
+}
@@ -7,7 +7,8 @@
  * del Hardware Watchdog Timer. El test simula diferentes escenarios de operación:
  *
  * Secuencia de test:
- * 1. Inicialización: LED RGB parpadea en ROJO durante 3 segundos
+ * 1. Inicialización: LED RGB parpadea en ROJO durante 3 segundos (se omite
+ *    tras un reset por watchdog, para recuperar la operación cuanto antes)
  * 2. Operación normal: LED RGB parpadea en VERDE (sistema funciona correctamente)
  * 3. Simulación de bloqueo: Al detectar pulsación larga en SW2, entra en bucle
  *    infinito con LED RGB parpadeando en AMARILLO (simula fallo del sistema)
@@ -32,6 +33,7 @@
 // Cabeceras de los módulos HAL y BSP
 #include "HAL_SysTick.h"
 #include "HAL_FM4_hwwdt.h"
+#include "HAL_FM4_reset.h"
 #include "FM4_leds_sw.h"
 
 // Cabeceras estándar
@@ -53,7 +55,9 @@ int32_t main(void)
 
 
   // parpadeo RGB rojo durante 3 segundos, fin inicializacion
-  for (uint16_t i = 0; i < 3000; i++)
+  // (solo en arranque en frío)
+  uint16_t init_ms = (RST_GetCause() == RST_WATCHDOG) ? 0 : 3000;
+  for (uint16_t i = 0; i < init_ms; i++)
   {
     while (SysTick_ChkOvf() == 0)
     { /* empty while*/
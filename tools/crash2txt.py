@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Decodificador del registro post-mortem de src/crash.h.
+
+Entrada: volcado de g_crash_last (copia validada tras el reset), en binario
+crudo o en Intel HEX (el formato del comando SAVE de µVision):
+
+    SAVE crash.hex &g_crash_last, ((char *)&g_crash_last) + sizeof(g_crash_last) - 1
+
+Comprueba la marca y el CRC-32, decodifica CFSR/HFSR y, con --elf,
+simboliza PC, LR y las direcciones de retorno candidatas de la pila con
+addr2line (arm-none-eabi-addr2line o llvm-addr2line sobre el .axf).
+
+Uso:
+    python3 tools/crash2txt.py crash.hex
+    python3 tools/crash2txt.py crash.hex --elf build_keil/Objects/lab6.axf
+"""
+
+import argparse
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import zlib
+
+from trace2vcd import read_dump, read_ids
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+CRASH_H = os.path.join(ROOT, "src", "crash.h")
+CIRC_BUF_H = os.path.join(ROOT, "shared", "includes", "circ_buf.h")
+TRACE_H = os.path.join(ROOT, "src", "trace.h")
+
+CRASH_MAGIC = 0x48535243
+FRAME = ("r0", "r1", "r2", "r3", "r12", "lr", "pc", "xpsr")
+
+CFSR_BITS = {
+    0: "IACCVIOL", 1: "DACCVIOL", 3: "MUNSTKERR", 4: "MSTKERR", 5: "MLSPERR",
+    7: "MMARVALID", 8: "IBUSERR", 9: "PRECISERR", 10: "IMPRECISERR",
+    11: "UNSTKERR", 12: "STKERR", 13: "LSPERR", 15: "BFARVALID",
+    16: "UNDEFINSTR", 17: "INVSTATE", 18: "INVPC", 19: "NOCP",
+    24: "UNALIGNED", 25: "DIVBYZERO",
+}
+HFSR_BITS = {1: "VECTTBL", 30: "FORCED", 31: "DEBUGEVT"}
+
+
+def header_define(path, name):
+    with open(path, encoding="utf-8", errors="replace") as f:
+        m = re.search(r"#define\s+%s\s+(\w+)" % name, f.read())
+    if not m:
+        raise ValueError("%s no definido en %s" % (name, path))
+    return int(m.group(1).rstrip("uUlL"), 0)
+
+
+def read_reasons(path):
+    """Lee el enum crash_reason_t de crash.h: {valor: nombre}."""
+    with open(path, encoding="utf-8", errors="replace") as f:
+        text = f.read()
+    block = re.search(r"typedef enum \{(.*?)\} crash_reason_t;", text, re.S).group(1)
+    return {int(v, 0): n for n, v in re.findall(r"\bCRASH_(\w+)\s*=\s*(\d+)", block)}
+
+
+def layout(bt_n, trace_n, circ_n):
+    """Formato struct de crash_record_t (ARM, little-endian, alineación natural)."""
+    circ = "%dhHH" % circ_n
+    fmt = "<4I8I6I I%dI" % bt_n + circ + circ
+    pad = (-struct.calcsize(fmt)) % 4
+    return fmt + "%dx" % pad + "I" + "IHH" * trace_n + "I"
+
+
+def bits(value, names):
+    return " ".join(n for b, n in sorted(names.items()) if value & (1 << b)) or "-"
+
+
+def symbolize(elf, addrs, tool):
+    """{dirección: 'función en fichero:línea'} con addr2line."""
+    if not elf or not addrs:
+        return {}
+    out = subprocess.run([tool, "-e", elf, "-f", "-C", "-p"] + ["0x%08X" % a for a in addrs],
+                         capture_output=True, text=True, check=True).stdout.splitlines()
+    return dict(zip(addrs, out))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    ap.add_argument("dump", help="volcado de g_crash_last (.bin o .hex)")
+    ap.add_argument("--elf", help="imagen enlazada (.axf) para simbolizar")
+    ap.add_argument("--addr2line", help="ejecutable addr2line (por defecto el primero disponible)")
+    args = ap.parse_args()
+
+    bt_n = header_define(CRASH_H, "CRASH_BT_N")
+    trace_n = header_define(CRASH_H, "CRASH_TRACE_N")
+    circ_n = header_define(CIRC_BUF_H, "CIRC_BUF_SIZE")
+    fmt = layout(bt_n, trace_n, circ_n)
+    size = struct.calcsize(fmt)
+
+    data = read_dump(args.dump)
+    if len(data) < size:
+        sys.exit("volcado incompleto: %d de %d bytes" % (len(data), size))
+    v = list(struct.unpack_from(fmt, data))
+
+    magic, reason, info, cyccnt = v[0:4]
+    frame = v[4:12]
+    sp, exc_return, cfsr, hfsr, mmfar, bfar = v[12:18]
+    nbt = v[18]
+    bt = v[19:19 + bt_n][:min(nbt, bt_n)]
+    k = 19 + bt_n
+    tx = v[k:k + circ_n + 2]
+    rx = v[k + circ_n + 2:k + 2 * circ_n + 4]
+    k += 2 * circ_n + 4
+    ntrace = v[k]
+    trace = [tuple(v[k + 1 + 3 * i:k + 4 + 3 * i]) for i in range(min(ntrace, trace_n))]
+    crc = v[-1]
+
+    if magic != CRASH_MAGIC:
+        sys.exit("registro no válido (magic 0x%08X)" % magic)
+    crc_ok = (zlib.crc32(data[:size - 4]) & 0xFFFFFFFF) == crc
+
+    tool = args.addr2line or next((t for t in ("arm-none-eabi-addr2line", "llvm-addr2line", "addr2line")
+                                   if shutil.which(t)), None)
+    if args.elf and not tool:
+        sys.exit("addr2line no encontrado: usar --addr2line")
+    # Direcciones de retorno: dentro de la instrucción de llamada
+    code = {frame[6] & ~1}
+    code |= {(a & ~1) - 1 for a in [frame[5]] + bt if a & 1}
+    syms = symbolize(args.elf, sorted(code), tool)
+
+    def sym(a, ret=True):
+        key = (a & ~1) - 1 if (ret and a & 1) else a & ~1
+        return ("  " + syms[key]) if key in syms else ""
+
+    reasons = read_reasons(CRASH_H)
+    print("Causa:   %s (info 0x%08X)%s" % (reasons.get(reason, "?%d" % reason), info,
+                                          "" if crc_ok else "   ** CRC incorrecto **"))
+    print("CYCCNT:  %u" % cyccnt)
+    if sp:
+        print("Marco en 0x%08X (%s, EXC_RETURN 0x%08X%s)" % (
+            sp, "PSP" if exc_return & 4 else "MSP", exc_return,
+            "" if exc_return & 0x10 else ", con FPU"))
+        for name, val in zip(FRAME, frame):
+            s = sym(val, ret=False) if name == "pc" else sym(val) if name == "lr" else ""
+            print("  %-4s 0x%08X%s" % (name, val, s))
+    print("CFSR:    0x%08X  %s" % (cfsr, bits(cfsr, CFSR_BITS)))
+    print("HFSR:    0x%08X  %s" % (hfsr, bits(hfsr, HFSR_BITS)))
+    if cfsr & (1 << 7):
+        print("MMFAR:   0x%08X" % mmfar)
+    if cfsr & (1 << 15):
+        print("BFAR:    0x%08X" % bfar)
+    if bt:
+        print("Pila (candidatas a dirección de retorno):")
+        for a in bt:
+            print("  0x%08X%s" % (a, sym(a)))
+    for name, cb in (("TX", tx), ("RX", rx)):
+        print("%s:      head %d tail %d  %s" % (name, cb[-2], cb[-1], " ".join(str(x) for x in cb[:-2])))
+    if trace:
+        ids = read_ids(TRACE_H)
+        t0 = trace[0][0]
+        print("Últimos eventos de la traza (ciclos desde el primero):")
+        for t, ev_id, payload in trace:
+            print("  %10u  %-14s %d" % ((t - t0) & 0xFFFFFFFF, ids.get(ev_id, "ID%d" % ev_id), payload))
+
+
+if __name__ == "__main__":
+    main()
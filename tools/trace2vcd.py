@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+"""
+Conversor de la traza binaria de src/trace.h a VCD o a JSON para Perfetto.
+
+Entrada: volcado de g_trace, en binario crudo o en Intel HEX (el formato
+del comando SAVE de µVision):
+
+    SAVE trace.hex &g_trace, ((char *)&g_trace) + sizeof(g_trace) - 1
+
+Los identificadores de evento se leen de src/trace.h:
+  - NOMBRE_BEGIN / NOMBRE_END  -> intervalo (una señal por valor del dato)
+  - NOMBRE_VALUE               -> valor de una señal
+  - resto                      -> evento instantáneo (valor = dato)
+
+Uso:
+    python3 tools/trace2vcd.py trace.hex -o trace.vcd
+    python3 tools/trace2vcd.py trace.hex --format perfetto -o trace.json
+    python3 tools/trace2vcd.py trace.hex --names TASK=pulsador,audio_tx,audio_rx
+
+El JSON (formato Chrome trace) se abre en https://ui.perfetto.dev y el VCD
+con GTKWave o PulseView.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+TRACE_MAGIC = 0x31435254
+HEADER = struct.Struct("<IIII")   # magic, size, hz, idx
+EVENT = struct.Struct("<IHH")     # t, id, payload
+
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              "..", "src", "trace.h")
+
+
+def read_dump(path):
+    """Devuelve los bytes del volcado (binario o Intel HEX)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if not data.lstrip().startswith(b":"):
+        return data
+
+    mem = {}
+    base = 0
+    for line in data.decode("ascii").splitlines():
+        line = line.strip()
+        if not line.startswith(":"):
+            continue
+        rec = bytes.fromhex(line[1:])
+        if (sum(rec) & 0xFF) != 0:
+            raise ValueError("checksum incorrecto: " + line)
+        n, addr, kind = rec[0], (rec[1] << 8) | rec[2], rec[3]
+        payload = rec[4:4 + n]
+        if kind == 0x00:
+            for i, b in enumerate(payload):
+                mem[base + addr + i] = b
+        elif kind == 0x02:
+            base = int.from_bytes(payload, "big") << 4
+        elif kind == 0x04:
+            base = int.from_bytes(payload, "big") << 16
+        elif kind == 0x01:
+            break
+    if not mem:
+        raise ValueError("Intel HEX sin datos")
+    start, end = min(mem), max(mem)
+    return bytes(mem.get(a, 0) for a in range(start, end + 1))
+
+
+def read_ids(header):
+    """Lee el enum trace_id_t de trace.h: {valor: nombre}."""
+    with open(header, encoding="utf-8", errors="replace") as f:
+        text = f.read()
+    ids = {}
+    for name, value in re.findall(r"\b(TRACE_\w+)\s*=\s*(0x[0-9A-Fa-f]+|\d+)\s*,", text):
+        if name in ("TRACE_USER",):
+            continue
+        ids[int(value, 0)] = name[len("TRACE_"):]
+    return ids
+
+
+def decode(data):
+    """Devuelve (hz, eventos) con eventos = [(ciclos, id, dato)] en orden."""
+    magic, size, hz, idx = HEADER.unpack_from(data, 0)
+    if magic != TRACE_MAGIC:
+        raise ValueError("cabecera no válida (magic 0x%08X)" % magic)
+    if len(data) < HEADER.size + size * EVENT.size:
+        raise ValueError("volcado incompleto: %d bytes" % len(data))
+
+    count = min(idx, size)
+    raw = []
+    for k in range(idx - count, idx):
+        raw.append(EVENT.unpack_from(data, HEADER.size + (k % size) * EVENT.size))
+
+    # Desenrolla el contador de 32 bits
+    events = []
+    hi = 0
+    prev = None
+    for t, ev_id, payload in raw:
+        if prev is not None and t < prev:
+            hi += 1 << 32
+        prev = t
+        events.append((hi + t, ev_id, payload))
+    if events:
+        t0 = events[0][0]
+        events = [(t - t0, i, p) for t, i, p in events]
+    return hz, events
+
+
+def classify(name):
+    for suffix, kind in (("_BEGIN", "begin"), ("_END", "end"), ("_VALUE", "value")):
+        if name.endswith(suffix):
+            return name[:-len(suffix)], kind
+    return name, "instant"
+
+
+def signal_name(base, payload, names):
+    if base in names and payload < len(names[base]):
+        return "%s_%s" % (base, names[base][payload])
+    return "%s_%d" % (base, payload)
+
+
+def to_events(events, ids, names):
+    """Eventos con nombre: (ciclos, tipo, señal, dato)."""
+    out = []
+    for t, ev_id, payload in events:
+        name = ids.get(ev_id, "ID%d" % ev_id)
+        base, kind = classify(name)
+        if kind in ("begin", "end"):
+            out.append((t, kind, signal_name(base, payload, names), payload))
+        else:
+            out.append((t, kind, base, payload))
+    return out
+
+
+def write_vcd(f, hz, named):
+    f.write("$timescale 1ns $end\n$scope module trace $end\n")
+    codes = {}
+    for _, kind, sig, _ in named:
+        if sig not in codes:
+            code = ""
+            n = len(codes)
+            while True:
+                code += chr(33 + n % 94)
+                n //= 94
+                if n == 0:
+                    break
+            codes[sig] = (code, kind in ("begin", "end"))
+            if codes[sig][1]:
+                f.write("$var wire 1 %s %s $end\n" % (code, sig))
+            else:
+                f.write("$var reg 16 %s %s $end\n" % (code, sig))
+    f.write("$upscope $end\n$enddefinitions $end\n")
+
+    last = None
+    for t, kind, sig, payload in named:
+        ns = t * 1000000000 // hz
+        if ns != last:
+            f.write("#%d\n" % ns)
+            last = ns
+        code, is_wire = codes[sig]
+        if is_wire:
+            f.write("%d%s\n" % (1 if kind == "begin" else 0, code))
+        else:
+            f.write("b%s %s\n" % (format(payload, "b"), code))
+
+
+def write_perfetto(f, hz, named):
+    tids = {}
+    trace = []
+    for t, kind, sig, payload in named:
+        us = t * 1e6 / hz
+        if kind in ("begin", "end"):
+            tid = tids.setdefault(sig, len(tids) + 1)
+            trace.append({"name": sig, "ph": "B" if kind == "begin" else "E",
+                          "ts": us, "pid": 1, "tid": tid})
+        elif kind == "value":
+            trace.append({"name": sig, "ph": "C", "ts": us, "pid": 1,
+                          "args": {sig: payload}})
+        else:
+            trace.append({"name": sig, "ph": "i", "s": "g", "ts": us, "pid": 1,
+                          "args": {"payload": payload}})
+    for sig, tid in tids.items():
+        trace.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid,
+                      "args": {"name": sig}})
+    json.dump({"traceEvents": trace, "displayTimeUnit": "ns"}, f)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    ap.add_argument("dump", help="volcado de g_trace (.bin o .hex)")
+    ap.add_argument("-o", "--output", help="fichero de salida (por defecto stdout)")
+    ap.add_argument("--format", choices=("vcd", "perfetto"), default="vcd")
+    ap.add_argument("--header", default=DEFAULT_HEADER, help="ruta de trace.h")
+    ap.add_argument("--names", action="append", default=[],
+                    help="nombres por dato, p.ej. TASK=pulsador,audio_tx")
+    ap.add_argument("--hz", type=int, help="frecuencia de CYCCNT (por defecto la del volcado)")
+    args = ap.parse_args()
+
+    names = {}
+    for item in args.names:
+        base, _, lst = item.partition("=")
+        names[base.upper()] = lst.split(",")
+
+    hz, events = decode(read_dump(args.dump))
+    hz = args.hz or hz
+    if hz == 0:
+        sys.exit("frecuencia desconocida: usar --hz")
+    named = to_events(events, read_ids(args.header), names)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    try:
+        if args.format == "vcd":
+            write_vcd(out, hz, named)
+        else:
+            write_perfetto(out, hz, named)
+    finally:
+        if args.output:
+            out.close()
+    print("%d eventos, %.3f ms" % (len(named), named[-1][0] * 1e3 / hz if named else 0.0),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()